@@ -271,12 +271,16 @@ void APP_INIT_DATA::clear() {
 }
 
 int parse_init_data_file(FILE* f, APP_INIT_DATA& ai) {
+    MIOFILE mf;
+    mf.init_file(f);
+    return parse_init_data_file(mf, ai);
+}
+
+int parse_init_data_file(MIOFILE& mf, APP_INIT_DATA& ai) {
     char tag[1024], buf[256];
     int retval;
     bool flag, is_tag;
 
-    MIOFILE mf;
-    mf.init_file(f);
     XML_PARSER xp(&mf);
 
     if (!xp.parse_start("app_init_data")) {
@@ -299,7 +303,7 @@ int parse_init_data_file(FILE* f, APP_INIT_DATA& ai) {
         }
         if (!strcmp(tag, "/app_init_data")) return 0;
         if (!strcmp(tag, "project_preferences")) {
-            retval = dup_element(f, "project_preferences", &ai.project_preferences);
+            retval = dup_element(mf, "project_preferences", &ai.project_preferences);
             if (retval) return retval;
             continue;
         }
@@ -71,6 +71,35 @@ typedef struct BOINC_STATUS {
     int network_suspended;
 } BOINC_STATUS;
 
+// events passed from the runtime to the worker thread by boinc_get_event()
+//
+#define BOINC_EVENT_SUSPEND     1
+#define BOINC_EVENT_RESUME      2
+#define BOINC_EVENT_QUIT        3
+#define BOINC_EVENT_ABORT       4
+#define BOINC_EVENT_CHECKPOINT  5
+    // it's time to checkpoint (as boinc_time_to_checkpoint() would say,
+    // but without entering a critical section).
+    // Delivering it starts the checkpoint timer, so the app can write
+    // its checkpoint and call boinc_checkpoint_completed() right away;
+    // call boinc_time_to_checkpoint() first if the checkpoint
+    // mustn't be interrupted by suspend or quit.
+
+// what checkpointing has cost so far (see boinc_get_checkpoint_stats())
+//
+typedef struct BOINC_CHECKPOINT_STATS {
+    int count;
+        // number of boinc_checkpoint_completed() calls
+    double seconds;
+        // wall time from boinc_time_to_checkpoint() returning 1
+        // (or BOINC_EVENT_CHECKPOINT) to boinc_checkpoint_completed(),
+        // summed over checkpoints
+    double bytes;
+        // sum of the sizes passed to boinc_checkpoint_size()
+    int period;
+        // current seconds between checkpoints
+} BOINC_CHECKPOINT_STATS;
+
 typedef void (*FUNC_PTR)();
 
 struct APP_INIT_DATA;
@@ -83,6 +112,17 @@ extern int boinc_get_init_data_p(struct APP_INIT_DATA*);
 extern int boinc_parse_init_data_file(void);
 extern int boinc_send_trickle_up(char* variety, char* text);
 extern int boinc_checkpoint_completed(void);
+    // ends the critical section begun by boinc_time_to_checkpoint(), if any
+extern void boinc_checkpoint_size(double nbytes);
+    // call before boinc_checkpoint_completed()
+    // with the number of bytes the checkpoint wrote
+extern void boinc_set_checkpoint_overhead(double);
+    // the fraction of time checkpoints may take (default 0.01).
+    // If checkpoints take longer than that at the user's
+    // checkpoint period, they're spaced further apart
+    // (up to 10 times the period).
+    // 0 means always use the user's period.
+extern int boinc_get_checkpoint_stats(BOINC_CHECKPOINT_STATS*);
 extern int boinc_fraction_done(double);
 extern int boinc_suspend_other_activities(void);
 extern int boinc_resume_other_activities(void);
@@ -105,6 +145,10 @@ extern double boinc_get_fraction_done();
 extern void boinc_register_timer_callback(FUNC_PTR);
 extern double boinc_worker_thread_cpu_time();
 extern int boinc_init_parallel();
+extern int boinc_get_event(int*);
+    // call from one thread only (normally the worker);
+    // returns 1 and sets the BOINC_EVENT_* code if there's an event.
+    // Lock-free and makes no system calls, so it's OK in inner loops.
 
 #ifdef __APPLE__
 extern int setMacPList(void);
@@ -24,6 +24,11 @@
 #include <string>
 #include <cstring>
 #include <cstdarg>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 #endif
 
 #include "error_numbers.h"
@@ -35,9 +40,16 @@ MIOFILE::MIOFILE() {
     mf = 0;
     f = 0;
     buf = 0;
+    map_addr = 0;
+    map_len = 0;
+    read_buf = 0;
 }
 
 MIOFILE::~MIOFILE() {
+#ifndef _WIN32
+    if (map_addr) munmap(map_addr, map_len);
+#endif
+    if (read_buf) free(read_buf);
 }
 
 void MIOFILE::init_mfile(MFILE* _mf) {
@@ -52,6 +64,53 @@ void MIOFILE::init_buf_read(const char* _buf) {
     buf = _buf;
 }
 
+// Map the file read-only and parse it as a buffer.
+// The buffer code paths need a NUL at the end;
+// mmap() zero-fills the rest of the last page, so we get that for free
+// unless the size is a multiple of the page size.
+// In that case (and on Windows) read the file into a malloc'ed buffer.
+//
+int MIOFILE::init_mmap_read(const char* path) {
+    size_t size;
+    int retval;
+#ifndef _WIN32
+    struct stat sbuf;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return ERR_FOPEN;
+    if (fstat(fd, &sbuf)) {
+        close(fd);
+        return ERR_FOPEN;
+    }
+    size = sbuf.st_size;
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (size && page_size > 0 && (size % page_size)) {
+        void* p = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED) return ERR_FOPEN;
+        map_addr = p;
+        map_len = size;
+        buf = (const char*)p;
+        return 0;
+    }
+    close(fd);
+#endif
+    FILE* in = fopen(path, "rb");
+    if (!in) return ERR_FOPEN;
+    fseek(in, 0, SEEK_END);
+    size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    read_buf = (char*)malloc(size+1);
+    if (!read_buf) {
+        fclose(in);
+        return ERR_MALLOC;
+    }
+    retval = (fread(read_buf, 1, size, in) == size)?0:ERR_FREAD;
+    fclose(in);
+    read_buf[size] = 0;
+    buf = read_buf;
+    return retval;
+}
+
 void MIOFILE::init_buf_write(char* _buf, int _len) {
     wbuf = _buf;
     len = _len;
@@ -211,6 +211,30 @@ int dup_element(FILE* in, const char* tag_name, char** pp) {
     return ERR_XML_PARSE;
 }
 
+// Same, for an MIOFILE
+//
+int dup_element(MIOFILE& in, const char* tag_name, char** pp) {
+    char buf[256], end_tag[256];
+    int retval;
+
+    sprintf(buf, "<%s>\n", tag_name);
+    sprintf(end_tag, "</%s>", tag_name);
+
+    char* p = strdup(buf);
+    while (in.fgets(buf, 256)) {
+        if (strstr(buf, end_tag)) {
+            sprintf(buf, "</%s>\n", tag_name);
+            retval = strcatdup(p, buf);
+            if (retval) return retval;
+            *pp = p;
+            return 0;
+        }
+        retval = strcatdup(p, buf);
+        if (retval) return retval;
+    }
+    return ERR_XML_PARSE;
+}
+
 // copy from a file to static buffer
 //
 int copy_element_contents(FILE* in, const char* end_tag, char* p, int len) {
@@ -500,21 +524,18 @@ bool XML_PARSER::scan_nonws(int& first_char) {
 #define XML_PARSE_TAG       4
 #define XML_PARSE_DATA      5
 
+// we just read "<!--"; read until we find "-->".
+// Count the dashes in a row rather than searching a window of the text.
+//
 int XML_PARSER::scan_comment() {
-    char buf[256];
-    char* p = buf;
+    int ndashes = 0;
     while (1) {
         int c = f->_getc();
         if (c == EOF) return XML_PARSE_EOF;
-        *p++ = c;
-        *p = 0;
-        if (strstr(buf, "-->")) {
+        if (c == '>' && ndashes >= 2) {
             return XML_PARSE_COMMENT;
         }
-        if (strlen(buf) > 32) {
-            strcpy(buf, buf+16);
-            p = buf;
-        }
+        ndashes = (c == '-')?ndashes+1:0;
     }
 }
 
@@ -622,6 +643,155 @@ bool XML_PARSER::copy_until_tag(char* buf, int len) {
     }
 }
 
+// Buffered version of get_aux(): scan the next tag or text
+// in the MIOFILE's memory buffer, without copying it.
+// For tags the slice is what's between < and > (including attributes);
+// for text and CDATA it's the text with whitespace stripped at both ends.
+// Leaves the MIOFILE positioned after the tag, or at the < after the text.
+//
+int XML_PARSER::scan_buf(XML_SLICE& slice) {
+    const char* p = f->buf;
+    const char* q;
+
+    while (1) {
+        while (*p && isspace((unsigned char)*p)) p++;
+        if (!*p) {
+            f->buf = p;
+            return XML_PARSE_EOF;
+        }
+        if (*p != '<') {
+            q = strchr(p, '<');
+            if (!q) {
+                f->buf = p + strlen(p);
+                return XML_PARSE_EOF;
+            }
+            f->buf = q;
+            while (q > p && isspace((unsigned char)q[-1])) q--;
+            slice.p = p;
+            slice.len = (int)(q - p);
+            return XML_PARSE_DATA;
+        }
+        if (!strncmp(p+1, "!--", 3)) {
+            q = strstr(p+4, "-->");
+            if (!q) {
+                f->buf = p + strlen(p);
+                return XML_PARSE_EOF;
+            }
+            p = q+3;
+            continue;
+        }
+        if (!strncmp(p+1, "![CDATA[", 8)) {
+            p += 9;
+            q = strstr(p, "]]>");
+            if (!q) {
+                f->buf = p + strlen(p);
+                return XML_PARSE_EOF;
+            }
+            f->buf = q+3;
+            while (p < q && isspace((unsigned char)*p)) p++;
+            while (q > p && isspace((unsigned char)q[-1])) q--;
+            slice.p = p;
+            slice.len = (int)(q - p);
+            return XML_PARSE_CDATA;
+        }
+        q = strchr(p+1, '>');
+        if (!q) {
+            f->buf = p + strlen(p);
+            return XML_PARSE_EOF;
+        }
+        f->buf = q+1;
+        slice.p = p+1;
+        slice.len = (int)(q - (p+1));
+        return XML_PARSE_TAG;
+    }
+}
+
+// copy a tag slice the way scan_tag() does:
+// tag (or tag/) to tag_buf, "attr=val attr=val" to attr_buf
+//
+static void copy_tag(
+    XML_SLICE& slice, char* tag_buf, int tag_len, char* attr_buf, int attr_len
+) {
+    bool found_space = false;
+    const char* end = slice.p + slice.len;
+
+    for (const char* p = slice.p; p < end; p++) {
+        char c = *p;
+        if (isspace((unsigned char)c)) {
+            if (found_space && attr_buf) {
+                if (--attr_len > 0) {
+                    *attr_buf++ = c;
+                }
+            }
+            found_space = true;
+        } else if (c == '/') {
+            if (--tag_len > 0) {
+                *tag_buf++ = c;
+            }
+        } else if (found_space) {
+            if (attr_buf) {
+                if (--attr_len > 0) {
+                    *attr_buf++ = c;
+                }
+            }
+        } else {
+            if (--tag_len > 0) {
+                *tag_buf++ = c;
+            }
+        }
+    }
+    *tag_buf = 0;
+    if (attr_buf) *attr_buf = 0;
+}
+
+int XML_PARSER::get_aux_buf(char* buf, int len, char* attr_buf, int attr_len) {
+    XML_SLICE slice;
+    int n, retval;
+
+    retval = scan_buf(slice);
+    switch (retval) {
+    case XML_PARSE_EOF:
+        return retval;
+    case XML_PARSE_TAG:
+        copy_tag(slice, buf, len, attr_buf, attr_len);
+        break;
+    default:
+        // the slice is already stripped, unless we cut it short
+        //
+        n = (slice.len < len-1)?slice.len:len-1;
+        memcpy(buf, slice.p, n);
+        buf[n] = 0;
+        if (n < slice.len) strip_whitespace(buf);
+        break;
+    }
+    return retval;
+}
+
+// is the slice the end tag for start_tag?
+//
+bool XML_PARSER::is_end_tag(XML_SLICE& slice, const char* start_tag) {
+    char tag[256];
+    copy_tag(slice, tag, sizeof(tag), 0, 0);
+    return tag[0] == '/' && !strcmp(tag+1, start_tag);
+}
+
+// Zero-copy version of get() for memory buffers.
+// Return true iff reached EOF, or if not reading from memory.
+//
+bool XML_PARSER::get_slice(XML_SLICE& slice, bool& is_tag) {
+    if (!buffered()) return true;
+    switch (scan_buf(slice)) {
+    case XML_PARSE_EOF: return true;
+    case XML_PARSE_TAG:
+        is_tag = true;
+        break;
+    default:
+        is_tag = false;
+        break;
+    }
+    return false;
+}
+
 // Scan something, either tag or text.
 // Strip whitespace at start and end.
 // Return true iff reached EOF
@@ -629,7 +799,10 @@ bool XML_PARSER::copy_until_tag(char* buf, int len) {
 int XML_PARSER::get_aux(char* buf, int len, char* attr_buf, int attr_len) {
     bool eof;
     int c, retval;
-    
+
+    if (buffered()) {
+        return get_aux_buf(buf, len, attr_buf, attr_len);
+    }
     while (1) {
         eof = scan_nonws(c);
         if (eof) return XML_PARSE_EOF;
@@ -740,20 +913,37 @@ bool XML_PARSER::parse_int(char* parsed_tag, const char* start_tag, int& i) {
     end_tag[0] = '/';
     strcpy(end_tag+1, start_tag);
 
-    eof = get(buf, sizeof(buf), is_tag);
-    if (eof) return false;
-    if (is_tag) {
-        if (!strcmp(buf, end_tag)) {
-            i = 0;      // treat <foo></foo> as <foo>0</foo>
+    int val;
+    if (buffered()) {
+        // convert the number in place; the text always ends at a <
+        //
+        XML_SLICE slice;
+        if (get_slice(slice, is_tag)) return false;
+        if (is_tag) {
+            if (!is_end_tag(slice, start_tag)) return false;
+            i = 0;
             return true;
-        } else {
-            return false;
         }
+        errno = 0;
+        val = strtol(slice.p, &end, 0);
+        if (errno == ERANGE) return false;
+        if (end != slice.p+slice.len) return false;
+    } else {
+        eof = get(buf, sizeof(buf), is_tag);
+        if (eof) return false;
+        if (is_tag) {
+            if (!strcmp(buf, end_tag)) {
+                i = 0;      // treat <foo></foo> as <foo>0</foo>
+                return true;
+            } else {
+                return false;
+            }
+        }
+        errno = 0;
+        val = strtol(buf, &end, 0);
+        if (errno == ERANGE) return false;
+        if (end != buf+strlen(buf)) return false;
     }
-    errno = 0;
-    int val = strtol(buf, &end, 0);
-    if (errno == ERANGE) return false;
-    if (end != buf+strlen(buf)) return false;
 
     eof = get(tag, sizeof(tag), is_tag);
     if (eof) return false;
@@ -775,18 +965,31 @@ bool XML_PARSER::parse_double(char* parsed_tag, const char* start_tag, double& x
     end_tag[0] = '/';
     strcpy(end_tag+1, start_tag);
 
-    eof = get(buf, sizeof(buf), is_tag);
-    if (eof) return false;
-    if (is_tag) {
-        if (!strcmp(buf, end_tag)) {
-            x = 0;      // treat <foo></foo> as <foo>0</foo>
+    double val;
+    if (buffered()) {
+        XML_SLICE slice;
+        if (get_slice(slice, is_tag)) return false;
+        if (is_tag) {
+            if (!is_end_tag(slice, start_tag)) return false;
+            x = 0;
             return true;
-        } else {
-            return false;
         }
+        val = strtod(slice.p, &end);
+        if (end != slice.p+slice.len) return false;
+    } else {
+        eof = get(buf, sizeof(buf), is_tag);
+        if (eof) return false;
+        if (is_tag) {
+            if (!strcmp(buf, end_tag)) {
+                x = 0;      // treat <foo></foo> as <foo>0</foo>
+                return true;
+            } else {
+                return false;
+            }
+        }
+        val = strtod(buf, &end);
+        if (end != buf+strlen(buf)) return false;
     }
-    double val = strtod(buf, &end);
-    if (end != buf+strlen(buf)) return false;
 
     eof = get(tag, sizeof(tag), is_tag);
     if (eof) return false;
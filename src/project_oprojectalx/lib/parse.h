@@ -25,16 +25,35 @@
 
 #include "miofile.h"
 
+// A piece of the buffer being parsed, as returned by XML_PARSER::get_slice().
+// Not NUL-terminated; valid as long as the buffer is.
+//
+struct XML_SLICE {
+    const char* p;
+    int len;
+};
+
+// If the MIOFILE reads from memory (init_buf_read() or init_mmap_read())
+// XML_PARSER scans the buffer directly with pointers
+// rather than a character at a time through MIOFILE::_getc().
+//
 class XML_PARSER {
     bool scan_nonws(int&);
     int scan_comment();
     int scan_tag(char*, int, char* ab=0, int al=0);
     int scan_cdata(char*, int);
     bool copy_until_tag(char*, int);
+    bool buffered() {
+        return !f->f && f->buf;
+    }
+    int scan_buf(XML_SLICE&);
+    int get_aux_buf(char* buf, int len, char* attr_buf, int attr_len);
+    bool is_end_tag(XML_SLICE&, const char*);
 public:
     MIOFILE* f;
     XML_PARSER(MIOFILE*);
     bool get(char*, int, bool&, char* ab=0, int al=0);
+    bool get_slice(XML_SLICE&, bool&);
     int get_aux(char* buf, int len, char* attr_buf, int attr_len);
     bool parse_start(const char*);
     bool parse_str(char*, const char*, char*, int);
@@ -103,6 +122,7 @@ extern int copy_stream(FILE* in, FILE* out);
 extern int strcatdup(char*& p, char* buf);
 extern int dup_element_contents(FILE* in, const char* end_tag, char** pp);
 extern int dup_element(FILE* in, const char* end_tag, char** pp);
+extern int dup_element(MIOFILE& in, const char* end_tag, char** pp);
 extern int copy_element_contents(FILE* in, const char* end_tag, char* p, int len);
 extern int copy_element_contents(FILE* in, const char* end_tag, std::string&);
 extern void replace_element_contents(
@@ -57,6 +57,9 @@ const char *SAH_PACKAGE_STRING=CUSTOM_STRING;
 #ifdef HAVE_MEMORY_H
 #include <memory.h>
 #endif
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
 #include <time.h>
 
 #include "sincos.h"
@@ -128,6 +131,10 @@ static Ipp8u* FftBuf = NULL;
 
 #define INVALID_CHIRP 2e+20
 
+// When chirping on the fly, at least this many samples are chirped at a
+// time so short FFTs don't each pay the per call chirp setup.
+#define CHIRP_CHUNK 4096
+
 ChirpFftPair_t* ChirpFftPairs = NULL;
 
 double ProgressUnitSize;
@@ -164,6 +171,8 @@ int seti_analyze (ANALYSIS_STATE& state) {
     sah_complex* DataIn = state.savedWUData;
     int NumDataPoints = state.npoints;
     sah_complex* ChirpedData = NULL;
+    sah_complex* ChirpChunk = NULL;  // used instead of ChirpedData when chirp_blocks
+    sah_complex* FftIn;
     sah_complex* WorkData = NULL;
     float* PowerSpectrum = NULL;
     float* tPowerSpectrum; // Transposed power spectra if used.
@@ -172,6 +181,13 @@ int seti_analyze (ANALYSIS_STATE& state) {
     use_transposed_pot= (!notranspose_flag) &&
                         ((app_init_data.host_info.m_nbytes != 0)  &&
                         (app_init_data.host_info.m_nbytes >= (double)(96*1024*1024)));
+    // Chirp each FFT block just before it is transformed rather than
+    // keeping a fully chirped copy of the data.  Done on small hosts, which
+    // don't get the trig arrays either.
+    bool chirp_blocks = chirp_blocks_flag ||
+                        ((app_init_data.host_info.m_nbytes != 0)  &&
+                        (app_init_data.host_info.m_nbytes < (double)(64*1024*1024)));
+    int ChunkLen = 0;
     int num_cfft                  = 0;
     float chirprate;
     int last_chirp_ind = - 1 << 20, chirprateind;
@@ -204,9 +220,17 @@ int seti_analyze (ANALYSIS_STATE& state) {
     // fields need by the ooura fft logic
     int * BitRevTab[MAX_NUM_FFTS];
     float * CoeffTab[MAX_NUM_FFTS];
+    // and by the ooura DCT used for the autocorrelation
+    int * AcBitRevTab;
+    float * AcCoeffTab;
 #endif
 
     // Allocate data array and work area arrays.
+    if (chirp_blocks) {
+        // The chirped copy is never used, so give its memory back now.
+        free_a(state.data);
+        state.data = NULL;
+    }
     ChirpedData = state.data;
     PowerSpectrum = (float*) calloc_a(NumDataPoints, sizeof(float), MEM_ALIGN);
     if (PowerSpectrum == NULL) SETIERROR(MALLOC_FAILED, "PowerSpectrum == NULL");
@@ -302,6 +326,13 @@ int seti_analyze (ANALYSIS_STATE& state) {
         }
         fclose(wisdom);
     }
+#elif !defined(USE_IPP)
+    // See docs in fft8g.C for sizing guidelines for the ddct() tables.
+    AcBitRevTab = (int*) calloc_a(3+(int)sqrt((float)(ac_fft_len/2)), sizeof(int), MEM_ALIGN);
+    if (AcBitRevTab == NULL)  SETIERROR(MALLOC_FAILED, "AcBitRevTab == NULL");
+    AcBitRevTab[0] = 0;
+    AcCoeffTab = (float*) calloc_a(ac_fft_len*5/4, sizeof(float), MEM_ALIGN);
+    if (AcCoeffTab == NULL) SETIERROR(MALLOC_FAILED, "AcCoeffTab == NULL");
 #endif
 
     if (!state.icfft) {
@@ -386,6 +417,14 @@ int seti_analyze (ANALYSIS_STATE& state) {
         SETIERROR(MALLOC_FAILED, "WorkData == NULL");
     }
 
+    if (chirp_blocks) {
+        ChunkLen = std::max((int)(FftLen/2), CHIRP_CHUNK);
+        ChirpChunk = (sah_complex *)malloc_a(ChunkLen * sizeof(sah_complex),MEM_ALIGN);
+        if (ChirpChunk == NULL) {
+            SETIERROR(MALLOC_FAILED, "ChirpChunk == NULL");
+        }
+    }
+
     // Smooth Baseline
 
 #ifdef DO_SMOOTH
@@ -471,16 +510,20 @@ int seti_analyze (ANALYSIS_STATE& state) {
             if (sah_graphics) strcpy(sah_graphics->status, "Chirping data");
 #endif
 
-            retval = ChirpData(
-                         DataIn,
-                         ChirpedData,
-                         chirprateind,
-                         chirprate,
-                         NumDataPoints,
-                         swi.subband_sample_rate
-                     );
+            // With chirp_blocks the chirp happens in the FFT loop below,
+            // but progress is still counted here so it matches.
+            if (!chirp_blocks) {
+                retval = ChirpData(
+                             DataIn,
+                             ChirpedData,
+                             chirprateind,
+                             chirprate,
+                             NumDataPoints,
+                             swi.subband_sample_rate
+                         );
 
-            if (retval) SETIERROR(retval, "from ChirpData()");
+                if (retval) SETIERROR(retval, "from ChirpData()");
+            }
 
             progress += (double)(ProgressUnitSize * ChirpProgressUnits());
             chirp_units+=(double)(ProgressUnitSize * ChirpProgressUnits());
@@ -534,22 +577,42 @@ int seti_analyze (ANALYSIS_STATE& state) {
         for (ifft = 0; ifft < NumFfts; ifft++) {
             // boinc_worker_timer();
             CurrentSub = fftlen * ifft;
+            if (chirp_blocks) {
+                // Chirp the next ChunkLen samples (one or more whole FFTs)
+                // when we reach them.
+                int ChunkSub = CurrentSub % ChunkLen;
+                if (ChunkSub == 0) {
+                    retval = fpu_block_ChirpSlice(
+                                 &DataIn[CurrentSub],
+                                 ChirpChunk,
+                                 chirprateind,
+                                 chirprate,
+                                 CurrentSub,
+                                 std::min(ChunkLen, NumDataPoints-CurrentSub),
+                                 swi.subband_sample_rate
+                             );
+                    if (retval) SETIERROR(retval, "from fpu_block_ChirpSlice()");
+                }
+                FftIn = &ChirpChunk[ChunkSub];
+            } else {
+                FftIn = &ChirpedData[CurrentSub];
+            }
 #if !defined(USE_FFTWF) && !defined(USE_IPP)
             // FFTW and IPP now use out of place transforms.
             memcpy(
                 WorkData,
-                &ChirpedData[CurrentSub],
+                FftIn,
                 (int)(fftlen * sizeof(sah_complex))
             );
 #endif
 
             state.FLOP_counter+=5*(double)fftlen*log((double)fftlen)/log(2.0);
 #ifdef USE_IPP
-            ippsFFTInv_CToC_32fc((Ipp32fc*)ChirpedData[CurrentSub],
+            ippsFFTInv_CToC_32fc((Ipp32fc*)FftIn,
                                  (Ipp32fc*)WorkData,
                                  FftSpec[FftNum], FftBuf);
 #elif defined(USE_FFTWF)
-            fftwf_execute_dft(analysis_plans[FftNum], &ChirpedData[CurrentSub], WorkData);
+            fftwf_execute_dft(analysis_plans[FftNum], FftIn, WorkData);
 #else
             // replace time with freq - ooura FFT
             cdft(fftlen*2, 1, WorkData, BitRevTab[FftNum], CoeffTab[FftNum]);
@@ -566,6 +629,11 @@ int seti_analyze (ANALYSIS_STATE& state) {
 	      state.FLOP_counter+=((double)fftlen)*5*log((double)fftlen)/log(2.0)+2*fftlen;
 #if defined(USE_FFTWF)
               fftwf_execute_r2r(autocorr_plan,&PowerSpectrum[CurrentSub],AutoCorrelation);
+#elif !defined(USE_IPP)
+              // ddct() is REDFT10 without the factor of 2.  Only the ratio
+              // of peak to mean power is used, so that doesn't matter.
+              memcpy(AutoCorrelation,&PowerSpectrum[CurrentSub],fftlen*sizeof(float));
+              ddct(fftlen, -1, AutoCorrelation, AcBitRevTab, AcCoeffTab);
 #else
 #error Analysis needs to be modified for your FFT choice.
 #endif
@@ -719,10 +787,14 @@ int seti_analyze (ANALYSIS_STATE& state) {
     for (FftNum = 0; FftNum < swi.num_fft_lengths; FftNum++) {
         if (CoeffTab[FftNum]) free_a(CoeffTab[FftNum]);
     }
+    if (AcBitRevTab) free_a(AcBitRevTab);
+    if (AcCoeffTab) free_a(AcCoeffTab);
 #endif
 
     if (WorkData) free_a(WorkData);
     WorkData = NULL;
+    if (ChirpChunk) free_a(ChirpChunk);
+    ChirpChunk = NULL;
 
     if (ChirpFftPairs) free(ChirpFftPairs);
     if ((app_init_data.host_info.m_nbytes == 0)  ||
@@ -922,6 +994,274 @@ int v_BaseLineSmooth(
     return 0;
 }
 
+// v_BaseLineSmoothInPlace does the same smoothing as v_BaseLineSmooth, but
+// - transforms each chunk in place when it is aligned (only misaligned
+//   chunks go through the scratch array),
+// - works out the boxcar means first and then the scale factors in a
+//   separate loop the compiler can vectorize, with the 1/N of the final
+//   transform folded into them, so there is no separate rescaling pass,
+// - hands the time chunks, which are independent, to baseline_threads
+//   threads.
+// The results differ from v_BaseLineSmooth only by rounding.
+
+// Work areas for one thread.
+struct BLS_WORKER {
+    sah_complex *scratch;
+    float *PowerSpectrum;
+    float *ScaleFactor;
+#if !defined(USE_IPP) && !defined(USE_FFTWF)
+    int *BitRevTab;
+    float *CoeffTab;
+#endif
+};
+
+struct BLS_STATE {
+    int NumPointsInChunk;
+    int NumWorkers;
+    BLS_WORKER *workers;
+#ifdef USE_IPP
+    IppsFFTSpec_C_32fc* FftSpec;
+#elif defined(USE_FFTWF)
+    fftwf_plan backward_transform, forward_transform;
+#endif
+    // per call
+    sah_complex *DataIn;
+    int NumTimeChunks;
+    int BoxCarLength;
+};
+
+static BLS_STATE bls;
+
+static void bls_free() {
+    int t;
+    for (t=0; t<bls.NumWorkers; t++) {
+        BLS_WORKER &w=bls.workers[t];
+        if (w.scratch) free_a(w.scratch);
+        if (w.PowerSpectrum) free_a(w.PowerSpectrum);
+        if (w.ScaleFactor) free_a(w.ScaleFactor);
+#if !defined(USE_IPP) && !defined(USE_FFTWF)
+        if (w.BitRevTab) free_a(w.BitRevTab);
+        if (w.CoeffTab) free_a(w.CoeffTab);
+#endif
+    }
+    if (bls.workers) free(bls.workers);
+#ifdef USE_IPP
+    if (bls.FftSpec) ippsFFTFree_C_32fc(bls.FftSpec);
+#elif defined(USE_FFTWF)
+    if (bls.backward_transform) fftwf_destroy_plan(bls.backward_transform);
+    if (bls.forward_transform) fftwf_destroy_plan(bls.forward_transform);
+#endif
+    memset(&bls,0,sizeof(bls));
+}
+
+static int bls_init(int NumPointsInChunk, int NumWorkers) {
+    int t;
+
+    if ((bls.NumPointsInChunk == NumPointsInChunk) && (bls.NumWorkers == NumWorkers)) {
+        return 0;
+    }
+    bls_free();
+    bls.workers=(BLS_WORKER *)calloc(NumWorkers,sizeof(BLS_WORKER));
+    if (bls.workers == NULL) return MALLOC_FAILED;
+    bls.NumWorkers=NumWorkers;
+    for (t=0; t<NumWorkers; t++) {
+        BLS_WORKER &w=bls.workers[t];
+        w.scratch=(sah_complex *)malloc_a(NumPointsInChunk*sizeof(sah_complex),MEM_ALIGN);
+        w.PowerSpectrum=(float *)malloc_a(NumPointsInChunk*sizeof(float),MEM_ALIGN);
+        w.ScaleFactor=(float *)malloc_a(NumPointsInChunk*sizeof(float),MEM_ALIGN);
+        if (!w.scratch || !w.PowerSpectrum || !w.ScaleFactor) {
+            bls_free();
+            return MALLOC_FAILED;
+        }
+#if !defined(USE_IPP) && !defined(USE_FFTWF)
+        // cdft() initializes these on first use, since BitRevTab[0]==0.
+        w.BitRevTab=(int *)calloc_a(3+(int)sqrt((float)NumPointsInChunk/2), sizeof(int), MEM_ALIGN);
+        w.CoeffTab=(float *)calloc_a(NumPointsInChunk/2, sizeof(float), MEM_ALIGN);
+        if (!w.BitRevTab || !w.CoeffTab) {
+            bls_free();
+            return MALLOC_FAILED;
+        }
+#endif
+    }
+
+    // Both transforms are planned in place on aligned memory, so they can
+    // be executed on any aligned chunk.
+#ifdef USE_IPP
+    int order = 0;
+    for (int tmp = NumPointsInChunk; !(tmp & 1); order++) tmp >>= 1;
+    if (ippsFFTInitAlloc_C_32fc(&bls.FftSpec, order, IPP_FFT_NODIV_BY_ANY,
+                                ippAlgHintAccurate)) {
+        bls_free();
+        return MALLOC_FAILED;
+    }
+#elif defined(USE_FFTWF)
+    sah_complex *scratch=bls.workers[0].scratch;
+    bls.backward_transform = fftwf_plan_dft_1d(NumPointsInChunk, scratch, scratch, FFTW_BACKWARD, FFTW_MEASURE);
+    bls.forward_transform = fftwf_plan_dft_1d(NumPointsInChunk, scratch, scratch, FFTW_FORWARD, FFTW_MEASURE);
+    if (!bls.backward_transform || !bls.forward_transform) {
+        // No work areas are left set up, so the caller uses v_BaseLineSmooth.
+        bls_free();
+        return 0;
+    }
+#endif
+    bls.NumPointsInChunk=NumPointsInChunk;
+    return 0;
+}
+
+static void bls_chunk(BLS_WORKER &w, sah_complex *DataInChunk) {
+    int NumPointsInChunk=bls.NumPointsInChunk, BoxCarLength=bls.BoxCarLength;
+    float *PowerSpectrum=w.PowerSpectrum, *ScaleFactor=w.ScaleFactor;
+    float Total, LocalMean, recipNumPointsInChunk=1.0f/NumPointsInChunk;
+    int h, i, j, k, Endpoint;
+    bool aligned=(((size_t)DataInChunk % MEM_ALIGN) == 0);
+    sah_complex *Data = aligned ? DataInChunk : w.scratch;
+
+    if (!aligned) {
+        memcpy(Data, DataInChunk, NumPointsInChunk*sizeof(sah_complex));
+    }
+
+    // transform to freq
+#ifdef USE_IPP
+    ippsFFTInv_CToC_32fc((Ipp32fc*)Data, (Ipp32fc*)Data, bls.FftSpec, NULL);
+#elif defined(USE_FFTWF)
+    fftwf_execute_dft(bls.backward_transform, Data, Data);
+#else
+    cdft(NumPointsInChunk*2, 1, Data, w.BitRevTab, w.CoeffTab);
+#endif
+
+    GetPowerSpectrum(Data, PowerSpectrum, NumPointsInChunk);
+
+    // Sliding boxcar means, in the same order as v_BaseLineSmooth.  A boxcar
+    // is i----j----k, starting at the lowest negative freq.
+    Endpoint = NumPointsInChunk / 2;
+    i = Endpoint;
+    j = i + BoxCarLength / 2;
+    k = i + BoxCarLength;
+    Total = 0;
+    for (h = i; h < k; h++) {
+        Total += PowerSpectrum[h];
+    }
+    LocalMean = Total / BoxCarLength;
+    for (h = i; h < j; h++) {
+        ScaleFactor[h] = LocalMean;
+    }
+    for (; k != Endpoint; i++, j++, k++) {
+        if (k == NumPointsInChunk) {
+            k = 0;
+        }
+        if (j == NumPointsInChunk) {
+            j = 0;
+        }
+        if (i == NumPointsInChunk) {
+            i = 0;
+        }
+        LocalMean = LocalMean
+                    - PowerSpectrum[i] / BoxCarLength
+                    + PowerSpectrum[k] / BoxCarLength;
+        ScaleFactor[j] = LocalMean;
+    }
+    for (h = j; h < k; h++) {
+        ScaleFactor[h] = LocalMean;
+    }
+
+    // normalize, including the 1/N of the transform back
+    for (h = 0; h < NumPointsInChunk; h++) {
+        ScaleFactor[h] = recipNumPointsInChunk / sqrtf(ScaleFactor[h] * 0.5f);
+    }
+    for (h = 0; h < NumPointsInChunk; h++) {
+        Data[h][0] *= ScaleFactor[h];
+        Data[h][1] *= ScaleFactor[h];
+    }
+
+    // transform back to time
+#ifdef USE_IPP
+    ippsFFTFwd_CToC_32fc((Ipp32fc*)Data, (Ipp32fc*)Data, bls.FftSpec, NULL);
+#elif defined(USE_FFTWF)
+    fftwf_execute_dft(bls.forward_transform, Data, Data);
+#else
+    cdft(NumPointsInChunk*2, -1, Data, w.BitRevTab, w.CoeffTab);
+#endif
+
+    if (!aligned) {
+        memcpy(DataInChunk, Data, NumPointsInChunk*sizeof(sah_complex));
+    }
+}
+
+// Thread t does chunks t, t+NumWorkers, ...
+static void *bls_worker(void *arg) {
+    int t=(int)(size_t)arg;
+    int TimeChunk;
+
+    for (TimeChunk = t; TimeChunk < bls.NumTimeChunks; TimeChunk += bls.NumWorkers) {
+#ifdef BOINC_APP_GRAPHICS
+        if ((t == 0) && sah_graphics) sah_graphics->local_progress = (((float)TimeChunk)/bls.NumTimeChunks);
+#endif
+        bls_chunk(bls.workers[t], &(bls.DataIn[TimeChunk*bls.NumPointsInChunk]));
+    }
+    return NULL;
+}
+
+int v_BaseLineSmoothInPlace(
+    sah_complex* DataIn,
+    int NumDataPoints,
+    int BoxCarLength,
+    int NumPointsInChunk
+) {
+    int t, NumWorkers, TimeChunk, retval;
+    int NumTimeChunks = NumDataPoints / NumPointsInChunk;
+
+    NumWorkers = UNSTDMAX(1, UNSTDMIN(baseline_threads, NumTimeChunks));
+#ifndef HAVE_PTHREAD
+    NumWorkers = 1;
+#endif
+    retval = bls_init(NumPointsInChunk, NumWorkers);
+    if (retval) return retval;
+    if (!bls.workers) {
+        // FFTW couldn't plan the in place transforms
+        return v_BaseLineSmooth(DataIn, NumDataPoints, BoxCarLength, NumPointsInChunk);
+    }
+    bls.DataIn = DataIn;
+    bls.NumTimeChunks = NumTimeChunks;
+    bls.BoxCarLength = BoxCarLength;
+
+#ifdef HAVE_PTHREAD
+    pthread_t *threads = NULL;
+    int *started = NULL;
+    if (NumWorkers > 1) {
+        threads = (pthread_t *)calloc(NumWorkers, sizeof(pthread_t));
+        started = (int *)calloc(NumWorkers, sizeof(int));
+        if (!threads || !started) {
+            if (threads) free(threads);
+            if (started) free(started);
+            return MALLOC_FAILED;
+        }
+        for (t = 1; t < NumWorkers; t++) {
+            started[t] = !pthread_create(&threads[t], NULL, bls_worker, (void *)(size_t)t);
+        }
+    }
+#endif
+    bls_worker((void *)0);
+#ifdef HAVE_PTHREAD
+    if (threads) {
+        for (t = 1; t < NumWorkers; t++) {
+            // if a thread couldn't be started its chunks are done here
+            if (started[t]) {
+                pthread_join(threads[t], NULL);
+            } else {
+                bls_worker((void *)(size_t)t);
+            }
+        }
+        free(threads);
+        free(started);
+    }
+#endif
+
+    for (TimeChunk = 0; TimeChunk < NumTimeChunks; TimeChunk++) {
+        analysis_state.FLOP_counter+=10.0*NumPointsInChunk*log((double)NumPointsInChunk)/log(2.0)+10.0*NumPointsInChunk;
+    }
+    return 0;
+}
+
 
 int v_GetPowerSpectrum(
     sah_complex* FreqData,
@@ -69,6 +69,13 @@ extern int v_BaseLineSmooth(
     int ul_TimeLength
   );
 
+extern int v_BaseLineSmoothInPlace(
+    sah_complex * cx_DataIn,
+    int ul_NumDataPoints,
+    int ul_BoxCarLength,
+    int ul_TimeLength
+  );
+
 extern int v_GetPowerSpectrum(
     sah_complex * cx_FreqData,
     float * fp_PowerSpectrum,
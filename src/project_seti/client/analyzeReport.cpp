@@ -36,6 +36,8 @@
 #include <cstring>
 #include <cstdlib>
 #include <cmath>
+#include <vector>
+#include <algorithm>
 
 #include "diagnostics.h"
 #include "util.h"
@@ -102,13 +104,59 @@ static double interpol(double x1,double y1,double x2,double y2, double x) {
   return slope*(x-x1)+y1;
 }
 
-void time_to_ra_dec(double time_jd, double *ra, double *dec) {
-  int i=0;
-  double raoffs=0;
+// Pointing history lookup for time_to_ra_dec(), set up once per workunit
+// by pointing_init().  seg_end[i] is the end time of segment i.  When the
+// history is in time order the segment is found by binary search, after
+// first trying the segment used by the previous call (signals from one
+// FFT row share a time, so this usually hits).  The segment chosen is the
+// one the original linear scan picked, so results don't change.
+static std::vector<double> seg_end;
+static bool pointing_sorted=false;
+static size_t last_seg=0;
+
+void pointing_init() {
+  size_t i;
+
+  seg_end.clear();
+  pointing_sorted=false;
+  last_seg=0;
+  if (swi.num_positions<2) return;
+
+  pointing_sorted=true;
+  for (i=0;i<swi.num_positions-1;i++) {
+    if (!(swi.position_history[i].time<=swi.position_history[i+1].time)) {
+      pointing_sorted=false;
+    }
+  }
+  // the last segment is used for anything past the end of the history
+  for (i=0;i<swi.num_positions-2;i++) {
+    seg_end.push_back(swi.position_history[i+1].time);
+  }
+}
+
+static size_t find_segment(double time_jd) {
+  size_t i=0;
+
+  if (!pointing_sorted || (seg_end.size()+2 != swi.num_positions)) {
+    while ((i<swi.num_positions-2) && (swi.position_history[i+1].time<time_jd)) {
+      i++;
+    }
+    return i;
+  }
 
-  while ((i<swi.num_positions-2) && (swi.position_history[i+1].time<time_jd)) {
-    i++;
+  i=last_seg;
+  if (((i==0) || (seg_end[i-1]<time_jd)) &&
+      ((i==seg_end.size()) || !(seg_end[i]<time_jd))) {
+    return i;
   }
+  i=std::lower_bound(seg_end.begin(),seg_end.end(),time_jd)-seg_end.begin();
+  last_seg=i;
+  return i;
+}
+
+void time_to_ra_dec(double time_jd, double *ra, double *dec) {
+  size_t i=find_segment(time_jd);
+  double raoffs=0;
 
   if ((swi.position_history[i+1].ra-swi.position_history[i].ra)> 12.0) {
     raoffs=-24.0;
@@ -140,11 +188,19 @@ void time_to_ra_dec(double time_jd, double *ra, double *dec) {
 }
 
 
+// Formats a signal straight into outfile, without building a string first.
+template <typename T>
+static int write_signal(const T &sig) {
+  mfile_xml_writer w(outfile);
+  sig.print_xml(w,0,0,1);
+  return w.flush();
+}
+
 int result_spike(SPIKE_INFO &si) {
 
   int retval=0;
 
-  retval = outfile.printf("%s", si.s.print_xml(0,0,1).c_str());
+  retval = write_signal(si.s);
 
   if (retval < 0) {
     SETIERROR(WRITE_FAILED,"in result_spike");
@@ -164,7 +220,7 @@ int result_autocorr(AUTOCORR_INFO &ai) {
 
   int retval=0;
 
-  retval = outfile.printf("%s", ai.a.print_xml(0,0,1).c_str());
+  retval = write_signal(ai.a);
 
   if (retval < 0) {
     SETIERROR(WRITE_FAILED,"in result_autocorr");
@@ -184,7 +240,7 @@ int result_gaussian(GAUSS_INFO &gi) {
 
   int retval=0;
 
-  retval = outfile.printf("%s", gi.g.print_xml(0,0,1).c_str());
+  retval = write_signal(gi.g);
 
   if (retval >= 0) {
     retval= outfile.printf("\n");
@@ -302,7 +358,7 @@ BOINCASSERT(_CrtCheckMemory());
 
   if (write_triplet) {
 
-    retval = outfile.printf("%s", ti.t.print_xml(0,0,1).c_str());
+    retval = write_signal(ti.t);
 
     if (retval < 0) {
       SETIERROR(WRITE_FAILED,"in ReportTripletEvent");
@@ -417,7 +473,7 @@ BOINCASSERT(_CrtCheckMemory());
 //	sprintf(&pi.p.pot[i], "%02x",(int)((folded_pot[i]-MinPower)*norm));
  //   }
 
-    retval = outfile.printf("%s", pi.p.print_xml(0,0,1).c_str());
+    retval = write_signal(pi.p);
 
     if (retval >= 0) {
       outfile.printf("\n");
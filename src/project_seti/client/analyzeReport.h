@@ -33,6 +33,20 @@
 #include "seti.h"
 #include "boinc_api.h"
 #include "mfile.h"
+#include "../db/xml_util.h"
+
+// Lets print_xml() write signals straight into an MFILE.
+class mfile_xml_writer : public xml_writer {
+  public:
+    mfile_xml_writer(MFILE &f) : mf(f) {};
+    ~mfile_xml_writer() { flush(); };
+  protected:
+    int write(const char *p, size_t len) {
+      return (mf.write(p,1,len)==len)?0:-1;
+    };
+  private:
+    MFILE &mf;
+};
 
 int ReportEvents(
     float * fp_PowerSpectrum,
@@ -83,6 +97,7 @@ int result_autocorr(AUTOCORR_INFO &ai);
 
 int result_gaussian(GAUSS_INFO &gi);
 
+void pointing_init();
 void time_to_ra_dec(double time_jd, double *ra, double *dec);
 
 extern void reset_high_scores();
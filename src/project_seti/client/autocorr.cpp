@@ -54,6 +54,41 @@
 
 #include "../db/schema_master.h"
 
+// Keeps the n highest distinct powers seen so far, highest first, each with
+// the first bin it occurred in.  Bins must be offered in increasing order.
+// This is what repeatedly scanning for the next highest power below the
+// last one found would pick, but in a single pass.
+struct AUTOCORR_PEAKS {
+  std::vector<float> power;
+  std::vector<int> bin;
+  int n, count;
+  float thresh;   // a power must exceed this to get in
+
+  void reset(int num) {
+    n = num;
+    count = 0;
+    thresh = 0.0f;
+    power.resize(n);
+    bin.resize(n);
+  }
+
+  void add(float p, int b) {
+    int i, pos;
+
+    if (n == 0) return;
+    for (pos = 0; pos < count && power[pos] > p; pos++);
+    if (pos < count && power[pos] == p) return;
+    if (count < n) count++;
+    for (i = count - 1; i > pos; i--) {
+      power[i] = power[i-1];
+      bin[i] = bin[i-1];
+    }
+    power[pos] = p;
+    bin[pos] = b;
+    if (count == n) thresh = power[n-1];
+  }
+};
+
 int FindAutoCorrelation(
   float * AutoCorrelation,
   int ul_NumDataPoints,
@@ -62,56 +97,54 @@ int FindAutoCorrelation(
 ) {
   // Because positive and negative delays are the same
   // we only have to look at half the points
-  int i, j, k, m, retval, blksize;
+  int i, j, k, retval, blksize, start;
   float temp;
-  float total, MeanPower, partial;
+  float total, MeanPower, partial, blkmax;
   AUTOCORR_INFO ai;
+  static AUTOCORR_PEAKS peaks;
 
-  i = j = k = m = 0;
+  i = j = k = 0;
   total = 0.0f;
 
   int len = ul_NumDataPoints/2;
   blksize = UNSTDMAX(4, UNSTDMIN(pow2((unsigned int) sqrt((float) (len / 32)) * 32), 512));
 
+  // Square, sum and pick out the autocorr_per_spectrum highest powers in
+  // one pass over the data, a block at a time while it is still in cache.
+  // Start at 1, in order to skip the DC (ie 0) bin.
+  peaks.reset(swi.analysis_cfg.autocorr_per_spectrum);
   for(int b = 0; b < len/blksize; b++) {
+      float *block = AutoCorrelation + b*blksize;
       partial = 0.0f;
+      blkmax = 0.0f;
 	  for(i = 0; i < blksize; i++) {
-		AutoCorrelation[b*blksize+i]*=AutoCorrelation[b*blksize+i];
-		partial += AutoCorrelation[b*blksize+i];
+		block[i]*=block[i];
+		partial += block[i];
+		blkmax = (block[i] > blkmax) ? block[i] : blkmax;
 	  }
 	  total += partial;
+	  // most blocks hold nothing that can get in
+	  if (blkmax <= peaks.thresh && b != 0) continue;
+	  start = (b == 0) ? 1 : 0;
+	  for(i = start; i < blksize; i++) {
+		if (block[i] > peaks.thresh) peaks.add(block[i], b*blksize+i);
+	  }
+  }
+  for(j = UNSTDMAX(1, (len/blksize)*blksize); j < len; j++) {
+    if (AutoCorrelation[j] > peaks.thresh) peaks.add(AutoCorrelation[j], j);
   }
   MeanPower = total / ul_NumDataPoints;
 
-  // Here we extract the autocorrs_to_report highest power events,
-  // outputing them as we go.
-  // Index usage:
-  // i : walk power spectrum us_NumToReport times
-  // j : walks power spectrum for each i
-  // k : marks current high power candidate while j walks on
-  // m : marks the current tail of the high power hit "list"
-
-
+  // Report them highest first.  If there are fewer distinct powers than
+  // autocorr_per_spectrum, the rest are reported as zero power at the
+  // last bin found.
   for (i = 0; i < swi.analysis_cfg.autocorr_per_spectrum; i++) {
 
     temp = 0.0;
-
-    // Walk the array, looking for the first/next highest power.
-    // Start j at 1, in order to skip the DC (ie 0) bin.
-    // NOTE: this is a simple scan for high powers.  Nice and fast
-    // for a very low i.  If i is substantial, this code should be
-    // replaced with an index (q)sort.  
-    for (j = 1; j < ul_NumDataPoints/2; j++) {
-
-      if (AutoCorrelation[j] > temp) {
-        if (AutoCorrelation[j] < AutoCorrelation[m] || m == 0) {
-          temp = AutoCorrelation[j];
-          k = j;
-        }
-      }
-    } // temp now = first/next highest power and k = it's bin number
-
-    m = k; 		// save the "lowest" highest.
+    if (i < peaks.count) {
+      temp = peaks.power[i];
+      k = peaks.bin[i];
+    }
 
     //  autocorr info
     ai.a.peak_power 	 = temp/MeanPower;
@@ -15,7 +15,6 @@ NOTE ON USE BY SETI@HOME :  All floating point objects were changed
     Also, the following unused transforms were
     removed from the source:
      rdft: Real Discrete Fourier Transform
-         ddct: Discrete Cosine Transform
          ddst: Discrete Sine Transform
          dfct: Cosine Transform of RDFT (Real Symmetric DFT)
          dfst: Sine Transform of RDFT (Real Anti-symmetric DFT)
@@ -33,6 +32,8 @@ Fast Fourier/Cosine/Sine Transform
     table       :use
 functions
     cdft: Complex Discrete Fourier Transform
+    ddct: Discrete Cosine Transform (used for the autocorrelation
+          when not building with FFTW)
 function prototypes
     void cdft(int, int, float *, int *, float *);
     void rdft(int, int, float *, int *, float *);
@@ -85,6 +86,46 @@ function prototypes
         .
  
  
+-------- DCT (Discrete Cosine Transform) / Inverse of DCT --------
+    [definition]
+        <case1> IDCT (excluding scale)
+            C[k] = sum_j=0^n-1 a[j]*cos(pi*j*(k+1/2)/n), 0<=k<n
+        <case2> DCT
+            C[k] = sum_j=0^n-1 a[j]*cos(pi*(j+1/2)*k/n), 0<=k<n
+    [usage]
+        <case1>
+            ip[0] = 0; // first time only
+            ddct(n, 1, a, ip, w);
+        <case2>
+            ip[0] = 0; // first time only
+            ddct(n, -1, a, ip, w);
+    [parameters]
+        n              :data length (int)
+                        n >= 2, n = power of 2
+        a[0...n-1]     :input/output data (float *)
+                        output data
+                            a[k] = C[k], 0<=k<n
+        ip[0...*]      :work area for bit reversal (int *)
+                        length of ip >= 2+sqrt(n/2)
+                        strictly, 
+                        length of ip >= 
+                            2+(1<<(int)(log(n/2+0.5)/log(2))/2).
+                        ip[0],ip[1] are pointers of the cos/sin table.
+        w[0...n*5/4-1] :cos/sin table (float *)
+                        w[],ip[] are initialized if ip[0] == 0.
+    [remark]
+        Inverse of 
+            ddct(n, -1, a, ip, w);
+        is 
+            a[0] *= 0.5;
+            ddct(n, 1, a, ip, w);
+            for (j = 0; j <= n - 1; j++) {
+                a[j] *= 2.0 / n;
+            }
+        .
+        Case2 is FFTW's REDFT10 (DCT-II) without its factor of 2.
+
+
 Appendix :
     The cos/sin table is recalculated when the larger table required.
     w[] and ip[] are compatible with all routines.
@@ -123,6 +164,64 @@ void cdft(int n, int isgn, sah_complex *aa, int *ip, float *w) {
 }
 
 
+void ddct(int n, int isgn, float *a, int *ip, float *w) {
+  void makewt(int nw, int *ip, float *w);
+  void makect(int nc, int *ip, float *c);
+  void bitrv2(int n, int *ip, float *a);
+  void cftfsub(int n, float *a, float *w);
+  void cftbsub(int n, float *a, float *w);
+  void rftfsub(int n, float *a, int nc, float *c);
+  void rftbsub(int n, float *a, int nc, float *c);
+  void dctsub(int n, float *a, int nc, float *c);
+  int j, nw, nc;
+  float xr;
+
+  nw = ip[0];
+  if (n > (nw << 2)) {
+    nw = n >> 2;
+    makewt(nw, ip, w);
+  }
+  nc = ip[1];
+  if (n > nc) {
+    nc = n;
+    makect(nc, ip, w + nw);
+  }
+  if (isgn < 0) {
+    xr = a[n - 1];
+    for (j = n - 2; j >= 2; j -= 2) {
+      a[j + 1] = a[j] - a[j - 1];
+      a[j] += a[j - 1];
+    }
+    a[1] = a[0] - xr;
+    a[0] += xr;
+    if (n > 4) {
+      rftbsub(n, a, nc, w + nw);
+      bitrv2(n, ip + 2, a);
+      cftbsub(n, a, w);
+    } else if (n == 4) {
+      cftfsub(n, a, w);
+    }
+  }
+  dctsub(n, a, nc, w + nw);
+  if (isgn >= 0) {
+    if (n > 4) {
+      bitrv2(n, ip + 2, a);
+      cftfsub(n, a, w);
+      rftfsub(n, a, nc, w + nw);
+    } else if (n == 4) {
+      cftfsub(n, a, w);
+    }
+    xr = a[0] - a[1];
+    a[0] += a[1];
+    for (j = 2; j < n; j += 2) {
+      a[j - 1] = a[j] - a[j + 1];
+      a[j] += a[j + 1];
+    }
+    a[n - 1] = xr;
+  }
+}
+
+
 /* -------- initializing routines -------- */
 
 
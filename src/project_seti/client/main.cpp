@@ -101,6 +101,8 @@ void usage() {
 #endif
     " -version  show version info\n"
     " -verbose  print running status\n"
+    " -nthreads N  use N threads for baseline smoothing\n"
+    " -chirp_blocks  chirp each FFT block as it is needed (saves memory)\n"
   );
 }
 
@@ -141,6 +143,8 @@ extern double f_PeakPowerThresh;
 extern double chi_sq_thresh;
 bool notranspose_flag=false;
 bool default_functions_flag=false;
+bool chirp_blocks_flag=false;
+int baseline_threads=1;
 
 int run_stage;
 
@@ -198,6 +202,13 @@ int main(int argc, char** argv) {
         notranspose_flag = true;
     } else if (!strncmp(p, "def", 3)) {
         default_functions_flag = true;
+    } else if (!strncmp(p, "chi", 3)) {
+        chirp_blocks_flag = true;
+    } else if (!strncmp(p, "nth", 3) && (i+1 < argc)) {
+        i++;
+        g_argv[i]=argv[i];
+        baseline_threads = atoi(argv[i]);
+        if (baseline_threads < 1) baseline_threads = 1;
     } else {
       fprintf(stderr, "bad arg: %s\n", argv[i]);
       usage();
@@ -0,0 +1,85 @@
+// Checks Ooura's ddct() (fft8g.cpp), which does the autocorrelation in
+// builds without FFTW, against a plain double precision DCT-II, then
+// times it.
+//
+// ddct(n,-1) computes sum_j a[j]*cos(pi*(j+0.5)*k/n), which is FFTW's
+// REDFT10 without the factor of 2.  For n up to 4096 every output is
+// compared, above that 256 evenly spaced ones (the reference is O(n) per
+// output).  The error is relative to the largest reference output.
+//
+// Usage: ooura_dct_test [max_n]
+//   max_n  largest transform length (131072 by default)
+// Exits with 0 if every length was within 1e-6.
+
+#include "sah_config.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <sys/time.h>
+
+#include "s_util.h"
+#include "fft8g.h"
+
+static double now() {
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + tv.tv_usec*1e-6;
+}
+
+int main(int argc, char **argv) {
+  int max_n=(argc>1)?atoi(argv[1]):131072;
+  int n, i, j, k, step, rep, calls, ncalls, errors=0;
+  double err, maxref, s, t, best;
+
+  srand(1);
+  for (n=8; n<=max_n; n*=2) {
+    float *in=(float *)malloc(n*sizeof(float));
+    float *a=(float *)malloc(n*sizeof(float));
+    int *ip=(int *)calloc(3+(int)sqrt((float)(n/2)), sizeof(int));
+    float *w=(float *)calloc(n*5/4, sizeof(float));
+    if (!in || !a || !ip || !w) {
+      fprintf(stderr,"out of memory\n");
+      return 1;
+    }
+    // power spectrum like input: non-negative
+    for (i=0; i<n; i++) in[i]=(float)rand()/RAND_MAX;
+
+    for (i=0; i<n; i++) a[i]=in[i];
+    ip[0]=0;
+    ddct(n, -1, a, ip, w);
+
+    step=(n<=4096)?1:n/256;
+    err=0;
+    maxref=0;
+    for (k=0; k<n; k+=step) {
+      for (s=0, j=0; j<n; j++) s+=in[j]*cos(M_PI*(j+0.5)*k/n);
+      if (fabs(s)>maxref) maxref=fabs(s);
+      if (fabs(a[k]-s)>err) err=fabs(a[k]-s);
+    }
+    err/=maxref;
+
+    // per call, best of 10 runs of about 1M points each, tables already
+    // made; includes copying the input back in
+    ncalls=(n<1048576)?1048576/n:1;
+    best=1e30;
+    for (rep=0; rep<10; rep++) {
+      t=now();
+      for (calls=0; calls<ncalls; calls++) {
+        for (i=0; i<n; i++) a[i]=in[i];
+        ddct(n, -1, a, ip, w);
+      }
+      t=(now()-t)/ncalls;
+      if (t<best) best=t;
+    }
+
+    printf("%s n=%6d  relative error %8.2e  %9.1f us\n",
+      (err<1e-6)?"ok     ":"FAILED ", n, err, best*1e6);
+    if (!(err<1e-6)) errors++;
+    free(in);
+    free(a);
+    free(ip);
+    free(w);
+  }
+  printf("%s\n", errors ? "FAILED" : "OK");
+  return errors ? 1 : 0;
+}
@@ -182,19 +182,9 @@ int read_bin_data(unsigned char* bin, int nbytes, FILE* f) {
 // see the doc on binary data representation
 
 void bits_to_floats(unsigned char* raw, sah_complex* data, int nsamples) {
-  int i, j, k=0;
-  unsigned char c;
-
-  for (i=0; i<nsamples/4; i++) {
-    j = (i&1) ? i-1 : i+1;
-    c = raw[j];
-    for (j=0; j<4; j++) {
-      data[k][0] = (float)((c&2)?1:-1);
-      data[k][1] = (float)((c&1)?1:-1);
-      k++;
-      c >>= 2;
-    }
-  }
+  // Samples are stored as big endian 16 bit words, the real part in the
+  // high bit of each pair.
+  unpack_2bit_samples(raw, &(data[0][0]), nsamples/4, 1, 1);
 }
 
 int float_to_uchar(float float_element[], unsigned char char_element[],
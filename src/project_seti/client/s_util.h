@@ -30,6 +30,7 @@
 #define _UTIL_H
 
 #include <cstdio>
+#include <cstring>
 #include <sys/types.h>
 #include <string>
 #include "track_mem.h"
@@ -146,10 +147,60 @@ extern void encode(unsigned char* bin, int nbytes, FILE* f);
 extern int decode(unsigned char* bin, int nbytes, FILE* f);
 extern int read_bin_data(unsigned char* bin, int nbytes, FILE* f);
 extern void bits_to_floats(unsigned char* raw, sah_complex *data, int nsamples);
+
+// 2 bit complex samples are packed four to a byte, the first sample in the
+// lowest two bits.  bits_lut(real_bit) gives, for each byte value, its four
+// samples as (real,imag) pairs of +/-1.0 with the real part taken from bit
+// real_bit of each pair.  Both tables together are 16KB, so they stay in
+// L1 where the splitter's old 65536 entry table (4MB) did not.
+typedef float bits_lut_entry[8];
+
+inline const bits_lut_entry *bits_lut(int real_bit) {
+  static bits_lut_entry lut[2][256];
+  static bool initialized=false;
+  int r, b, j;
+  if (!initialized) {
+    for (r=0; r<2; r++) {
+      for (b=0; b<256; b++) {
+        for (j=0; j<4; j++) {
+          lut[r][b][2*j]=((b>>(2*j+r))&1)?1.0f:-1.0f;
+          lut[r][b][2*j+1]=((b>>(2*j+1-r))&1)?1.0f:-1.0f;
+        }
+      }
+    }
+    initialized=true;
+  }
+  return lut[real_bit];
+}
+
+// Unpacks nbytes bytes of 2 bit samples into 4*nbytes (real,imag) pairs.
+// With swap set the bytes are taken in swapped pairs (1,0,3,2,...), as in
+// big endian 16 bit words read on a little endian machine.
+inline void unpack_2bit_samples(const unsigned char *raw, float *data,
+    int nbytes, int real_bit, int swap) {
+  const bits_lut_entry *lut=bits_lut(real_bit);
+  int i;
+  swap=swap?1:0;
+  for (i=0; i<nbytes; i++) {
+    memcpy(data+8*i,lut[raw[i^swap]],sizeof(bits_lut_entry));
+  }
+}
+
 extern int float_to_uchar(
     float float_element[], unsigned char char_element[],
     long num_elements, float scale_factor
   );
 extern char* error_string(int);
 
+// Returns the first occurrence of s in [p,end), or NULL.  The buffer need
+// not be null terminated (e.g. a memory mapped file).
+inline const char *find_in_buf(const char *p, const char *end, const char *s) {
+  size_t n=strlen(s);
+  while ((p+n <= end) && (p=(const char *)memchr(p,s[0],(end-p)-n+1))) {
+    if (!memcmp(p,s,n)) return p;
+    p++;
+  }
+  return NULL;
+}
+
 #endif
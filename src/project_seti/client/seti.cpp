@@ -341,6 +341,7 @@ int seti_init_state() {
   analysis_state.PoT_activity = POT_INACTIVE;
   progress = 0.0;
   reset_high_scores();
+  pointing_init();
   std::string path;
 
   boinc_resolve_filename_s(OUTFILE_FILENAME, path);
@@ -394,8 +395,9 @@ int checkpoint(BOOLEAN force_checkpoint) {
   int retval=0, i, l=xml_indent_level;
   xml_indent_level=0;
   MFILE state_file;
+  mfile_xml_writer state_writer(state_file);
   char buf[2048];
-  std::string enc_field, str;
+  std::string enc_field;
 
   // The user may have set preferences for a long time between
   // checkpoints to reduce disk access.
@@ -446,8 +448,9 @@ BOINCASSERT(_CrtCheckMemory());
     retval = state_file.printf("<best_spike>\n");
     if (retval < 0) SETIERROR(WRITE_FAILED,"in checkpoint()");
     // the spike proper
-    str = best_spike->s.print_xml(0,0,1);
-    retval = (int)state_file.write(str.c_str(), str.size(), 1);
+    best_spike->s.print_xml(state_writer,0,0,1);
+    retval = state_writer.flush();
+    if (retval < 0) SETIERROR(WRITE_FAILED,"in checkpoint()");
     // ancillary data
     retval = state_file.printf(
                "<bs_score>%f</bs_score>\n"
@@ -466,8 +469,9 @@ BOINCASSERT(_CrtCheckMemory());
     retval = state_file.printf("<best_autocorr>\n");
     if (retval < 0) SETIERROR(WRITE_FAILED,"in checkpoint()");
     // the autocorr proper
-    str = best_autocorr->a.print_xml(0,0,1);
-    retval = (int)state_file.write(str.c_str(), str.size(), 1);
+    best_autocorr->a.print_xml(state_writer,0,0,1);
+    retval = state_writer.flush();
+    if (retval < 0) SETIERROR(WRITE_FAILED,"in checkpoint()");
     // ancillary data
     retval = state_file.printf(
                "<ba_score>%f</ba_score>\n"
@@ -486,8 +490,9 @@ BOINCASSERT(_CrtCheckMemory());
     retval = state_file.printf("<best_gaussian>\n");
     if (retval < 0) SETIERROR(WRITE_FAILED,"in checkpoint()");
     // the gaussian proper 
-    str = best_gauss->g.print_xml(0,0,1);
-    retval = (int)state_file.write(str.c_str(), str.size(), 1);
+    best_gauss->g.print_xml(state_writer,0,0,1);
+    retval = state_writer.flush();
+    if (retval < 0) SETIERROR(WRITE_FAILED,"in checkpoint()");
     // ancillary data
     retval = state_file.printf(
                "<bg_score>%f</bg_score>\n"
@@ -509,8 +514,9 @@ BOINCASSERT(_CrtCheckMemory());
     retval = state_file.printf("<best_pulse>\n");
     if (retval < 0) SETIERROR(WRITE_FAILED,"in checkpoint()");
     // the pulse proper 
-    str = best_pulse->p.print_xml(0,0,1);
-    retval = (int)state_file.write(str.c_str(), str.size(), 1);
+    best_pulse->p.print_xml(state_writer,0,0,1);
+    retval = state_writer.flush();
+    if (retval < 0) SETIERROR(WRITE_FAILED,"in checkpoint()");
     // ancillary data
     retval = state_file.printf(
                "<bp_score>%f</bp_score>\n"
@@ -529,8 +535,9 @@ BOINCASSERT(_CrtCheckMemory());
     retval = state_file.printf("<best_triplet>\n");
     if (retval < 0) SETIERROR(WRITE_FAILED,"in checkpoint()");
     // the triplet proper 
-    str = best_triplet->t.print_xml(0,0,1);
-    retval = (int)state_file.write(str.c_str(), str.size(), 1);
+    best_triplet->t.print_xml(state_writer,0,0,1);
+    retval = state_writer.flush();
+    if (retval < 0) SETIERROR(WRITE_FAILED,"in checkpoint()");
 
     // ancillary data
     retval = state_file.printf(
@@ -840,11 +847,15 @@ int seti_do_work() {
 }
 
 // on success, swi.data points to malloced data.
-int seti_parse_data(FILE* f, ANALYSIS_STATE& state) {
+// wu holds the whole workunit file; the data follow the header, which ends
+// at data_offset.
+int seti_parse_data(const char *wu, size_t len, size_t data_offset, ANALYSIS_STATE& state) {
   unsigned long nbytes, nsamples,samples_per_byte;
   sah_complex *data;
   unsigned long i;
-  char *p, buf[256];
+  const char *p, *eol, *end=wu+len;
+  char buf[256];
+  size_t n;
   sah_complex *bin_data=0;
   int retval=0;
   FORCE_FRAME_POINTER;
@@ -858,11 +869,17 @@ int seti_parse_data(FILE* f, ANALYSIS_STATE& state) {
 
   switch(swi.data_type) {
     case DATA_ASCII:
+      p = wu+data_offset;
       for (i=0; i<nsamples; i++) {
-        p = fgets(buf, 256, f);
-        if (!p) {
+        if (p >= end) {
           SETIERROR(READ_FAILED,"in seti_parse_data");
         }
+        // one line at a time, at most 255 characters, like fgets()
+        n = std::min((size_t)(end-p), sizeof(buf)-1);
+        if ((eol = (const char *)memchr(p, '\n', n))) n = eol-p+1;
+        memcpy(buf, p, n);
+        buf[n] = 0;
+        p += n;
 
         sscanf(buf, "%f%f", &data[i][0], &data[i][1]);
       }
@@ -870,20 +887,40 @@ int seti_parse_data(FILE* f, ANALYSIS_STATE& state) {
     case DATA_ENCODED:
     case DATA_SUN_BINARY:
       try {
-        int nread;
-        std::string tmpbuf("");
-        fseek(f,0,SEEK_SET);
+        const char *start, *endt, *enc;
+        char encoding[64];
+        size_t ndecoded, nmax=nsamples*sizeof(sah_complex);
+
         nbytes = (nsamples/samples_per_byte);
-        tmpbuf.reserve(nbytes*3/2);
-        while ((nread=(int)fread(buf,1,sizeof(buf),f))) {
-          tmpbuf+=std::string(&(buf[0]),nread);
+        // The data section comes after the header, so look there first.
+        if (!(start=find_in_buf(wu+data_offset,end,"<data ")) &&
+            !(start=find_in_buf(wu,end,"<data "))) {
+          throw ERR_XML_PARSE;
+        }
+        if (!(endt=find_in_buf(start,end,"</data")) ||
+            !(enc=find_in_buf(start,end,"encoding=\"")) ||
+            !(p=(const char *)memchr(start,'>',endt-start))) {
+          throw ERR_XML_PARSE;
+        }
+        p++;
+        enc+=strlen("encoding=\"");
+        for (n=0; (n<sizeof(encoding)-1) && (enc+n<end) && (enc[n]!='"'); n++) {
+          encoding[n]=enc[n];
+        }
+        encoding[n]=0;
+
+        if ((xml_encoding_from_string(encoding) == _x_setiathome) &&
+            (x_setiathome_decoded_max(endt-p) <= nmax)) {
+          // decode straight out of the file
+          ndecoded=x_setiathome_decode_buf(p,endt-p,(unsigned char *)bin_data);
+        } else {
+          std::vector<unsigned char> datav(
+             xml_decode_string<unsigned char>(p,endt-p,encoding)
+          );
+          ndecoded=std::min(datav.size(),nmax);
+          if (ndecoded) memcpy(bin_data,&(datav[0]),ndecoded);
         }
-        std::vector<unsigned char> datav(
-           xml_decode_field<unsigned char>(tmpbuf,"data") 
-        );
-	
-        memcpy(bin_data,&(datav[0]),datav.size());
-        if (datav.size() < nbytes) throw BAD_DECODE;
+        if (ndecoded < nbytes) throw BAD_DECODE;
       } catch (int i) {
           retval=i;
           if (data) free_a(data);
@@ -914,11 +951,12 @@ int seti_parse_data(FILE* f, ANALYSIS_STATE& state) {
   return 0;
 }
 
-int seti_parse_wu(FILE* f, ANALYSIS_STATE& state) {
+int seti_parse_wu(const char *wu, size_t len, ANALYSIS_STATE& state) {
   int retval=0;
-  retval = seti_parse_wu_header(f);
+  size_t data_offset=0;
+  retval = seti_parse_wu_header(wu, len, data_offset);
   if (retval) SETIERROR(retval,"from seti_parse_wu_header()");
-  return seti_parse_data(f, state);
+  return seti_parse_data(wu, len, data_offset, state);
 }
 
 void final_report() {
@@ -161,6 +161,8 @@ struct ANALYSIS_STATE {
 
 extern bool notranspose_flag;
 extern bool default_functions_flag;
+extern bool chirp_blocks_flag;
+extern int baseline_threads;
 extern bool verbose;
 extern int seti_init_state();
 extern int seti_do_work();
@@ -168,7 +170,7 @@ extern int result_group_start();
 extern int result_group_write_header();
 extern int result_group_end();
 extern int checkpoint(BOOLEAN force_checkpoint=0);
-extern int seti_parse_wu(FILE*, ANALYSIS_STATE&);
+extern int seti_parse_wu(const char *wu, size_t len, ANALYSIS_STATE&);
 extern int parse_state_file(ANALYSIS_STATE& as);
 extern void final_report();
 
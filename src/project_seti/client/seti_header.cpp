@@ -37,6 +37,7 @@
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
+#include <ctype.h>
 #include <cstdlib>
 #include <vector>
 #include <string>
@@ -169,9 +170,20 @@ SETI_WU_INFO swi;
 
 static workunit *wu;
 
+static int parse_header_buffer(const std::string &buffer, SETI_WU_INFO &info) {
+  if (wu) delete wu;
+  wu=new workunit(buffer);
+  SETI_WU_INFO temp(*wu);
+  info=temp;
+
+  if (!info.data_type || !info.nsamples) {
+    SETIERROR(BAD_HEADER, "!swi.data_type || !swi.nsamples");
+  }
+  return 0;
+}
+
 int seti_parse_wu_header(FILE* f) {
   char buf[256];
-  int found=0;
  
   std::string buffer("");
   buffer.reserve(10*1024);
@@ -194,21 +206,11 @@ int seti_parse_wu_header(FILE* f) {
   }
   buffer+=buf;
 
-  if (wu) delete wu;
-  wu=new workunit(buffer);
-  SETI_WU_INFO temp(*wu);
-  swi=temp;
-  found=1;
-
-  if (!swi.data_type || !found || !swi.nsamples) {
-    SETIERROR(BAD_HEADER, "!swi.data_type || !found || !swi.nsamples");
-  }
-  return 0;
+  return parse_header_buffer(buffer, swi);
 }
 
 int seti_parse_wu_header(FILE* f, SETI_WU_INFO &swi) {
   char buf[256];
-  int found=0;
   
   std::string buffer("");
   buffer.reserve(10*1024);
@@ -230,16 +232,36 @@ int seti_parse_wu_header(FILE* f, SETI_WU_INFO &swi) {
   }
   buffer+=buf;
 
-  if (wu) delete wu;
-  wu=new workunit(buffer);
-  SETI_WU_INFO temp(*wu);
-  swi=temp;
-  found=1;
+  return parse_header_buffer(buffer, swi);
+}
+
+// Parses the header of a workunit that has been read or mapped into memory.
+// On return data_offset is the offset of the line after </workunit_header>,
+// where the data section starts.
+int seti_parse_wu_header(const char *buf, size_t len, size_t &data_offset) {
+  const char *end=buf+len, *start=buf, *stop;
+
+  swi.data_type=0;
 
-  if (!swi.data_type || !found || !swi.nsamples) {
-    SETIERROR(BAD_HEADER, "!swi.data_type || !found || !swi.nsamples");
+  while ((start=find_in_buf(start,end,"<workunit_header")) != NULL) {
+    stop=start+strlen("<workunit_header");
+    if ((stop==end) || (*stop=='>') || isspace((unsigned char)*stop)) break;
+    start=stop;
   }
-  return 0;
+  if (!start) {
+    SETIERROR(BAD_HEADER, "no <workunit_header>");
+  }
+  while ((start>buf) && (start[-1]!='\n')) start--;
+
+  if ((stop=find_in_buf(start,end,"</workunit_header")) != NULL) {
+    stop=(const char *)memchr(stop,'\n',end-stop);
+    stop=stop?(stop+1):end;
+  } else {
+    stop=end;
+  }
+  data_offset=stop-buf;
+
+  return parse_header_buffer(std::string(start,stop), swi);
 }
 
 float cnvt_fftlen_hz(int fft_len) {
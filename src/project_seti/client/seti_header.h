@@ -118,6 +118,7 @@ extern int seti_write_wu_header(FILE*, int);
 extern int seti_write_wu_header(FILE*, int, SETI_WU_INFO swi);
 extern int seti_parse_wu_header(FILE*);
 extern int seti_parse_wu_header(FILE*, SETI_WU_INFO &swi);
+extern int seti_parse_wu_header(const char *buf, size_t len, size_t &data_offset);
 
 extern float cnvt_fftlen_hz(int);
 extern double cnvt_bin_hz(int, int);
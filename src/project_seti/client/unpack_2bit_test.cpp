@@ -0,0 +1,172 @@
+// Checks unpack_2bit_samples() (s_util.h) against the unpacking code it
+// replaced, then times both.
+//
+// - bits_to_floats() must give exactly what the old client loop gave:
+//   big endian 16 bit words, the real part in the high bit of each pair.
+// - the splitter's parameters (native words, real part in the low bit) must
+//   give exactly what the old 65536 entry table of splitter_bits_to_float()
+//   gave.
+// Every 16 bit word is checked, so every byte value is seen at both
+// positions in the word.
+//
+// Usage: unpack_2bit_test [nsamples]
+//   nsamples  samples per timed call (1M by default)
+// Exits with 0 if the output was identical.
+
+#include "sah_config.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/time.h>
+
+#include "s_util.h"
+
+static double now() {
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + tv.tv_usec*1e-6;
+}
+
+// the client's bits_to_floats() before the shared table
+static void old_bits_to_floats(unsigned char* raw, sah_complex* data, int nsamples) {
+  int i, j, k=0;
+  unsigned char c;
+
+  for (i=0; i<nsamples/4; i++) {
+    j = (i&1) ? i-1 : i+1;
+    c = raw[j];
+    for (j=0; j<4; j++) {
+      data[k][0] = (float)((c&2)?1:-1);
+      data[k][1] = (float)((c&1)?1:-1);
+      k++;
+      c >>= 2;
+    }
+  }
+}
+
+// the splitter's splitter_bits_to_float() before the shared table
+static void old_splitter_bits_to_float(unsigned short *raw, float *data, int nsamples) {
+  unsigned int i, j;
+  unsigned short s;
+  static int first_time=1;
+  static float lut[65536][16];
+
+  if (first_time) {
+    for (i=0;i<65536;i++) {
+      s=(unsigned short)i;
+      for (j=0;j<8;j++) {
+        lut[i][j*2]=(float)2*(s & 1)-1;
+        s >>= 1;
+        lut[i][j*2+1]=(float)2*(s & 1)-1;
+        s >>= 1;
+      }
+    }
+    first_time--;
+  }
+
+  for (i=0;i<(unsigned int)(nsamples/8);i++) {
+    memcpy(data+16*i,lut[raw[i]],16*sizeof(float));
+  }
+}
+
+// what splitter_bits_to_float() does now
+static void new_splitter_bits_to_float(unsigned short *raw, float *data, int nsamples) {
+#ifdef WORDS_BIGENDIAN
+  unpack_2bit_samples((const unsigned char *)raw, data, nsamples/4, 0, 1);
+#else
+  unpack_2bit_samples((const unsigned char *)raw, data, nsamples/4, 0, 0);
+#endif
+}
+
+int main(int argc, char **argv) {
+  int nsamples=(argc>1)?atoi(argv[1]):1024*1024;
+  int i, rep, nreps=20, errors=0;
+  double t, told, tnew;
+
+  if (nsamples < 8) nsamples=8;
+  nsamples &= ~7;
+
+  // every 16 bit word, as big endian bytes for the client
+  // and native words for the splitter
+  int nwords=65536;
+  unsigned char *raw=(unsigned char *)malloc(2*nwords);
+  unsigned short *words=(unsigned short *)malloc(2*nwords);
+  float *ref=(float *)malloc(nwords*8*2*sizeof(float));
+  float *out=(float *)malloc(nwords*8*2*sizeof(float));
+  if (!raw || !words || !ref || !out) {
+    fprintf(stderr,"out of memory\n");
+    return 1;
+  }
+  for (i=0; i<nwords; i++) {
+    raw[2*i]=(unsigned char)(i>>8);
+    raw[2*i+1]=(unsigned char)i;
+    words[i]=(unsigned short)i;
+  }
+
+  old_bits_to_floats(raw, (sah_complex *)ref, nwords*8);
+  memset(out, 0, nwords*8*2*sizeof(float));
+  bits_to_floats(raw, (sah_complex *)out, nwords*8);
+  if (memcmp(ref, out, nwords*8*2*sizeof(float))) {
+    printf("FAILED  bits_to_floats() differs from the old loop\n");
+    errors++;
+  } else {
+    printf("ok      bits_to_floats() identical for all 65536 words\n");
+  }
+
+  old_splitter_bits_to_float(words, ref, nwords*8);
+  memset(out, 0, nwords*8*2*sizeof(float));
+  new_splitter_bits_to_float(words, out, nwords*8);
+  if (memcmp(ref, out, nwords*8*2*sizeof(float))) {
+    printf("FAILED  splitter unpacking differs from the old table\n");
+    errors++;
+  } else {
+    printf("ok      splitter unpacking identical for all 65536 words\n");
+  }
+  free(raw);
+  free(words);
+  free(ref);
+  free(out);
+
+  // timings, best of nreps calls on random data (warm cache)
+  raw=(unsigned char *)malloc(nsamples/4);
+  ref=(float *)malloc(nsamples*2*sizeof(float));
+  if (!raw || !ref) {
+    fprintf(stderr,"out of memory\n");
+    return 1;
+  }
+  srand(1);
+  for (i=0; i<nsamples/4; i++) raw[i]=(unsigned char)(rand()>>4);
+
+  told=tnew=1e30;
+  for (rep=0; rep<nreps; rep++) {
+    t=now();
+    old_bits_to_floats(raw, (sah_complex *)ref, nsamples);
+    t=now()-t;
+    if (t<told) told=t;
+    t=now();
+    bits_to_floats(raw, (sah_complex *)ref, nsamples);
+    t=now()-t;
+    if (t<tnew) tnew=t;
+  }
+  printf("client   bits_to_floats         %8.3f ms -> %8.3f ms per %d samples\n",
+    told*1e3, tnew*1e3, nsamples);
+
+  told=tnew=1e30;
+  for (rep=0; rep<nreps; rep++) {
+    t=now();
+    old_splitter_bits_to_float((unsigned short *)raw, ref, nsamples);
+    t=now()-t;
+    if (t<told) told=t;
+    t=now();
+    new_splitter_bits_to_float((unsigned short *)raw, ref, nsamples);
+    t=now()-t;
+    if (t<tnew) tnew=t;
+  }
+  printf("splitter splitter_bits_to_float %8.3f ms -> %8.3f ms per %d samples\n",
+    told*1e3, tnew*1e3, nsamples);
+  free(raw);
+  free(ref);
+
+  printf("%s\n", errors ? "FAILED" : "OK");
+  return errors ? 1 : 0;
+}
@@ -331,3 +331,104 @@ int fpu_opt_ChirpData (
     analysis_state.FLOP_counter+=12.0*ul_NumDataPoints;
     return ( 0 );
 }
+
+
+// fpu_block_ChirpData
+// Chirp for hosts without the memory for TrigStep/CurrentTrig.  The phase
+// (in turns) at sample i0+k is
+//
+//     srate*i0*i0 + 2*srate*i0*k + srate*k*k
+//
+// The k*k term is the same for every block, so it goes in a small table
+// that is rebuilt only when the chirp rate changes.  The first two terms are
+// a phasor advanced by a fixed step in float.  Both the phasor and its step
+// are re-anchored from a double sincos() at the start of each block, so the
+// float error only grows over CHIRP_BLOCK samples and never carries into the
+// next block.  That is two sincos() per block instead of one per sample,
+// with 1KB of state.
+//
+#define CHIRP_BLOCK 128
+
+inline void chirp_phasor(double ang, float &c, float &s) {
+    double dd,cc;
+    // reduce to one turn before scaling, as in v_ChirpData()
+    ang -= floor(ang);
+    ang *= M_PI*2;
+    sincos(ang,&dd,&cc);
+    c=(float)cc;
+    s=(float)dd;
+}
+
+static double block_srate=0;
+static float block_kc[CHIRP_BLOCK], block_ks[CHIRP_BLOCK];
+
+// Chirps ul_NumDataPoints samples starting at sample "first" of the
+// workunit.  cx_DataArray and cx_ChirpDataArray point at that sample.
+int fpu_block_ChirpSlice (
+  sah_complex * cx_DataArray,
+  sah_complex * cx_ChirpDataArray,
+  int ChirpRateInd,
+  double ChirpRate,
+  int first,
+  int  ul_NumDataPoints,
+  double sample_rate
+) {
+    if (ChirpRateInd == 0) {
+        memcpy(cx_ChirpDataArray, cx_DataArray, (int)ul_NumDataPoints * sizeof(sah_complex));
+        return 0;
+    }
+
+    double srate = ChirpRate * 0.5 / (sample_rate * sample_rate);
+    int i, k, n;
+
+    if (srate != block_srate) {
+        for (k = 0; k < CHIRP_BLOCK; k++) {
+            chirp_phasor(srate*(double)k*(double)k, block_kc[k], block_ks[k]);
+        }
+        block_srate = srate;
+    }
+
+    for (i = 0; i < ul_NumDataPoints; i += CHIRP_BLOCK) {
+        double di = (double)(first + i);
+        float pc, ps, sc, ss;
+
+        chirp_phasor(srate*di*di, pc, ps);
+        chirp_phasor(2.0*srate*di, sc, ss);
+
+        n = ul_NumDataPoints - i;
+        if (n > CHIRP_BLOCK) n = CHIRP_BLOCK;
+
+        for (k = 0; k < n; k++) {
+            float c, d, real, imag, t;
+
+            c = pc * block_kc[k] - ps * block_ks[k];
+            d = pc * block_ks[k] + ps * block_kc[k];
+
+            // Sometimes chirping is done in place.
+            // We don't want to overwrite data prematurely.
+            real = cx_DataArray[i + k][0] * c - cx_DataArray[i + k][1] * d;
+            imag = cx_DataArray[i + k][0] * d + cx_DataArray[i + k][1] * c;
+            cx_ChirpDataArray[i + k][0] = real;
+            cx_ChirpDataArray[i + k][1] = imag;
+
+            t  = pc * sc - ps * ss;
+            ps = pc * ss + ps * sc;
+            pc = t;
+        }
+    }
+
+    analysis_state.FLOP_counter+=12.0*ul_NumDataPoints;
+    return 0;
+}
+
+int fpu_block_ChirpData (
+  sah_complex * cx_DataArray,
+  sah_complex * cx_ChirpDataArray,
+  int ChirpRateInd,
+  double ChirpRate,
+  int  ul_NumDataPoints,
+  double sample_rate
+) {
+    return fpu_block_ChirpSlice(cx_DataArray, cx_ChirpDataArray, ChirpRateInd,
+                                ChirpRate, 0, ul_NumDataPoints, sample_rate);
+}
@@ -64,6 +64,9 @@
 #include "util.h"
 #include "s_util.h"
 #include "boinc_api.h"
+#include "filesys.h"
+#include "parse.h"
+#include "sah_version.h"
 #ifdef BOINC_APP_GRAPHICS
 #include "sah_gfx_main.h"
 #endif
@@ -260,6 +263,7 @@ struct BLStb {
 
 BLStb BaseLineSmoothFuncs[]={
       v_BaseLineSmooth, BA_ANY, "v_BaseLineSmooth",
+      v_BaseLineSmoothInPlace, BA_ANY, "v_BaseLineSmoothInPlace",
 };
 
 struct GPStb {
@@ -299,6 +303,7 @@ CDtb ChirpDataFuncs[]={
     v_ChirpData, BA_ANY, "v_ChirpData",
     fpu_ChirpData, BA_ANY, "fpu_ChirpData",
     fpu_opt_ChirpData, BA_ANY, "fpu_opt_ChirpData",
+    fpu_block_ChirpData, BA_ANY, "fpu_block_ChirpData",
 #ifdef USE_ALTIVEC
     v_vChirpData, BA_ALTVC, "v_vChirpData",  
     v_vChirpDataG4, BA_ALTVC, "v_vChirpDataG4",
@@ -673,10 +678,12 @@ ChirpData_func ChooseChirpData() {
     hires_timer timer;
     ChirpData_func chirp_data;
     int i,j,rv,k = sizeof(ChirpDataFuncs)/sizeof(CDtb);
-    double speed=1e+6,timing,accuracy;
+    double speed=1e+6,timing,accuracy,errmax;
     int NumDataPoints=1024*1024;
-    int best;
-    double best_timing, best_accuracy;
+    // Fall back to v_ChirpData if no method passes the accuracy checks
+    int best=0;
+    double best_timing=0, best_accuracy=0;
+    chirp_data=ChirpDataFuncs[0].func;
     FORCE_FRAME_POINTER;
 
     if (k == 1) {
@@ -762,6 +769,7 @@ ChirpData_func ChooseChirpData() {
             if (rv) continue;
             timing/=j;
             accuracy=0;
+            errmax=0;
             //JWS: indata is positive chirp of constant at TESTCHIRPIND, test was copied
             // at -TESTCHIRPIND so we check for deviation from flat
             for (j=0;j<NumDataPoints-1;j++) {
@@ -769,12 +777,19 @@ ChirpData_func ChooseChirpData() {
                 accuracy+=(test[j+1][1]-test[j][1])*(test[j+1][1]-test[j][1]);
             }
             accuracy=sqrt(accuracy)/1000; // milli whatevers
+            // indata came from the double sincos() reference, so the dechirped
+            // result should be (1,0) everywhere. Catches methods that drift
+            // slowly enough to still look flat sample to sample.
+            for (j=0;j<NumDataPoints;j++) {
+                errmax=std::max(errmax,(double)fabs(test[j][0]-1.0f));
+                errmax=std::max(errmax,(double)fabs(test[j][1]));
+            }
             //if (verbose) fprintf(stderr,"%32s %8.6f %7g  test\n",ChirpDataFuncs[i].nom,timing,accuracy);
             if (verbose) {
                 fprintf(stderr,"%32s %8.6f %7.5f  test\n",ChirpDataFuncs[i].nom,timing,accuracy);
                 fflush(stderr);
             }
-            if ((timing<speed) && isnotnan(accuracy) && (accuracy<5e-3)) {
+            if ((timing<speed) && isnotnan(accuracy) && (accuracy<5e-3) && (errmax<1e-3)) {
                 speed=timing;
                 best=i;
                 best_timing=timing;
@@ -1280,6 +1295,318 @@ int ChooseFoldSubs(ChirpFftPair_t * ChirpFftPairs, int num_cfft, int nsamples) {
 
 
 
+/**********************
+ *
+ * Cache of the ChooseFunctions() choices, so restarts don't have to time
+ * every routine again.  The file is kept in the project directory and is
+ * only trusted when its key (CPU capabilities, application version, chirp
+ * table mode, baseline smoothing threads and the shape of the workunit)
+ * matches, and the cached routines still pass a quick check against the
+ * defaults.
+ */
+#define FUNCTIONS_CACHE "sah_functions.xml"
+
+static void functions_cache_path(char *path) {
+    if (app_init_data.project_dir[0]) {
+        sprintf(path, "%s/%s", app_init_data.project_dir, FUNCTIONS_CACHE);
+    } else {
+        strcpy(path, FUNCTIONS_CACHE);
+    }
+}
+
+static void functions_cache_key(char *key, int num_cfft, int nsamples) {
+    bool CacheChirpCalc=((app_init_data.host_info.m_nbytes == 0)  ||
+                             (app_init_data.host_info.m_nbytes >= (double)(64*1024*1024)));
+    sprintf(key, "%x %d.%02d %d %d %lx %d %d %d",
+            (unsigned)CPUCaps,
+            gmajor_version, gminor_version,
+            app_init_data.app_version,
+            nsamples,
+            (unsigned long)swi.analysis_cfg.analysis_fft_lengths,
+            num_cfft,
+            CacheChirpCalc ? 1 : 0,
+            baseline_threads);
+}
+
+// index of the routine called nom, or -1 if unknown or not supported here
+template <typename T, int N>
+static int find_choice(T (&tab)[N], const char *nom) {
+    for (int i=0;i<N;i++) {
+        if (!strcmp(tab[i].nom,nom)) return (CPUCaps & tab[i].ba) ? i : -1;
+    }
+    return -1;
+}
+
+template <typename T, int N, typename F>
+static const char *choice_name(T (&tab)[N], F func) {
+    for (int i=0;i<N;i++) {
+        if (tab[i].func == func) return tab[i].nom;
+    }
+    return NULL;
+}
+
+// Runs each cached routine once on small data and compares with the
+// default routine, using the tolerances of the Choose*() functions.
+static bool CachedChoicesSane(BaseLineSmooth_func baseline_smooth,
+                              GetPowerSpectrum_func get_power_spectrum,
+                              ChirpData_func chirp_data,
+                              Transpose_func transpose) {
+    bool CacheChirpCalc=((app_init_data.host_info.m_nbytes == 0)  ||
+                             (app_init_data.host_info.m_nbytes >= (double)(64*1024*1024)));
+    volatile bool ok=false;
+    int i, NumDataPoints=32*1024;
+    double err;
+    sah_complex *cin=(sah_complex *)malloc_a(NumDataPoints*sizeof(sah_complex),MEM_ALIGN);
+    sah_complex *cout=(sah_complex *)malloc_a(NumDataPoints*sizeof(sah_complex),MEM_ALIGN);
+    sah_complex *cref=(sah_complex *)malloc_a(NumDataPoints*sizeof(sah_complex),MEM_ALIGN);
+    float *fout=(float *)malloc_a(NumDataPoints*sizeof(float),MEM_ALIGN);
+    float *fref=(float *)malloc_a(NumDataPoints*sizeof(float),MEM_ALIGN);
+
+    FORCE_FRAME_POINTER;
+    if (cin && cout && cref && fout && fref) {
+        for (i=0;i<NumDataPoints;i++) {
+            cin[i][0]=((rand()&RAND_MAX)>(RAND_MAX/2))?-1.0f:1.0f;
+            cin[i][1]=((rand()&RAND_MAX)>(RAND_MAX/2))?-1.0f:1.0f;
+        }
+#if !defined(USE_ASMLIB) && !defined(__APPLE_CC__)
+        install_sighandler();
+        if (!sigsetjmp(jb,1)) {
+#endif
+            do {
+                memcpy(cref,cin,NumDataPoints*sizeof(sah_complex));
+                memcpy(cout,cin,NumDataPoints*sizeof(sah_complex));
+                if (BaseLineSmoothFuncs[0].func(cref,NumDataPoints,8192,32768) ||
+                    baseline_smooth(cout,NumDataPoints,8192,32768)) break;
+                for (err=0,i=0;i<NumDataPoints;i++) {
+                    err+=pow(cref[i][0]-cout[i][0],2);
+                    err+=pow(cref[i][1]-cout[i][1],2);
+                }
+                if (!isnotnan(err) || (err>=1e-5)) break;
+
+                if (GetPowerSpectrumFuncs[0].func(cin,fref,NumDataPoints) ||
+                    get_power_spectrum(cin,fout,NumDataPoints)) break;
+                for (err=0,i=0;i<NumDataPoints;i++) err+=pow(fref[i]-fout[i],2);
+                if (!isnotnan(err) || (sqrt(err)>=1e-5)) break;
+
+                if (TransposeFuncs[0].func(512,64,fref,(float *)cref) ||
+                    transpose(512,64,fref,(float *)cout)) break;
+                for (err=0,i=0;i<NumDataPoints;i++) {
+                    err+=pow(((float *)cref)[i]-((float *)cout)[i],2);
+                }
+                if (!isnotnan(err) || (sqrt(err)>=1e-6)) break;
+
+                // As in ChooseChirpData(), dechirping the reference chirp
+                // at TESTCHIRPIND should leave (1,0).
+                for (i=0;i<NumDataPoints;i++) {
+                    double dd,cc,time,ang,recip_sample_rate=256.0/2.5e+6,chirp_rate=MinChirpStep*TESTCHIRPIND;
+                    time=static_cast<double>(i)*recip_sample_rate;
+                    ang=0.5*chirp_rate*time*time;
+                    ang -= floor(ang);
+                    ang *= M_PI*2;
+                    sincos(ang,&dd,&cc);
+                    cin[i][0] = static_cast<float>(cc);
+                    cin[i][1] = static_cast<float>(dd);
+                }
+                if (CacheChirpCalc) {
+                    FreeTrigArray();
+                    InitTrigArray(NumDataPoints, MinChirpStep,TESTCHIRPIND,2.5e+6/256.0);
+                }
+                if (chirp_data(cin,cout,-TESTCHIRPIND,-MinChirpStep*TESTCHIRPIND,NumDataPoints,2.5e+6/256.0)) break;
+                for (err=0,i=0;i<NumDataPoints;i++) {
+                    err=std::max(err,(double)fabs(cout[i][0]-1.0f));
+                    err=std::max(err,(double)fabs(cout[i][1]));
+                }
+                if (!isnotnan(err) || (err>=1e-3)) break;
+
+                ok=true;
+            } while (0);
+#if !defined(USE_ASMLIB) && !defined(__APPLE_CC__)
+        } else {
+            if (verbose) {
+                fprintf(stderr,"cached function faulted\n");
+                fflush(stderr);
+            }
+        }
+        uninstall_sighandler();
+#endif
+    }
+    if (cin) free_a(cin);
+    if (cout) free_a(cout);
+    if (cref) free_a(cref);
+    if (fout) free_a(fout);
+    if (fref) free_a(fref);
+    return ok;
+}
+
+// Same for the cached folding set: one FFT length at the longest pulse
+// PoT, a few periods of each fold, compared with FoldSubs[0] using the
+// tolerances of ChooseFoldSubs().
+static bool CachedFoldSetSane(int ifs) {
+    int i, iL, j, k, ndivs, NumPlans, MaxPulsePoT = PoTInfo.PulseMax;
+    int FFTtbl[32][5] = {0, 0, 0, 0, 0};
+    double accuracy = 0, errmax = 0;
+    volatile bool ok = false;
+    float *SrcSel[2];
+
+    if ((ifs == 0) || (MaxPulsePoT < 32)) return true;
+    iL = 4;
+    FFTtbl[iL][0] = 8;
+    FFTtbl[iL][1] = FFTtbl[iL][2] = FFTtbl[iL][3] = 8;
+    FFTtbl[iL][4] = MaxPulsePoT;
+    for (i = 32, ndivs = 1; i <= MaxPulsePoT; ndivs++, i *= 2);
+    NumPlans = 3 * FFTtbl[iL][2] * ndivs;
+
+    PoTPlan *PlanBuf = (PoTPlan *)malloc_a((NumPlans + 1) * sizeof(PoTPlan), MEM_ALIGN);
+    float *indata = (float *)malloc_a(MaxPulsePoT * sizeof(float), MEM_ALIGN);
+    float *outdata = (float *)malloc_a(MaxPulsePoT * sizeof(float), MEM_ALIGN);
+    float *maxdata = (float *)malloc_a(NumPlans * sizeof(float), MEM_ALIGN);
+    float *save = (float *)malloc_a(NumPlans * sizeof(float), MEM_ALIGN);
+
+    FORCE_FRAME_POINTER;
+    if (PlanBuf && indata && outdata && maxdata && save) {
+        SrcSel[0] = indata;
+        SrcSel[1] = outdata;
+        srand(11);
+        for (i = 0; i < MaxPulsePoT; i++) {
+            float fr1 = (float)(rand()) / RAND_MAX;
+            float fr2 = (float)(rand()) / RAND_MAX;
+            indata[i] = fr1 * fr1 + fr2 * fr2;
+        }
+#if !defined(USE_ASMLIB) && !defined(__APPLE_CC__)
+        install_sighandler();
+        if (!sigsetjmp(jb,1)) {
+#endif
+            do {
+                for (j = 0; j < 2; j++) {
+                    CopyFoldSet(&TestFoldSet, FoldSubs[j ? ifs : 0].fsp);
+                    planFoldTest(PlanBuf, outdata, FFTtbl);
+                    memset(outdata, 0, MaxPulsePoT * sizeof(float));
+                    memset(maxdata, 0, NumPlans * sizeof(float));
+                    maxdata[0] = -1.234f;
+                    for (k = 0; PlanBuf[k].di; k++) {
+                        maxdata[k] = PlanBuf[k].fun_ptr(SrcSel, &PlanBuf[k]);
+                    }
+                    if (maxdata[0] < 0) break;
+                    if (!j) memcpy(save, maxdata, NumPlans * sizeof(float));
+                }
+                if (j < 2) break;
+                for (j = 0; j < NumPlans; j++) {
+                    if (save[j]) {
+                        double relerr = fabs((save[j] - maxdata[j]) / save[j]);
+                        accuracy += relerr;
+                        if (relerr > errmax) errmax = relerr;
+                    }
+                }
+                accuracy /= NumPlans;
+                ok = isnotnan(accuracy) && (accuracy < 1e-6) && (errmax < 1e-4);
+            } while (0);
+#if !defined(USE_ASMLIB) && !defined(__APPLE_CC__)
+        } else {
+            if (verbose) {
+                fprintf(stderr,"cached folding faulted\n");
+                fflush(stderr);
+            }
+        }
+        uninstall_sighandler();
+#endif
+    }
+    if (PlanBuf) free_a(PlanBuf);
+    if (indata) free_a(indata);
+    if (outdata) free_a(outdata);
+    if (maxdata) free_a(maxdata);
+    if (save) free_a(save);
+    return ok;
+}
+
+static bool ReadCachedChoices(const char *key,
+                              BaseLineSmooth_func *baseline_smooth,
+                              GetPowerSpectrum_func *get_power_spectrum,
+                              ChirpData_func *chirp_data,
+                              Transpose_func *transpose) {
+    char path[512], buf[4096], nom[256];
+    int ibls, igps, icd, itp, ifs=-1;
+    size_t n;
+    FILE *f;
+
+    functions_cache_path(path);
+    if (!(f=boinc_fopen(path,"r"))) return false;
+    n=fread(buf,1,sizeof(buf)-1,f);
+    fclose(f);
+    buf[n]=0;
+
+    if (!parse_str(buf,"<key>",nom,sizeof(nom)) || strcmp(nom,key)) return false;
+    if (!parse_str(buf,"<baseline_smooth>",nom,sizeof(nom)) ||
+        ((ibls=find_choice(BaseLineSmoothFuncs,nom)) < 0)) return false;
+    if (!parse_str(buf,"<power_spectrum>",nom,sizeof(nom)) ||
+        ((igps=find_choice(GetPowerSpectrumFuncs,nom)) < 0)) return false;
+    if (!parse_str(buf,"<chirp_data>",nom,sizeof(nom)) ||
+        ((icd=find_choice(ChirpDataFuncs,nom)) < 0)) return false;
+    if (!parse_str(buf,"<transpose>",nom,sizeof(nom)) ||
+        ((itp=find_choice(TransposeFuncs,nom)) < 0)) return false;
+    if (!parse_str(buf,"<fold_set>",nom,sizeof(nom))) return false;
+    for (int i=0;(i*sizeof(FolSub))<sizeof(FoldSubs);i++) {
+        if (!strcmp(FoldSubs[i].fsp->name,nom) && (CPUCaps & FoldSubs[i].ba)) ifs=i;
+    }
+    // No pulse finding leaves Foldmain as it was.
+    if ((ifs < 0) && strcmp(Foldmain.name,nom)) return false;
+
+    if (!CachedChoicesSane(BaseLineSmoothFuncs[ibls].func,
+                           GetPowerSpectrumFuncs[igps].func,
+                           ChirpDataFuncs[icd].func,
+                           TransposeFuncs[itp].func)) return false;
+    if ((ifs >= 0) && !CachedFoldSetSane(ifs)) return false;
+
+    *baseline_smooth=BaseLineSmoothFuncs[ibls].func;
+    *get_power_spectrum=GetPowerSpectrumFuncs[igps].func;
+    *chirp_data=ChirpDataFuncs[icd].func;
+    *transpose=TransposeFuncs[itp].func;
+    if (ifs >= 0) CopyFoldSet(&Foldmain, FoldSubs[ifs].fsp);
+    if (do_print) {
+        fprintf(stderr,"%32s (cached)\n",BaseLineSmoothFuncs[ibls].nom);
+        fprintf(stderr,"%32s (cached)\n",GetPowerSpectrumFuncs[igps].nom);
+        fprintf(stderr,"%32s (cached)\n",ChirpDataFuncs[icd].nom);
+        fprintf(stderr,"%32s (cached)\n",TransposeFuncs[itp].nom);
+        fprintf(stderr,"%24s folding (cached)\n",Foldmain.name);
+    }
+    return true;
+}
+
+static void WriteCachedChoices(const char *key,
+                               BaseLineSmooth_func baseline_smooth,
+                               GetPowerSpectrum_func get_power_spectrum,
+                               ChirpData_func chirp_data,
+                               Transpose_func transpose) {
+    char path[512], tmp[512];
+    const char *bls=choice_name(BaseLineSmoothFuncs,baseline_smooth);
+    const char *gps=choice_name(GetPowerSpectrumFuncs,get_power_spectrum);
+    const char *cd=choice_name(ChirpDataFuncs,chirp_data);
+    const char *tp=choice_name(TransposeFuncs,transpose);
+    FILE *f;
+
+    if (!bls || !gps || !cd || !tp) return;
+    functions_cache_path(path);
+    // Other tasks may be reading it, so write a copy and rename.
+    sprintf(tmp, "%s.%d", path, app_init_data.slot);
+    if (!(f=boinc_fopen(tmp,"w"))) return;
+    fprintf(f,
+        "<sah_functions>\n"
+        "    <key>%s</key>\n"
+        "    <baseline_smooth>%s</baseline_smooth>\n"
+        "    <power_spectrum>%s</power_spectrum>\n"
+        "    <chirp_data>%s</chirp_data>\n"
+        "    <transpose>%s</transpose>\n"
+        "    <fold_set>%s</fold_set>\n"
+        "</sah_functions>\n",
+        key, bls, gps, cd, tp, Foldmain.name
+    );
+    if (fclose(f) == 0) {
+        boinc_rename(tmp, path);
+    } else {
+        boinc_delete_file(tmp);
+    }
+}
+
+
 void ChooseFunctions(BaseLineSmooth_func *baseline_smooth,
                      GetPowerSpectrum_func *get_power_spectrum,
                      ChirpData_func *chirp_data,
@@ -1301,16 +1628,27 @@ void ChooseFunctions(BaseLineSmooth_func *baseline_smooth,
         SetCapabilities();
         hires_timer durtimer;
         double TestDur=0;
+        char key[256];
         durtimer.start();
-        *baseline_smooth=ChooseBaseLineSmooth();
-        fflush(stderr);
-        *get_power_spectrum=ChooseGetPowerSpectrum();
-        fflush(stderr);
-        *chirp_data=ChooseChirpData();
-        fflush(stderr);
-        *transpose=ChooseTranspose();
-        fflush(stderr);
-        ChooseFoldSubs(ChirpFftPairs, num_cfft, nsamples);
+        functions_cache_key(key, num_cfft, nsamples);
+        if (default_functions_flag ||
+            !ReadCachedChoices(key, baseline_smooth, get_power_spectrum,
+                               chirp_data, transpose)) {
+            *baseline_smooth=ChooseBaseLineSmooth();
+            fflush(stderr);
+            *get_power_spectrum=ChooseGetPowerSpectrum();
+            fflush(stderr);
+            *chirp_data=ChooseChirpData();
+            fflush(stderr);
+            *transpose=ChooseTranspose();
+            fflush(stderr);
+            ChooseFoldSubs(ChirpFftPairs, num_cfft, nsamples);
+            fflush(stderr);
+            if (!default_functions_flag) {
+                WriteCachedChoices(key, *baseline_smooth, *get_power_spectrum,
+                                   *chirp_data, *transpose);
+            }
+        }
         fflush(stderr);
         TestDur+=durtimer.stop();
         if (verbose)
@@ -109,6 +109,23 @@ extern int fpu_opt_ChirpData (
   int  ul_NumDataPoints,
   double sample_rate
 );
+extern int fpu_block_ChirpData (
+  sah_complex * cx_DataArray,
+  sah_complex * cx_ChirpDataArray,
+  int ChirpRateInd,
+  double ChirpRate,
+  int  ul_NumDataPoints,
+  double sample_rate
+);
+extern int fpu_block_ChirpSlice (
+  sah_complex * cx_DataArray,
+  sah_complex * cx_ChirpDataArray,
+  int ChirpRateInd,
+  double ChirpRate,
+  int first,
+  int  ul_NumDataPoints,
+  double sample_rate
+);
 #if defined(__i386__) || defined(__x86_64__) || defined(USE_SSE)
 extern int v_vChirpData_x86_64(
     sah_complex * cx_DataArray,
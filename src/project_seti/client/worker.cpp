@@ -38,6 +38,11 @@
 #include <unistd.h>
 #endif
 #include <errno.h>
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
 #ifndef _WIN32
 #include <dlfcn.h>
 #endif
@@ -96,22 +101,88 @@ static int initialize_for_wu() {
   return retval;
 }
 
+// The workunit is read in one go: mapped where mmap() is available, so
+// that tasks reading the same file share its pages, and read into memory
+// otherwise.
+struct WU_FILE_MAP {
+    const char *data;
+    size_t len;
+    bool mapped;
+};
+
+static bool map_wu_file(const char *path, WU_FILE_MAP &wu) {
+    FILE* f;
+    char *buf;
+    long len;
+
+    wu.data = 0;
+    wu.len = 0;
+    wu.mapped = false;
+#ifdef HAVE_SYS_MMAN_H
+    struct stat sbuf;
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        if (!fstat(fd, &sbuf) && (sbuf.st_size > 0)) {
+            void *p = mmap(0, sbuf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+                madvise(p, sbuf.st_size, MADV_SEQUENTIAL);
+#endif
+                wu.data = (const char *)p;
+                wu.len = sbuf.st_size;
+                wu.mapped = true;
+            }
+        }
+        close(fd);
+        if (wu.mapped) return true;
+    }
+#endif
+    f = boinc_fopen(path, "rb");
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if ((len < 0) || !(buf = (char *)malloc(len+1))) {
+        fclose(f);
+        return false;
+    }
+    wu.len = fread(buf, 1, len, f);
+    wu.data = buf;
+    fclose(f);
+    return true;
+}
+
+static void unmap_wu_file(WU_FILE_MAP &wu) {
+#ifdef HAVE_SYS_MMAN_H
+    if (wu.mapped) {
+        munmap((void *)wu.data, wu.len);
+    } else
+#endif
+    free((void *)wu.data);
+    wu.data = 0;
+    wu.len = 0;
+}
+
 // parse input and state files
 //
 static int read_wu_state() {
-    FILE* f;
+    WU_FILE_MAP wu;
     int retval=0;
     string path;
     FORCE_FRAME_POINTER;
 
     boinc_resolve_filename_s(WU_FILENAME, path);
-    f = boinc_fopen(path.c_str(), "rb");
-    if (f) {
+    if (map_wu_file(path.c_str(), wu)) {
 #ifdef BOINC_APP_GRAPHICS
     if (sah_graphics)  sprintf(sah_graphics->status, "Scanning data file\n");
 #endif
-        retval = seti_parse_wu(f, analysis_state);
-        fclose(f);
+        try {
+            retval = seti_parse_wu(wu.data, wu.len, analysis_state);
+        } catch (...) {
+            unmap_wu_file(wu);
+            throw;
+        }
+        unmap_wu_file(wu);
         if (retval) SETIERROR(retval,"from seti_parse_wu() in read_wu_state()");
     } else {
 	char msg[1024];
@@ -0,0 +1,219 @@
+// Checks operator>>(istream&, db_table<T>&) in db_table.h, which the
+// insert_* tools use to read XML dumps, then times it against the
+// token based reader it replaced.
+//
+// A dump of splitter_config records is written with print_xml(), with
+// comments, a similarly named tag and blank lines between the records.
+// - every record read back must print exactly as the one written.
+// - two streams read alternately must both give all their records (the
+//   old reader kept the rest of the last line in a static string).
+// - a final record with no newline after it must not be dropped.
+// The timings read the whole dump with the old and the new operator>>.
+// Both call the current parse_xml(), so they compare only the splitting
+// of the stream into records.
+//
+// Not built by default.  Build it from this directory with something like
+//   g++ -O2 -DCLIENT -I. -I.. -I../client -I<boinc>/lib db_stream_test.cpp \
+//       schema_master.cpp xml_util.cpp sqlrow.cpp sqlblob.cpp sqlint8.cpp \
+//       <boinc>/lib/libboinc.a -o db_stream_test
+//
+// Usage: db_stream_test [records]
+//   records  records in the timed dump (200000 by default)
+// Run it in an empty directory: it writes db_stream_test.xml there.
+// Exits with 0 if every record read back correctly.
+
+#include "sah_config.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <sys/time.h>
+
+#include "db_table.h"
+#include "schema_master.h"
+#include "xml_util.h"
+
+static double now() {
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + tv.tv_usec*1e-6;
+}
+
+// operator>> from db_table.h before it read the stream buffer directly
+template <typename T>
+std::istream &old_read(std::istream &i, T &a) {
+  std::string s;
+  static std::string remainder("");
+  std::string s_tag("<");
+  std::string e_tag("</");
+  s_tag+=a.search_tag();
+  e_tag+=a.search_tag();
+  std::string buffer = "";
+  buffer.reserve(65536);
+  bool found=false, done=false, first_time = true;
+  while (!i.eof()  && !done) {
+    if(first_time) {
+	s = remainder;
+	first_time = false;
+    } else
+        i >> s;
+    if (!found && xml_match_tag(s,s_tag.c_str())) {
+      found=true;
+      a.clear();
+    }
+    if (found) buffer+=(s+' ');
+    if (found && xml_match_tag(s,e_tag.c_str())) {
+      found=false;
+      done=true;
+    }
+  }
+  a.parse_xml(buffer);
+  std::string::size_type p=buffer.find(e_tag);
+  if (p != std::string::npos) {
+    p=buffer.find('>',p+1);
+    if (p != std::string::npos) {
+      remainder=buffer.substr(p,buffer.size()-p);
+    } else {
+      remainder=std::string("");
+    }
+  }
+  return i;
+}
+
+static void make_config(splitter_config &cfg, int n) {
+  static const char *windows[]={"hanning","welch","none"};
+  cfg.id=n+1;
+  cfg.version=6.0+(n%100)*0.01;
+  sprintf(cfg.data_type,"encoded");
+  cfg.fft_len=8<<(n%8);
+  cfg.ifft_len=8<<((n+3)%8);
+  sprintf(cfg.filter,"fftw_%d",n%5);
+  strcpy(cfg.window,windows[n%3]);
+  cfg.samples_per_wu=1048576+(n%17)*1024;
+  cfg.highpass=(n%7)*0.125;
+  // not empty: the generated parse_xml() has always read an empty string
+  // column as the text up to the end of the record
+  strcpy(cfg.blanker_filter,(n%4)?"randomize":"none");
+}
+
+// writes n records, and keeps what each one prints as
+static void write_dump(std::ostream &o, int n, std::vector<std::string> &printed) {
+  splitter_config cfg;
+  printed.clear();
+  for (int j=0; j<n; j++) {
+    make_config(cfg,j);
+    printed.push_back(cfg.print_xml());
+    if (j%10 == 0) o << "<!-- config " << j << " -->\n";
+    if (j%25 == 0) o << "<splitter_configs>\n\n";
+    o << printed.back() << '\n';
+  }
+}
+
+// reads records until the end, returns the number that differ from printed
+static int check_stream(std::istream &in, const std::vector<std::string> &printed,
+    const char *what) {
+  splitter_config cfg;
+  size_t n=0;
+  int bad=0;
+  cfg.search_tag();
+  while (in >> cfg) {
+    if (n >= printed.size() || cfg.print_xml() != printed[n]) bad++;
+    n++;
+  }
+  if (n != printed.size()) bad++;
+  printf("%s  %-32s %lu of %lu records\n", bad?"FAILED ":"ok     ", what,
+    (unsigned long)n, (unsigned long)printed.size());
+  return bad;
+}
+
+int main(int argc, char **argv) {
+  int nrec=(argc>1)?atoi(argv[1]):200000;
+  const char *fname="db_stream_test.xml";
+  std::vector<std::string> printed, printed2;
+  int errors=0;
+
+  {
+    std::ostringstream o;
+    write_dump(o,1000,printed);
+    std::istringstream in(o.str());
+    errors+=check_stream(in,printed,"dump of 1000 records");
+  }
+
+  {
+    // no newline after the last record
+    std::ostringstream o;
+    write_dump(o,3,printed);
+    std::string s=o.str();
+    s.resize(s.size()-1);
+    std::istringstream in(s);
+    errors+=check_stream(in,printed,"last record without newline");
+  }
+
+  {
+    // two streams, one record from each in turn
+    std::ostringstream o1, o2;
+    write_dump(o1,100,printed);
+    write_dump(o2,150,printed2);
+    std::istringstream in1(o1.str()), in2(o2.str());
+    splitter_config cfg;
+    size_t n1=0, n2=0;
+    int bad=0;
+    bool more1=true, more2=true;
+    cfg.search_tag();
+    while (more1 || more2) {
+      if (more1 && (more1=(in1 >> cfg))) {
+        if (n1 >= printed.size() || cfg.print_xml() != printed[n1]) bad++;
+        n1++;
+      }
+      if (more2 && (more2=(in2 >> cfg))) {
+        if (n2 >= printed2.size() || cfg.print_xml() != printed2[n2]) bad++;
+        n2++;
+      }
+    }
+    if (n1 != printed.size() || n2 != printed2.size()) bad++;
+    printf("%s  %-32s %lu+%lu of %lu+%lu records\n", bad?"FAILED ":"ok     ",
+      "two streams in turn", (unsigned long)n1, (unsigned long)n2,
+      (unsigned long)printed.size(), (unsigned long)printed2.size());
+    errors+=bad;
+  }
+
+  {
+    std::ofstream o(fname);
+    write_dump(o,nrec,printed);
+    if (!o.good()) {
+      perror(fname);
+      return 1;
+    }
+  }
+
+  splitter_config cfg;
+  double t, t_old, t_new, mb;
+  long n_old=0, n_new=0;
+  cfg.search_tag();
+
+  std::ifstream f_old(fname);
+  t=now();
+  while (!f_old.eof()) {
+    old_read(f_old,cfg);
+    if (!f_old.eof()) n_old++;
+  }
+  t_old=now()-t;
+
+  std::ifstream f_new(fname);
+  t=now();
+  while (f_new >> cfg) n_new++;
+  t_new=now()-t;
+
+  std::ifstream f_size(fname, std::ios::in | std::ios::ate);
+  mb=f_size.tellg()/1e6;
+  printf("old operator>>  %ld records %6.2f s %8.1f MB/s\n",n_old,t_old,mb/t_old);
+  printf("new operator>>  %ld records %6.2f s %8.1f MB/s\n",n_new,t_new,mb/t_new);
+  if (n_new != nrec) errors++;
+
+  printf("%s\n", errors ? "FAILED" : "OK");
+  return errors ? 1 : 0;
+}
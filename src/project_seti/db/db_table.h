@@ -21,6 +21,7 @@
 #include "sah_config.h"
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <string>
 #include <algorithm>
 #include "track_mem.h"
@@ -34,6 +35,8 @@
 
 #include "row_cache.h"
 
+class xml_writer;
+
 template <typename T>
 class db_type : public track_mem<T> {
   private:
@@ -76,44 +79,71 @@ std::ostream &operator <<(std::ostream &o, const db_table<T> &a) {
   return o;
 }
 
+// The characters that may follow a tag name (the same as isxmldelim()).
+inline bool db_xml_delim(int c) {
+  return ((c==' ') || (c=='\n') || (c=='\r') || (c==',') ||
+          (c=='<') || (c=='>') || (c==0) || (c==EOF));
+}
+
+// Reads the next <search_tag>...</search_tag> record from the stream and
+// parses it.  Characters are taken straight from the stream buffer, and
+// nothing past the closing '>' is consumed, so no state is carried between
+// calls and records can be read from several streams at once.  If there
+// are no more records eofbit and failbit are set and a is left alone.
 template <typename T>
 std::istream &operator >>(std::istream &i, db_table<T> &a) {
-  std::string s;
-  static std::string remainder("");
-  std::string s_tag("<");
-  std::string e_tag("</");
-  s_tag+=a._search_tag;
-  e_tag+=a._search_tag;
-  // std::string buffer(remainder);
-  std::string buffer = "";
-  buffer.reserve(65536);
-  bool found=false, done=false, first_time = true;
-  while (!i.eof()  && !done) {
-    if(first_time) {
-	s = remainder;
-	first_time = false;
-    } else
-        i >> s; 
-    if (!found && xml_match_tag(s,s_tag.c_str())) {
-      found=true;
-      a.clear();
+  std::streambuf *sb=i.rdbuf();
+  const char *tag=a._search_tag;
+  const size_t taglen=strlen(tag);
+  std::string buffer;
+  size_t lt=0, n;
+  int c;
+  bool found=false;
+
+  if (!i.good() || !sb) {
+    i.setstate(std::ios::failbit);
+    return i;
+  }
+
+  // Find "<tag" followed by a delimiter.
+  c=sb->sbumpc();
+  while (!found && (c != EOF)) {
+    if (c != '<') {
+      c=sb->sbumpc();
+      continue;
+    }
+    for (n=0; n<taglen; n++) {
+      if ((c=sb->sbumpc()) != tag[n]) break;
     }
-    if (found) buffer+=(s+' ');
-    if (found && xml_match_tag(s,e_tag.c_str())) {
-      found=false;
-      done=true;
+    if (n==taglen) {
+      c=sb->sbumpc();
+      found=db_xml_delim(c);
     }
   }
-  a.me->parse_xml(buffer);
-  std::string::size_type p=buffer.find(e_tag);
-  if (p != std::string::npos) {
-    p=buffer.find('>',p+1);
-    if (p != std::string::npos) {
-      remainder=buffer.substr(p,buffer.size()-p);
-    } else {
-      remainder=std::string("");
+  if (!found) {
+    i.setstate(std::ios::eofbit|std::ios::failbit);
+    return i;
+  }
+
+  buffer.reserve(4096);
+  buffer+='<';
+  buffer.append(tag,taglen);
+
+  // Copy up to and including the '>' of "</tag>".
+  for (; c != EOF; c=sb->sbumpc()) {
+    buffer+=(char)c;
+    if (c=='<') {
+      lt=buffer.size()-1;
+    } else if ((c=='>') && (buffer.size()-lt > taglen+2) &&
+        (buffer[lt+1]=='/') && !buffer.compare(lt+2,taglen,tag) &&
+        db_xml_delim(buffer[lt+2+taglen])) {
+      break;
     }
   }
+  if (c == EOF) i.setstate(std::ios::eofbit);
+
+  a.clear();
+  a.me->parse_xml(buffer);
   return i;
 }
 
@@ -147,6 +177,8 @@ class db_table : public track_mem<T> {
     SQL_CURSOR get_cursor();
     int set_cache_size(int i) { cache.set_size(i); return(cache.get_size()); };
     time_t set_cache_ttl(time_t i) { cache.set_ttl(i); return(cache.get_ttl()); };
+    int set_cache_shards(int i) { cache.set_shards(i); return(cache.get_shards()); };
+    static row_cache_stats cache_stats() { return cache.get_stats(); };
 #endif
     const char *search_tag(const char *s=0);
     operator T();
@@ -336,12 +368,11 @@ bool db_table<T>::DELETE(const std::string &where) {
 
 template <typename T>
 bool db_table<T>::cached_fetch(sqlint8_t lid) {
-  T *item;
   if (!lid) {
     lid=me->id;
   }
-  if ((item=cache.find(lid)) != NULL) {
-    *this=*item;
+  if (cache.find(lid,*me)) {
+    cursor=-1;
     return true;
   } else {
     bool rv=fetch(lid);
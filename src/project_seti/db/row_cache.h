@@ -15,71 +15,229 @@
 // with SETI_BOINC; see the file COPYING.  If not, write to the Free Software
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 
+#ifndef _ROW_CACHE_H_
+#define _ROW_CACHE_H_
+
+#include "sah_config.h"
+#include <cstdio>
 #include <ctime>
 #include <vector>
-#include <map>
 
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+// Counters kept by row_cache.  "expired" lookups are also counted as misses.
+struct row_cache_stats {
+  size_t hits;
+  size_t misses;
+  size_t expired;
+  size_t evictions;
+  size_t inserts;
+  size_t entries;
+  row_cache_stats() : hits(0), misses(0), expired(0), evictions(0),
+    inserts(0), entries(0) {};
+  double hit_rate() const {
+    return (hits+misses)?((double)hits/(hits+misses)):0.0;
+  };
+};
 
+// A fixed size cache of table rows, indexed by id.  Lookups go through a
+// chained hash table and the rows of each shard are kept on an intrusive
+// list in least recently used order, so find() and insert() are O(1).  Rows
+// older than the ttl are dropped when they are looked up.
+//
+// The cache can be split into several shards, each with its own lock, for
+// server tools that look rows up from more than one thread.  Those should
+// use find(id,row), which copies the row out while the shard is locked; the
+// pointer returned by find(id) is only good until the next insert.
 template <typename T>
 class row_cache {
   private:
-    class cache_element {
-      public:
+    struct cache_element {
       T item;
       time_t insert_time;
-      cache_element(const T &val) : item(val), insert_time(time(0)) {};
-      cache_element &operator =(const T &val) {
-        if (&item != &val) {
-          item=val;
-          insert_time=time(0);
+      int prev, next;   // LRU list, most recently used first
+      int chain;        // next element in the same hash bucket
+      cache_element(const T &val, time_t t) : item(val), insert_time(t),
+        prev(-1), next(-1), chain(-1) {};
+    };
+
+    struct shard {
+      std::vector<cache_element> elements;
+      std::vector<int> buckets;
+      int head, tail;
+      int free_list;    // unused elements, linked through chain
+      int size;
+      row_cache_stats stats;
+#ifdef HAVE_PTHREAD
+      pthread_mutex_t mutex;
+      shard() { pthread_mutex_init(&mutex,NULL); };
+      ~shard() { pthread_mutex_destroy(&mutex); };
+      void lock() { pthread_mutex_lock(&mutex); };
+      void unlock() { pthread_mutex_unlock(&mutex); };
+#else
+      void lock() {};
+      void unlock() {};
+#endif
+
+      void clear(int newsize) {
+        size=newsize;
+        elements.clear();
+        elements.reserve(size);
+        // keep the chains short: at least two buckets per element
+        int nbuckets=4;
+        while (nbuckets < 2*size) nbuckets*=2;
+        buckets.assign(nbuckets,-1);
+        head=tail=free_list=-1;
+        stats.entries=0;
+      };
+
+      int &bucket(unsigned long h) {
+        return buckets[h & (buckets.size()-1)];
+      };
+
+      void unlink(int i) {
+        cache_element &e=elements[i];
+        if (e.prev >= 0) elements[e.prev].next=e.next; else head=e.next;
+        if (e.next >= 0) elements[e.next].prev=e.prev; else tail=e.prev;
+      };
+
+      void push_front(int i) {
+        cache_element &e=elements[i];
+        e.prev=-1;
+        e.next=head;
+        if (head >= 0) elements[head].prev=i; else tail=i;
+        head=i;
+      };
+
+      int lookup(unsigned long h, sqlint8_t id) {
+        int i;
+        for (i=bucket(h); i >= 0; i=elements[i].chain) {
+          if (elements[i].item.id == id) break;
         }
-        return *this;
+        return i;
+      };
+
+      // Takes element i off the LRU list and out of its hash chain.
+      void remove(int i, unsigned long h) {
+        int *p=&bucket(h);
+        while (*p != i) p=&(elements[*p].chain);
+        *p=elements[i].chain;
+        unlink(i);
+        elements[i].chain=free_list;
+        free_list=i;
+        stats.entries--;
       };
     };
+
+    shard *shards;
+    int nshards;
     int size;
-    std::vector<cache_element> elements;
-    typedef typename std::vector<cache_element>::iterator element_iterator;
-    typedef typename std::map<sqlint8_t,element_iterator>::iterator id_iterator;
-    typedef typename std::multimap<time_t,element_iterator>::iterator time_iterator;
-    std::map<sqlint8_t,element_iterator> id_index;
-    std::multimap<time_t,element_iterator> time_index;
     time_t ttl;
-    size_t hits;
-    size_t misses;
+
+    row_cache(const row_cache<T> &);
+    row_cache<T> &operator =(const row_cache<T> &);
+
+    // Ids are mostly sequential, so spread them with a multiplicative hash.
+    // h%nshards picks the shard and h/nshards the bucket within it.  Masking
+    // h itself for the bucket would reuse the bits that picked the shard, and
+    // each shard would only ever fill a fraction of its buckets.
+    static unsigned long hash(sqlint8_t id) {
+      unsigned long h=static_cast<unsigned long>(static_cast<long>(id))*2654435761UL;
+      return h^(h>>16);
+    };
+
+    shard &shard_for(unsigned long h) {
+      return shards[h%nshards];
+    };
+
+    unsigned long bucket_hash(unsigned long h) {
+      return h/nshards;
+    };
+
+    void setup(int newsize, int newshards) {
+      delete [] shards;
+      size=(newsize>0)?newsize:1;
+      nshards=(newshards>0)?newshards:1;
+      shards=new shard[nshards];
+      invalidate_all();
+    };
 
   public:
   // constructors
-    row_cache(int newsize=1024, time_t newttl=3600) : 
-      size(newsize), ttl(newttl), hits(0), misses(0) { invalidate_all(); };
+    row_cache(int newsize=1024, time_t newttl=3600, int newshards=1) :
+      shards(0), nshards(1), size(newsize), ttl(newttl) {
+      setup(newsize,newshards);
+    };
 
     ~row_cache() {
 #ifndef _NDEBUG
       print_stats();
 #endif
-    }; 
+      delete [] shards;
+    };
 
-    void print_stats() {
-      printf("Cache statistics on %s\n",T::table_name);
-      printf("%ld hits    %ld misses   %f percent hit rate\n",
-	  misses, hits, (double)hits/(hits+misses));
-    }
+    row_cache_stats get_stats() {
+      row_cache_stats rv;
+      for (int i=0; i<nshards; i++) {
+        shards[i].lock();
+        rv.hits+=shards[i].stats.hits;
+        rv.misses+=shards[i].stats.misses;
+        rv.expired+=shards[i].stats.expired;
+        rv.evictions+=shards[i].stats.evictions;
+        rv.inserts+=shards[i].stats.inserts;
+        rv.entries+=shards[i].stats.entries;
+        shards[i].unlock();
+      }
+      return rv;
+    };
+
+    void reset_stats() {
+      for (int i=0; i<nshards; i++) {
+        shards[i].lock();
+        size_t entries=shards[i].stats.entries;
+        shards[i].stats=row_cache_stats();
+        shards[i].stats.entries=entries;
+        shards[i].unlock();
+      }
+    };
 
-    void invalidate_all() { 
-      elements.clear(); 
-      elements.reserve(size);
-      time_index.clear(); 
-      id_index.clear(); 
+    void print_stats(FILE *f=stdout) {
+      row_cache_stats s=get_stats();
+      fprintf(f,"Cache statistics on %s\n",T::table_name);
+      fprintf(f,"%lu hits    %lu misses   %f percent hit rate\n",
+          (unsigned long)s.hits, (unsigned long)s.misses, 100.0*s.hit_rate());
+      fprintf(f,"%lu expired    %lu evicted    %lu inserted    %lu of %d entries used\n",
+          (unsigned long)s.expired, (unsigned long)s.evictions,
+          (unsigned long)s.inserts, (unsigned long)s.entries, size);
+    };
+
+    void invalidate_all() {
+      int per_shard=(size+nshards-1)/nshards;
+      for (int i=0; i<nshards; i++) {
+        shards[i].lock();
+        shards[i].clear(per_shard);
+        shards[i].unlock();
+      }
     };
 
     void set_size(int newsize) {
-      size=newsize;
-      invalidate_all();
+      setup(newsize,nshards);
     }
 
     int get_size() {
       return(size);
     }
 
+    void set_shards(int newshards) {
+      setup(size,newshards);
+    }
+
+    int get_shards() {
+      return(nshards);
+    }
+
     void set_ttl(time_t newttl) {
       ttl=newttl;
     }
@@ -89,34 +247,89 @@ class row_cache {
     }
 
     void insert(const T &val) {
-      element_iterator inserted;
-      if (elements.size() < size) {
-        // not full yet, just push_back()
-        elements.push_back(val);
-        inserted=elements.end()-1;
+      unsigned long h=hash(val.id);
+      shard &s=shard_for(h);
+      h=bucket_hash(h);
+      time_t now=time(0);
+      int i;
+
+      s.lock();
+      s.stats.inserts++;
+      if ((i=s.lookup(h,val.id)) >= 0) {
+        // already cached, refresh it in place
+        s.elements[i].item=val;
+        s.elements[i].insert_time=now;
+        s.unlink(i);
       } else {
-        // We're full so we'll find the oldest element to overwrite.
-        time_iterator oldest=time_index.begin();
-        inserted=oldest->second;
-        // remove it from the indexes
-        id_index.erase(id_index.find(inserted->item.id));
-        time_index.erase(oldest);
-        // overwrite the old cache item with the new one.
-        *inserted=val;
+        if (s.free_list >= 0) {
+          i=s.free_list;
+          s.free_list=s.elements[i].chain;
+          s.elements[i].item=val;
+          s.elements[i].insert_time=now;
+        } else if ((int)s.elements.size() < s.size) {
+          // not full yet, just push_back()
+          s.elements.push_back(cache_element(val,now));
+          i=s.elements.size()-1;
+        } else {
+          // We're full so overwrite the least recently used element.
+          i=s.tail;
+          s.remove(i,bucket_hash(hash(s.elements[i].item.id)));
+          s.stats.evictions++;
+          s.free_list=s.elements[i].chain;
+          s.elements[i].item=val;
+          s.elements[i].insert_time=now;
+        }
+        s.elements[i].chain=s.bucket(h);
+        s.bucket(h)=i;
+        s.stats.entries++;
       }
-      // add the new item to the indexes.
-      id_index[inserted->item.id]=inserted;
-      time_index.insert(std::pair<time_t,element_iterator>(inserted->insert_time,inserted));
+      s.push_front(i);
+      s.unlock();
+    };
+
+    // Copies the cached row into row, returns false if it isn't cached.
+    bool find(sqlint8_t id, T &row) {
+      T *item;
+      unsigned long h=hash(id);
+      shard &s=shard_for(h);
+      h=bucket_hash(h);
+      s.lock();
+      if ((item=find_locked(s,h,id)) != NULL) row=*item;
+      s.unlock();
+      return (item != NULL);
     };
-      
+
     T *find(sqlint8_t id) {
-      id_iterator i=id_index.find(id);
-      if ((i == id_index.end()) || (i->second->insert_time+ttl < time(0))) {
-	misses++;
-	return NULL;
+      T *item;
+      unsigned long h=hash(id);
+      shard &s=shard_for(h);
+      h=bucket_hash(h);
+      s.lock();
+      item=find_locked(s,h,id);
+      s.unlock();
+      return item;
+    };
+
+  private:
+    T *find_locked(shard &s, unsigned long h, sqlint8_t id) {
+      int i=s.lookup(h,id);
+      if (i < 0) {
+        s.stats.misses++;
+        return NULL;
       }
-      hits++;
-      return &(i->second->item);
+      if (s.elements[i].insert_time+ttl < time(0)) {
+        s.remove(i,h);
+        s.stats.expired++;
+        s.stats.misses++;
+        return NULL;
+      }
+      s.stats.hits++;
+      if (s.head != i) {
+        s.unlink(i);
+        s.push_front(i);
+      }
+      return &(s.elements[i].item);
     };
 };
 
+#endif
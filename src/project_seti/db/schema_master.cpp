@@ -124,17 +124,22 @@ std::string coordinate_t::print(int full_subtables, int show_ids, int no_refs) c
 
 std::string coordinate_t::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void coordinate_t::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	rv << xml_indent() << "<time>" << time << "</time>\n";
-	rv << xml_indent() << "<ra>" << ra << "</ra>\n";
-	rv << xml_indent() << "<dec>" << dec << "</dec>\n";
+	rv.indent() << "<time>" << time << "</time>\n";
+	rv.indent() << "<ra>" << ra << "</ra>\n";
+	rv.indent() << "<dec>" << dec << "</dec>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -145,20 +150,17 @@ std::string coordinate_t::print_xml(int full_subtables, int show_ids, int no_ref
 	    if (extract_xml_record(field,"time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time;
+	        xml_parse_value(sub.c_str()+pos,time);
 	      }
 	    if (extract_xml_record(field,"ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra;
+	        xml_parse_value(sub.c_str()+pos,ra);
 	      }
 	    if (extract_xml_record(field,"dec",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> dec;
+	        xml_parse_value(sub.c_str()+pos,dec);
 	      }
 	      }
 	      }
@@ -274,16 +276,21 @@ std::string chirp_parameter_t::print(int full_subtables, int show_ids, int no_re
 
 std::string chirp_parameter_t::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void chirp_parameter_t::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	rv << xml_indent() << "<chirp_limit>" << chirp_limit << "</chirp_limit>\n";
-	rv << xml_indent() << "<fft_len_flags>" << fft_len_flags << "</fft_len_flags>\n";
+	rv.indent() << "<chirp_limit>" << chirp_limit << "</chirp_limit>\n";
+	rv.indent() << "<fft_len_flags>" << fft_len_flags << "</fft_len_flags>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -294,14 +301,12 @@ std::string chirp_parameter_t::print_xml(int full_subtables, int show_ids, int n
 	    if (extract_xml_record(field,"chirp_limit",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chirp_limit;
+	        xml_parse_value(sub.c_str()+pos,chirp_limit);
 	      }
 	    if (extract_xml_record(field,"fft_len_flags",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fft_len_flags;
+	        xml_parse_value(sub.c_str()+pos,fft_len_flags);
 	      }
 	      }
 	      }
@@ -423,18 +428,23 @@ std::string subband_description_t::print(int full_subtables, int show_ids, int n
 
 std::string subband_description_t::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void subband_description_t::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	rv << xml_indent() << "<number>" << number << "</number>\n";
-	rv << xml_indent() << "<center>" << center << "</center>\n";
-	rv << xml_indent() << "<base>" << base << "</base>\n";
-	rv << xml_indent() << "<sample_rate>" << sample_rate << "</sample_rate>\n";
+	rv.indent() << "<number>" << number << "</number>\n";
+	rv.indent() << "<center>" << center << "</center>\n";
+	rv.indent() << "<base>" << base << "</base>\n";
+	rv.indent() << "<sample_rate>" << sample_rate << "</sample_rate>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -445,26 +455,22 @@ std::string subband_description_t::print_xml(int full_subtables, int show_ids, i
 	    if (extract_xml_record(field,"number",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> number;
+	        xml_parse_value(sub.c_str()+pos,number);
 	      }
 	    if (extract_xml_record(field,"center",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> center;
+	        xml_parse_value(sub.c_str()+pos,center);
 	      }
 	    if (extract_xml_record(field,"base",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> base;
+	        xml_parse_value(sub.c_str()+pos,base);
 	      }
 	    if (extract_xml_record(field,"sample_rate",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> sample_rate;
+	        xml_parse_value(sub.c_str()+pos,sample_rate);
 	      }
 	      }
 	      }
@@ -636,25 +642,31 @@ std::string data_description_t::print(int full_subtables, int show_ids, int no_r
 
 std::string data_description_t::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void data_description_t::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	rv << xml_indent() << "<start_ra>" << start_ra << "</start_ra>\n";
-	rv << xml_indent() << "<start_dec>" << start_dec << "</start_dec>\n";
-	rv << xml_indent() << "<end_ra>" << end_ra << "</end_ra>\n";
-	rv << xml_indent() << "<end_dec>" << end_dec << "</end_dec>\n";
-	rv << xml_indent() << "<true_angle_range>" << true_angle_range << "</true_angle_range>\n";
+	rv.indent() << "<start_ra>" << start_ra << "</start_ra>\n";
+	rv.indent() << "<start_dec>" << start_dec << "</start_dec>\n";
+	rv.indent() << "<end_ra>" << end_ra << "</end_ra>\n";
+	rv.indent() << "<end_dec>" << end_dec << "</end_dec>\n";
+	rv.indent() << "<true_angle_range>" << true_angle_range << "</true_angle_range>\n";
 	{
 	  std::string enc_field=xml_encode_string(time_recorded,std::min(strlen(time_recorded),sizeof(time_recorded)));
-	  rv << xml_indent() << "<time_recorded>";
+	  rv.indent() << "<time_recorded>";
 	  rv << enc_field << "</time_recorded>\n";
 	}
-	rv << xml_indent() << "<time_recorded_jd>" << time_recorded_jd << "</time_recorded_jd>\n";
-	rv << xml_indent() << "<nsamples>" << nsamples << "</nsamples>\n";
+	rv.indent() << "<time_recorded_jd>" << time_recorded_jd << "</time_recorded_jd>\n";
+	rv.indent() << "<nsamples>" << nsamples << "</nsamples>\n";
 	if (coords.size()) {
-	  rv << xml_indent() << "<coords";
+	  rv.indent() << "<coords";
 	  {
 	    std::string enc_string=coords.print_xml();
 	    rv << ">\n" ;
@@ -664,8 +676,7 @@ std::string data_description_t::print_xml(int full_subtables, int show_ids, int
 	rv << xml_indent(-2);
 	rv << "</coords>\n"; 
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -676,32 +687,27 @@ std::string data_description_t::print_xml(int full_subtables, int show_ids, int
 	    if (extract_xml_record(field,"start_ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> start_ra;
+	        xml_parse_value(sub.c_str()+pos,start_ra);
 	      }
 	    if (extract_xml_record(field,"start_dec",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> start_dec;
+	        xml_parse_value(sub.c_str()+pos,start_dec);
 	      }
 	    if (extract_xml_record(field,"end_ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> end_ra;
+	        xml_parse_value(sub.c_str()+pos,end_ra);
 	      }
 	    if (extract_xml_record(field,"end_dec",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> end_dec;
+	        xml_parse_value(sub.c_str()+pos,end_dec);
 	      }
 	    if (extract_xml_record(field,"true_angle_range",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> true_angle_range;
+	        xml_parse_value(sub.c_str()+pos,true_angle_range);
 	      }
 	    if (extract_xml_record(field,"time_recorded",sub)) {
 	        pos=sub.find(">");
@@ -716,14 +722,12 @@ std::string data_description_t::print_xml(int full_subtables, int show_ids, int
 	    if (extract_xml_record(field,"time_recorded_jd",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time_recorded_jd;
+	        xml_parse_value(sub.c_str()+pos,time_recorded_jd);
 	      }
 	    if (extract_xml_record(field,"nsamples",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> nsamples;
+	        xml_parse_value(sub.c_str()+pos,nsamples);
 	      }
 	    coords.clear();
 	    if (extract_xml_record(field,"coords",sub)) {
@@ -976,27 +980,33 @@ std::string receiver_config::print(int full_subtables, int show_ids, int no_refs
 
 std::string receiver_config::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void receiver_config::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<s4_id>" << s4_id << "</s4_id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<s4_id>" << s4_id << "</s4_id>\n";
 	{
 	  std::string enc_field=xml_encode_string(name,std::min(strlen(name),sizeof(name)));
-	  rv << xml_indent() << "<name>";
+	  rv.indent() << "<name>";
 	  rv << enc_field << "</name>\n";
 	}
-	rv << xml_indent() << "<beam_width>" << beam_width << "</beam_width>\n";
-	rv << xml_indent() << "<center_freq>" << center_freq << "</center_freq>\n";
-	rv << xml_indent() << "<latitude>" << latitude << "</latitude>\n";
-	rv << xml_indent() << "<longitude>" << longitude << "</longitude>\n";
-	rv << xml_indent() << "<elevation>" << elevation << "</elevation>\n";
-	rv << xml_indent() << "<diameter>" << diameter << "</diameter>\n";
-	rv << xml_indent() << "<az_orientation>" << az_orientation << "</az_orientation>\n";
+	rv.indent() << "<beam_width>" << beam_width << "</beam_width>\n";
+	rv.indent() << "<center_freq>" << center_freq << "</center_freq>\n";
+	rv.indent() << "<latitude>" << latitude << "</latitude>\n";
+	rv.indent() << "<longitude>" << longitude << "</longitude>\n";
+	rv.indent() << "<elevation>" << elevation << "</elevation>\n";
+	rv.indent() << "<diameter>" << diameter << "</diameter>\n";
+	rv.indent() << "<az_orientation>" << az_orientation << "</az_orientation>\n";
 	if (az_corr_coeff.size()) {
-	  rv << xml_indent() << "<az_corr_coeff";
+	  rv.indent() << "<az_corr_coeff";
 	  {
 	    std::string enc_string=az_corr_coeff.print_xml();
 	    rv << " length=" << enc_string.size() << " encoding=\"" << xml_encoding_names[az_corr_coeff.encoding] << "\">" ;
@@ -1005,7 +1015,7 @@ std::string receiver_config::print_xml(int full_subtables, int show_ids, int no_
 }
 	rv << "</az_corr_coeff>\n"; 
 	if (zen_corr_coeff.size()) {
-	  rv << xml_indent() << "<zen_corr_coeff";
+	  rv.indent() << "<zen_corr_coeff";
 	  {
 	    std::string enc_string=zen_corr_coeff.print_xml();
 	    rv << " length=" << enc_string.size() << " encoding=\"" << xml_encoding_names[zen_corr_coeff.encoding] << "\">" ;
@@ -1013,13 +1023,12 @@ std::string receiver_config::print_xml(int full_subtables, int show_ids, int no_
 	  }
 }
 	rv << "</zen_corr_coeff>\n"; 
-	rv << xml_indent() << "<array_az_ellipse>" << array_az_ellipse << "</array_az_ellipse>\n";
-	rv << xml_indent() << "<array_za_ellipse>" << array_za_ellipse << "</array_za_ellipse>\n";
-	rv << xml_indent() << "<array_angle>" << array_angle << "</array_angle>\n";
-	rv << xml_indent() << "<min_vgc>" << min_vgc << "</min_vgc>\n";
+	rv.indent() << "<array_az_ellipse>" << array_az_ellipse << "</array_az_ellipse>\n";
+	rv.indent() << "<array_za_ellipse>" << array_za_ellipse << "</array_za_ellipse>\n";
+	rv.indent() << "<array_angle>" << array_angle << "</array_angle>\n";
+	rv.indent() << "<min_vgc>" << min_vgc << "</min_vgc>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -1030,14 +1039,12 @@ std::string receiver_config::print_xml(int full_subtables, int show_ids, int no_
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"s4_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> s4_id;
+	        xml_parse_value(sub.c_str()+pos,s4_id);
 	      }
 	    if (extract_xml_record(field,"name",sub)) {
 	        pos=sub.find(">");
@@ -1052,44 +1059,37 @@ std::string receiver_config::print_xml(int full_subtables, int show_ids, int no_
 	    if (extract_xml_record(field,"beam_width",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> beam_width;
+	        xml_parse_value(sub.c_str()+pos,beam_width);
 	      }
 	    if (extract_xml_record(field,"center_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> center_freq;
+	        xml_parse_value(sub.c_str()+pos,center_freq);
 	      }
 	    if (extract_xml_record(field,"latitude",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> latitude;
+	        xml_parse_value(sub.c_str()+pos,latitude);
 	      }
 	    if (extract_xml_record(field,"longitude",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> longitude;
+	        xml_parse_value(sub.c_str()+pos,longitude);
 	      }
 	    if (extract_xml_record(field,"elevation",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> elevation;
+	        xml_parse_value(sub.c_str()+pos,elevation);
 	      }
 	    if (extract_xml_record(field,"diameter",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> diameter;
+	        xml_parse_value(sub.c_str()+pos,diameter);
 	      }
 	    if (extract_xml_record(field,"az_orientation",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> az_orientation;
+	        xml_parse_value(sub.c_str()+pos,az_orientation);
 	      }
 	    az_corr_coeff.clear();
 	    if (extract_xml_record(field,"az_corr_coeff",sub)) {
@@ -1097,9 +1097,8 @@ std::string receiver_config::print_xml(int full_subtables, int show_ids, int no_
 	      do {
 	        if (pos!=std::string::npos) {
 	          do { pos++; } while ((sub[pos]=='\n') || (sub[pos]==','));
-	          std::istringstream in(std::string(sub.c_str()+pos)); 
 	          float tmp;
-	          in >> tmp;
+	          xml_parse_value(sub.c_str()+pos,tmp);
 	          az_corr_coeff.push_back(tmp);
 	        }
 	      } while ((pos=sub.find(",",pos)) != std::string::npos); 
@@ -1110,9 +1109,8 @@ std::string receiver_config::print_xml(int full_subtables, int show_ids, int no_
 	      do {
 	        if (pos!=std::string::npos) {
 	          do { pos++; } while ((sub[pos]=='\n') || (sub[pos]==','));
-	          std::istringstream in(std::string(sub.c_str()+pos)); 
 	          float tmp;
-	          in >> tmp;
+	          xml_parse_value(sub.c_str()+pos,tmp);
 	          zen_corr_coeff.push_back(tmp);
 	        }
 	      } while ((pos=sub.find(",",pos)) != std::string::npos); 
@@ -1120,26 +1118,22 @@ std::string receiver_config::print_xml(int full_subtables, int show_ids, int no_
 	    if (extract_xml_record(field,"array_az_ellipse",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> array_az_ellipse;
+	        xml_parse_value(sub.c_str()+pos,array_az_ellipse);
 	      }
 	    if (extract_xml_record(field,"array_za_ellipse",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> array_za_ellipse;
+	        xml_parse_value(sub.c_str()+pos,array_za_ellipse);
 	      }
 	    if (extract_xml_record(field,"array_angle",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> array_angle;
+	        xml_parse_value(sub.c_str()+pos,array_angle);
 	      }
 	    if (extract_xml_record(field,"min_vgc",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> min_vgc;
+	        xml_parse_value(sub.c_str()+pos,min_vgc);
 	      }
 	      }
 	      }
@@ -1338,24 +1332,29 @@ std::string recorder_config::print(int full_subtables, int show_ids, int no_refs
 
 std::string recorder_config::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void recorder_config::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	{
 	  std::string enc_field=xml_encode_string(name,std::min(strlen(name),sizeof(name)));
-	  rv << xml_indent() << "<name>";
+	  rv.indent() << "<name>";
 	  rv << enc_field << "</name>\n";
 	}
-	rv << xml_indent() << "<bits_per_sample>" << bits_per_sample << "</bits_per_sample>\n";
-	rv << xml_indent() << "<sample_rate>" << sample_rate << "</sample_rate>\n";
-	rv << xml_indent() << "<beams>" << beams << "</beams>\n";
-	rv << xml_indent() << "<version>" << version << "</version>\n";
+	rv.indent() << "<bits_per_sample>" << bits_per_sample << "</bits_per_sample>\n";
+	rv.indent() << "<sample_rate>" << sample_rate << "</sample_rate>\n";
+	rv.indent() << "<beams>" << beams << "</beams>\n";
+	rv.indent() << "<version>" << version << "</version>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -1366,8 +1365,7 @@ std::string recorder_config::print_xml(int full_subtables, int show_ids, int no_
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"name",sub)) {
 	        pos=sub.find(">");
@@ -1382,26 +1380,22 @@ std::string recorder_config::print_xml(int full_subtables, int show_ids, int no_
 	    if (extract_xml_record(field,"bits_per_sample",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> bits_per_sample;
+	        xml_parse_value(sub.c_str()+pos,bits_per_sample);
 	      }
 	    if (extract_xml_record(field,"sample_rate",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> sample_rate;
+	        xml_parse_value(sub.c_str()+pos,sample_rate);
 	      }
 	    if (extract_xml_record(field,"beams",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> beams;
+	        xml_parse_value(sub.c_str()+pos,beams);
 	      }
 	    if (extract_xml_record(field,"version",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> version;
+	        xml_parse_value(sub.c_str()+pos,version);
 	      }
 	      }
 	      }
@@ -1564,40 +1558,45 @@ std::string splitter_config::print(int full_subtables, int show_ids, int no_refs
 
 std::string splitter_config::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void splitter_config::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<version>" << version << "</version>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<version>" << version << "</version>\n";
 	{
 	  std::string enc_field=xml_encode_string(data_type,std::min(strlen(data_type),sizeof(data_type)));
-	  rv << xml_indent() << "<data_type>";
+	  rv.indent() << "<data_type>";
 	  rv << enc_field << "</data_type>\n";
 	}
-	rv << xml_indent() << "<fft_len>" << fft_len << "</fft_len>\n";
-	rv << xml_indent() << "<ifft_len>" << ifft_len << "</ifft_len>\n";
+	rv.indent() << "<fft_len>" << fft_len << "</fft_len>\n";
+	rv.indent() << "<ifft_len>" << ifft_len << "</ifft_len>\n";
 	{
 	  std::string enc_field=xml_encode_string(filter,std::min(strlen(filter),sizeof(filter)));
-	  rv << xml_indent() << "<filter>";
+	  rv.indent() << "<filter>";
 	  rv << enc_field << "</filter>\n";
 	}
 	{
 	  std::string enc_field=xml_encode_string(window,std::min(strlen(window),sizeof(window)));
-	  rv << xml_indent() << "<window>";
+	  rv.indent() << "<window>";
 	  rv << enc_field << "</window>\n";
 	}
-	rv << xml_indent() << "<samples_per_wu>" << samples_per_wu << "</samples_per_wu>\n";
-	rv << xml_indent() << "<highpass>" << highpass << "</highpass>\n";
+	rv.indent() << "<samples_per_wu>" << samples_per_wu << "</samples_per_wu>\n";
+	rv.indent() << "<highpass>" << highpass << "</highpass>\n";
 	{
 	  std::string enc_field=xml_encode_string(blanker_filter,std::min(strlen(blanker_filter),sizeof(blanker_filter)));
-	  rv << xml_indent() << "<blanker_filter>";
+	  rv.indent() << "<blanker_filter>";
 	  rv << enc_field << "</blanker_filter>\n";
 	}
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -1608,14 +1607,12 @@ std::string splitter_config::print_xml(int full_subtables, int show_ids, int no_
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"version",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> version;
+	        xml_parse_value(sub.c_str()+pos,version);
 	      }
 	    if (extract_xml_record(field,"data_type",sub)) {
 	        pos=sub.find(">");
@@ -1630,14 +1627,12 @@ std::string splitter_config::print_xml(int full_subtables, int show_ids, int no_
 	    if (extract_xml_record(field,"fft_len",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fft_len;
+	        xml_parse_value(sub.c_str()+pos,fft_len);
 	      }
 	    if (extract_xml_record(field,"ifft_len",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ifft_len;
+	        xml_parse_value(sub.c_str()+pos,ifft_len);
 	      }
 	    if (extract_xml_record(field,"filter",sub)) {
 	        pos=sub.find(">");
@@ -1662,14 +1657,12 @@ std::string splitter_config::print_xml(int full_subtables, int show_ids, int no_
 	    if (extract_xml_record(field,"samples_per_wu",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> samples_per_wu;
+	        xml_parse_value(sub.c_str()+pos,samples_per_wu);
 	      }
 	    if (extract_xml_record(field,"highpass",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> highpass;
+	        xml_parse_value(sub.c_str()+pos,highpass);
 	      }
 	    if (extract_xml_record(field,"blanker_filter",sub)) {
 	        pos=sub.find(">");
@@ -2020,42 +2013,48 @@ std::string analysis_config::print(int full_subtables, int show_ids, int no_refs
 
 std::string analysis_config::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void analysis_config::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<spike_thresh>" << spike_thresh << "</spike_thresh>\n";
-	rv << xml_indent() << "<spikes_per_spectrum>" << spikes_per_spectrum << "</spikes_per_spectrum>\n";
-	rv << xml_indent() << "<autocorr_thresh>" << autocorr_thresh << "</autocorr_thresh>\n";
-	rv << xml_indent() << "<autocorr_per_spectrum>" << autocorr_per_spectrum << "</autocorr_per_spectrum>\n";
-	rv << xml_indent() << "<autocorr_fftlen>" << autocorr_fftlen << "</autocorr_fftlen>\n";
-	rv << xml_indent() << "<gauss_null_chi_sq_thresh>" << gauss_null_chi_sq_thresh << "</gauss_null_chi_sq_thresh>\n";
-	rv << xml_indent() << "<gauss_chi_sq_thresh>" << gauss_chi_sq_thresh << "</gauss_chi_sq_thresh>\n";
-	rv << xml_indent() << "<gauss_power_thresh>" << gauss_power_thresh << "</gauss_power_thresh>\n";
-	rv << xml_indent() << "<gauss_peak_power_thresh>" << gauss_peak_power_thresh << "</gauss_peak_power_thresh>\n";
-	rv << xml_indent() << "<gauss_pot_length>" << gauss_pot_length << "</gauss_pot_length>\n";
-	rv << xml_indent() << "<pulse_thresh>" << pulse_thresh << "</pulse_thresh>\n";
-	rv << xml_indent() << "<pulse_display_thresh>" << pulse_display_thresh << "</pulse_display_thresh>\n";
-	rv << xml_indent() << "<pulse_max>" << pulse_max << "</pulse_max>\n";
-	rv << xml_indent() << "<pulse_min>" << pulse_min << "</pulse_min>\n";
-	rv << xml_indent() << "<pulse_fft_max>" << pulse_fft_max << "</pulse_fft_max>\n";
-	rv << xml_indent() << "<pulse_pot_length>" << pulse_pot_length << "</pulse_pot_length>\n";
-	rv << xml_indent() << "<triplet_thresh>" << triplet_thresh << "</triplet_thresh>\n";
-	rv << xml_indent() << "<triplet_max>" << triplet_max << "</triplet_max>\n";
-	rv << xml_indent() << "<triplet_min>" << triplet_min << "</triplet_min>\n";
-	rv << xml_indent() << "<triplet_pot_length>" << triplet_pot_length << "</triplet_pot_length>\n";
-	rv << xml_indent() << "<pot_overlap_factor>" << pot_overlap_factor << "</pot_overlap_factor>\n";
-	rv << xml_indent() << "<pot_t_offset>" << pot_t_offset << "</pot_t_offset>\n";
-	rv << xml_indent() << "<pot_min_slew>" << pot_min_slew << "</pot_min_slew>\n";
-	rv << xml_indent() << "<pot_max_slew>" << pot_max_slew << "</pot_max_slew>\n";
-	rv << xml_indent() << "<chirp_resolution>" << chirp_resolution << "</chirp_resolution>\n";
-	rv << xml_indent() << "<analysis_fft_lengths>" << analysis_fft_lengths << "</analysis_fft_lengths>\n";
-	rv << xml_indent() << "<bsmooth_boxcar_length>" << bsmooth_boxcar_length << "</bsmooth_boxcar_length>\n";
-	rv << xml_indent() << "<bsmooth_chunk_size>" << bsmooth_chunk_size << "</bsmooth_chunk_size>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<spike_thresh>" << spike_thresh << "</spike_thresh>\n";
+	rv.indent() << "<spikes_per_spectrum>" << spikes_per_spectrum << "</spikes_per_spectrum>\n";
+	rv.indent() << "<autocorr_thresh>" << autocorr_thresh << "</autocorr_thresh>\n";
+	rv.indent() << "<autocorr_per_spectrum>" << autocorr_per_spectrum << "</autocorr_per_spectrum>\n";
+	rv.indent() << "<autocorr_fftlen>" << autocorr_fftlen << "</autocorr_fftlen>\n";
+	rv.indent() << "<gauss_null_chi_sq_thresh>" << gauss_null_chi_sq_thresh << "</gauss_null_chi_sq_thresh>\n";
+	rv.indent() << "<gauss_chi_sq_thresh>" << gauss_chi_sq_thresh << "</gauss_chi_sq_thresh>\n";
+	rv.indent() << "<gauss_power_thresh>" << gauss_power_thresh << "</gauss_power_thresh>\n";
+	rv.indent() << "<gauss_peak_power_thresh>" << gauss_peak_power_thresh << "</gauss_peak_power_thresh>\n";
+	rv.indent() << "<gauss_pot_length>" << gauss_pot_length << "</gauss_pot_length>\n";
+	rv.indent() << "<pulse_thresh>" << pulse_thresh << "</pulse_thresh>\n";
+	rv.indent() << "<pulse_display_thresh>" << pulse_display_thresh << "</pulse_display_thresh>\n";
+	rv.indent() << "<pulse_max>" << pulse_max << "</pulse_max>\n";
+	rv.indent() << "<pulse_min>" << pulse_min << "</pulse_min>\n";
+	rv.indent() << "<pulse_fft_max>" << pulse_fft_max << "</pulse_fft_max>\n";
+	rv.indent() << "<pulse_pot_length>" << pulse_pot_length << "</pulse_pot_length>\n";
+	rv.indent() << "<triplet_thresh>" << triplet_thresh << "</triplet_thresh>\n";
+	rv.indent() << "<triplet_max>" << triplet_max << "</triplet_max>\n";
+	rv.indent() << "<triplet_min>" << triplet_min << "</triplet_min>\n";
+	rv.indent() << "<triplet_pot_length>" << triplet_pot_length << "</triplet_pot_length>\n";
+	rv.indent() << "<pot_overlap_factor>" << pot_overlap_factor << "</pot_overlap_factor>\n";
+	rv.indent() << "<pot_t_offset>" << pot_t_offset << "</pot_t_offset>\n";
+	rv.indent() << "<pot_min_slew>" << pot_min_slew << "</pot_min_slew>\n";
+	rv.indent() << "<pot_max_slew>" << pot_max_slew << "</pot_max_slew>\n";
+	rv.indent() << "<chirp_resolution>" << chirp_resolution << "</chirp_resolution>\n";
+	rv.indent() << "<analysis_fft_lengths>" << analysis_fft_lengths << "</analysis_fft_lengths>\n";
+	rv.indent() << "<bsmooth_boxcar_length>" << bsmooth_boxcar_length << "</bsmooth_boxcar_length>\n";
+	rv.indent() << "<bsmooth_chunk_size>" << bsmooth_chunk_size << "</bsmooth_chunk_size>\n";
 	if (chirps.size()) {
-	  rv << xml_indent() << "<chirps";
+	  rv.indent() << "<chirps";
 	  {
 	    std::string enc_string=chirps.print_xml();
 	    rv << ">\n" ;
@@ -2064,18 +2063,17 @@ std::string analysis_config::print_xml(int full_subtables, int show_ids, int no_
 }
 	rv << xml_indent(-2);
 	rv << "</chirps>\n"; 
-	rv << xml_indent() << "<pulse_beams>" << pulse_beams << "</pulse_beams>\n";
-	rv << xml_indent() << "<max_signals>" << max_signals << "</max_signals>\n";
-	rv << xml_indent() << "<max_spikes>" << max_spikes << "</max_spikes>\n";
-	rv << xml_indent() << "<max_autocorr>" << max_autocorr << "</max_autocorr>\n";
-	rv << xml_indent() << "<max_gaussians>" << max_gaussians << "</max_gaussians>\n";
-	rv << xml_indent() << "<max_pulses>" << max_pulses << "</max_pulses>\n";
-	rv << xml_indent() << "<max_triplets>" << max_triplets << "</max_triplets>\n";
-	rv << xml_indent() << "<keyuniq>" << keyuniq << "</keyuniq>\n";
-	rv << xml_indent() << "<credit_rate>" << credit_rate << "</credit_rate>\n";
+	rv.indent() << "<pulse_beams>" << pulse_beams << "</pulse_beams>\n";
+	rv.indent() << "<max_signals>" << max_signals << "</max_signals>\n";
+	rv.indent() << "<max_spikes>" << max_spikes << "</max_spikes>\n";
+	rv.indent() << "<max_autocorr>" << max_autocorr << "</max_autocorr>\n";
+	rv.indent() << "<max_gaussians>" << max_gaussians << "</max_gaussians>\n";
+	rv.indent() << "<max_pulses>" << max_pulses << "</max_pulses>\n";
+	rv.indent() << "<max_triplets>" << max_triplets << "</max_triplets>\n";
+	rv.indent() << "<keyuniq>" << keyuniq << "</keyuniq>\n";
+	rv.indent() << "<credit_rate>" << credit_rate << "</credit_rate>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -2086,176 +2084,147 @@ std::string analysis_config::print_xml(int full_subtables, int show_ids, int no_
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"spike_thresh",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> spike_thresh;
+	        xml_parse_value(sub.c_str()+pos,spike_thresh);
 	      }
 	    if (extract_xml_record(field,"spikes_per_spectrum",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> spikes_per_spectrum;
+	        xml_parse_value(sub.c_str()+pos,spikes_per_spectrum);
 	      }
 	    if (extract_xml_record(field,"autocorr_thresh",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> autocorr_thresh;
+	        xml_parse_value(sub.c_str()+pos,autocorr_thresh);
 	      }
 	    if (extract_xml_record(field,"autocorr_per_spectrum",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> autocorr_per_spectrum;
+	        xml_parse_value(sub.c_str()+pos,autocorr_per_spectrum);
 	      }
 	    if (extract_xml_record(field,"autocorr_fftlen",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> autocorr_fftlen;
+	        xml_parse_value(sub.c_str()+pos,autocorr_fftlen);
 	      }
 	    if (extract_xml_record(field,"gauss_null_chi_sq_thresh",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> gauss_null_chi_sq_thresh;
+	        xml_parse_value(sub.c_str()+pos,gauss_null_chi_sq_thresh);
 	      }
 	    if (extract_xml_record(field,"gauss_chi_sq_thresh",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> gauss_chi_sq_thresh;
+	        xml_parse_value(sub.c_str()+pos,gauss_chi_sq_thresh);
 	      }
 	    if (extract_xml_record(field,"gauss_power_thresh",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> gauss_power_thresh;
+	        xml_parse_value(sub.c_str()+pos,gauss_power_thresh);
 	      }
 	    if (extract_xml_record(field,"gauss_peak_power_thresh",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> gauss_peak_power_thresh;
+	        xml_parse_value(sub.c_str()+pos,gauss_peak_power_thresh);
 	      }
 	    if (extract_xml_record(field,"gauss_pot_length",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> gauss_pot_length;
+	        xml_parse_value(sub.c_str()+pos,gauss_pot_length);
 	      }
 	    if (extract_xml_record(field,"pulse_thresh",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulse_thresh;
+	        xml_parse_value(sub.c_str()+pos,pulse_thresh);
 	      }
 	    if (extract_xml_record(field,"pulse_display_thresh",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulse_display_thresh;
+	        xml_parse_value(sub.c_str()+pos,pulse_display_thresh);
 	      }
 	    if (extract_xml_record(field,"pulse_max",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulse_max;
+	        xml_parse_value(sub.c_str()+pos,pulse_max);
 	      }
 	    if (extract_xml_record(field,"pulse_min",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulse_min;
+	        xml_parse_value(sub.c_str()+pos,pulse_min);
 	      }
 	    if (extract_xml_record(field,"pulse_fft_max",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulse_fft_max;
+	        xml_parse_value(sub.c_str()+pos,pulse_fft_max);
 	      }
 	    if (extract_xml_record(field,"pulse_pot_length",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulse_pot_length;
+	        xml_parse_value(sub.c_str()+pos,pulse_pot_length);
 	      }
 	    if (extract_xml_record(field,"triplet_thresh",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> triplet_thresh;
+	        xml_parse_value(sub.c_str()+pos,triplet_thresh);
 	      }
 	    if (extract_xml_record(field,"triplet_max",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> triplet_max;
+	        xml_parse_value(sub.c_str()+pos,triplet_max);
 	      }
 	    if (extract_xml_record(field,"triplet_min",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> triplet_min;
+	        xml_parse_value(sub.c_str()+pos,triplet_min);
 	      }
 	    if (extract_xml_record(field,"triplet_pot_length",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> triplet_pot_length;
+	        xml_parse_value(sub.c_str()+pos,triplet_pot_length);
 	      }
 	    if (extract_xml_record(field,"pot_overlap_factor",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pot_overlap_factor;
+	        xml_parse_value(sub.c_str()+pos,pot_overlap_factor);
 	      }
 	    if (extract_xml_record(field,"pot_t_offset",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pot_t_offset;
+	        xml_parse_value(sub.c_str()+pos,pot_t_offset);
 	      }
 	    if (extract_xml_record(field,"pot_min_slew",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pot_min_slew;
+	        xml_parse_value(sub.c_str()+pos,pot_min_slew);
 	      }
 	    if (extract_xml_record(field,"pot_max_slew",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pot_max_slew;
+	        xml_parse_value(sub.c_str()+pos,pot_max_slew);
 	      }
 	    if (extract_xml_record(field,"chirp_resolution",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chirp_resolution;
+	        xml_parse_value(sub.c_str()+pos,chirp_resolution);
 	      }
 	    if (extract_xml_record(field,"analysis_fft_lengths",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> analysis_fft_lengths;
+	        xml_parse_value(sub.c_str()+pos,analysis_fft_lengths);
 	      }
 	    if (extract_xml_record(field,"bsmooth_boxcar_length",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> bsmooth_boxcar_length;
+	        xml_parse_value(sub.c_str()+pos,bsmooth_boxcar_length);
 	      }
 	    if (extract_xml_record(field,"bsmooth_chunk_size",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> bsmooth_chunk_size;
+	        xml_parse_value(sub.c_str()+pos,bsmooth_chunk_size);
 	      }
 	    chirps.clear();
 	    if (extract_xml_record(field,"chirps",sub)) {
@@ -2269,56 +2238,47 @@ std::string analysis_config::print_xml(int full_subtables, int show_ids, int no_
 	    if (extract_xml_record(field,"pulse_beams",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulse_beams;
+	        xml_parse_value(sub.c_str()+pos,pulse_beams);
 	      }
 	    if (extract_xml_record(field,"max_signals",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_signals;
+	        xml_parse_value(sub.c_str()+pos,max_signals);
 	      }
 	    if (extract_xml_record(field,"max_spikes",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_spikes;
+	        xml_parse_value(sub.c_str()+pos,max_spikes);
 	      }
 	    if (extract_xml_record(field,"max_autocorr",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_autocorr;
+	        xml_parse_value(sub.c_str()+pos,max_autocorr);
 	      }
 	    if (extract_xml_record(field,"max_gaussians",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_gaussians;
+	        xml_parse_value(sub.c_str()+pos,max_gaussians);
 	      }
 	    if (extract_xml_record(field,"max_pulses",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_pulses;
+	        xml_parse_value(sub.c_str()+pos,max_pulses);
 	      }
 	    if (extract_xml_record(field,"max_triplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_triplets;
+	        xml_parse_value(sub.c_str()+pos,max_triplets);
 	      }
 	    if (extract_xml_record(field,"keyuniq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> keyuniq;
+	        xml_parse_value(sub.c_str()+pos,keyuniq);
 	      }
 	    if (extract_xml_record(field,"credit_rate",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> credit_rate;
+	        xml_parse_value(sub.c_str()+pos,credit_rate);
 	      }
 	      }
 	      }
@@ -2713,51 +2673,56 @@ std::string science_config::print(int full_subtables, int show_ids, int no_refs)
 
 std::string science_config::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void science_config::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<active>" << active << "</active>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<active>" << active << "</active>\n";
 	{
 	  std::string enc_field=xml_encode_string(qpix_scheme,std::min(strlen(qpix_scheme),sizeof(qpix_scheme)));
-	  rv << xml_indent() << "<qpix_scheme>";
+	  rv.indent() << "<qpix_scheme>";
 	  rv << enc_field << "</qpix_scheme>\n";
 	}
-	rv << xml_indent() << "<qpix_nside>" << qpix_nside << "</qpix_nside>\n";
-	rv << xml_indent() << "<fpix_width>" << fpix_width << "</fpix_width>\n";
-	rv << xml_indent() << "<total_bandwidth>" << total_bandwidth << "</total_bandwidth>\n";
-	rv << xml_indent() << "<freq_uncertainty>" << freq_uncertainty << "</freq_uncertainty>\n";
-	rv << xml_indent() << "<fwhm_beamwidth>" << fwhm_beamwidth << "</fwhm_beamwidth>\n";
-	rv << xml_indent() << "<sky_disc_radius>" << sky_disc_radius << "</sky_disc_radius>\n";
-	rv << xml_indent() << "<observable_sky>" << observable_sky << "</observable_sky>\n";
-	rv << xml_indent() << "<epoch>" << epoch << "</epoch>\n";
-	rv << xml_indent() << "<bary_chirp_window>" << bary_chirp_window << "</bary_chirp_window>\n";
-	rv << xml_indent() << "<bary_freq_window>" << bary_freq_window << "</bary_freq_window>\n";
-	rv << xml_indent() << "<nonbary_freq_window>" << nonbary_freq_window << "</nonbary_freq_window>\n";
-	rv << xml_indent() << "<spike_obs_duration>" << spike_obs_duration << "</spike_obs_duration>\n";
-	rv << xml_indent() << "<spike_obs_interval>" << spike_obs_interval << "</spike_obs_interval>\n";
-	rv << xml_indent() << "<gauss_obs_duration>" << gauss_obs_duration << "</gauss_obs_duration>\n";
-	rv << xml_indent() << "<gauss_obs_interval>" << gauss_obs_interval << "</gauss_obs_interval>\n";
-	rv << xml_indent() << "<pulse_obs_duration>" << pulse_obs_duration << "</pulse_obs_duration>\n";
-	rv << xml_indent() << "<pulse_obs_interval>" << pulse_obs_interval << "</pulse_obs_interval>\n";
-	rv << xml_indent() << "<triplet_obs_duration>" << triplet_obs_duration << "</triplet_obs_duration>\n";
-	rv << xml_indent() << "<triplet_obs_interval>" << triplet_obs_interval << "</triplet_obs_interval>\n";
-	rv << xml_indent() << "<min_spike_id>" << min_spike_id << "</min_spike_id>\n";
-	rv << xml_indent() << "<min_autocorr_id>" << min_autocorr_id << "</min_autocorr_id>\n";
-	rv << xml_indent() << "<min_gaussian_id>" << min_gaussian_id << "</min_gaussian_id>\n";
-	rv << xml_indent() << "<min_pulse_id>" << min_pulse_id << "</min_pulse_id>\n";
-	rv << xml_indent() << "<min_triplet_id>" << min_triplet_id << "</min_triplet_id>\n";
-	rv << xml_indent() << "<min_app_version>" << min_app_version << "</min_app_version>\n";
+	rv.indent() << "<qpix_nside>" << qpix_nside << "</qpix_nside>\n";
+	rv.indent() << "<fpix_width>" << fpix_width << "</fpix_width>\n";
+	rv.indent() << "<total_bandwidth>" << total_bandwidth << "</total_bandwidth>\n";
+	rv.indent() << "<freq_uncertainty>" << freq_uncertainty << "</freq_uncertainty>\n";
+	rv.indent() << "<fwhm_beamwidth>" << fwhm_beamwidth << "</fwhm_beamwidth>\n";
+	rv.indent() << "<sky_disc_radius>" << sky_disc_radius << "</sky_disc_radius>\n";
+	rv.indent() << "<observable_sky>" << observable_sky << "</observable_sky>\n";
+	rv.indent() << "<epoch>" << epoch << "</epoch>\n";
+	rv.indent() << "<bary_chirp_window>" << bary_chirp_window << "</bary_chirp_window>\n";
+	rv.indent() << "<bary_freq_window>" << bary_freq_window << "</bary_freq_window>\n";
+	rv.indent() << "<nonbary_freq_window>" << nonbary_freq_window << "</nonbary_freq_window>\n";
+	rv.indent() << "<spike_obs_duration>" << spike_obs_duration << "</spike_obs_duration>\n";
+	rv.indent() << "<spike_obs_interval>" << spike_obs_interval << "</spike_obs_interval>\n";
+	rv.indent() << "<gauss_obs_duration>" << gauss_obs_duration << "</gauss_obs_duration>\n";
+	rv.indent() << "<gauss_obs_interval>" << gauss_obs_interval << "</gauss_obs_interval>\n";
+	rv.indent() << "<pulse_obs_duration>" << pulse_obs_duration << "</pulse_obs_duration>\n";
+	rv.indent() << "<pulse_obs_interval>" << pulse_obs_interval << "</pulse_obs_interval>\n";
+	rv.indent() << "<triplet_obs_duration>" << triplet_obs_duration << "</triplet_obs_duration>\n";
+	rv.indent() << "<triplet_obs_interval>" << triplet_obs_interval << "</triplet_obs_interval>\n";
+	rv.indent() << "<min_spike_id>" << min_spike_id << "</min_spike_id>\n";
+	rv.indent() << "<min_autocorr_id>" << min_autocorr_id << "</min_autocorr_id>\n";
+	rv.indent() << "<min_gaussian_id>" << min_gaussian_id << "</min_gaussian_id>\n";
+	rv.indent() << "<min_pulse_id>" << min_pulse_id << "</min_pulse_id>\n";
+	rv.indent() << "<min_triplet_id>" << min_triplet_id << "</min_triplet_id>\n";
+	rv.indent() << "<min_app_version>" << min_app_version << "</min_app_version>\n";
 	{
 	  std::string enc_field=xml_encode_string(info_xml,std::min(strlen(info_xml),sizeof(info_xml)));
-	  rv << xml_indent() << "<info_xml>";
+	  rv.indent() << "<info_xml>";
 	  rv << enc_field << "</info_xml>\n";
 	}
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -2768,14 +2733,12 @@ std::string science_config::print_xml(int full_subtables, int show_ids, int no_r
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"active",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> active;
+	        xml_parse_value(sub.c_str()+pos,active);
 	      }
 	    if (extract_xml_record(field,"qpix_scheme",sub)) {
 	        pos=sub.find(">");
@@ -2790,152 +2753,127 @@ std::string science_config::print_xml(int full_subtables, int show_ids, int no_r
 	    if (extract_xml_record(field,"qpix_nside",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> qpix_nside;
+	        xml_parse_value(sub.c_str()+pos,qpix_nside);
 	      }
 	    if (extract_xml_record(field,"fpix_width",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fpix_width;
+	        xml_parse_value(sub.c_str()+pos,fpix_width);
 	      }
 	    if (extract_xml_record(field,"total_bandwidth",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> total_bandwidth;
+	        xml_parse_value(sub.c_str()+pos,total_bandwidth);
 	      }
 	    if (extract_xml_record(field,"freq_uncertainty",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> freq_uncertainty;
+	        xml_parse_value(sub.c_str()+pos,freq_uncertainty);
 	      }
 	    if (extract_xml_record(field,"fwhm_beamwidth",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fwhm_beamwidth;
+	        xml_parse_value(sub.c_str()+pos,fwhm_beamwidth);
 	      }
 	    if (extract_xml_record(field,"sky_disc_radius",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> sky_disc_radius;
+	        xml_parse_value(sub.c_str()+pos,sky_disc_radius);
 	      }
 	    if (extract_xml_record(field,"observable_sky",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> observable_sky;
+	        xml_parse_value(sub.c_str()+pos,observable_sky);
 	      }
 	    if (extract_xml_record(field,"epoch",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> epoch;
+	        xml_parse_value(sub.c_str()+pos,epoch);
 	      }
 	    if (extract_xml_record(field,"bary_chirp_window",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> bary_chirp_window;
+	        xml_parse_value(sub.c_str()+pos,bary_chirp_window);
 	      }
 	    if (extract_xml_record(field,"bary_freq_window",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> bary_freq_window;
+	        xml_parse_value(sub.c_str()+pos,bary_freq_window);
 	      }
 	    if (extract_xml_record(field,"nonbary_freq_window",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> nonbary_freq_window;
+	        xml_parse_value(sub.c_str()+pos,nonbary_freq_window);
 	      }
 	    if (extract_xml_record(field,"spike_obs_duration",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> spike_obs_duration;
+	        xml_parse_value(sub.c_str()+pos,spike_obs_duration);
 	      }
 	    if (extract_xml_record(field,"spike_obs_interval",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> spike_obs_interval;
+	        xml_parse_value(sub.c_str()+pos,spike_obs_interval);
 	      }
 	    if (extract_xml_record(field,"gauss_obs_duration",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> gauss_obs_duration;
+	        xml_parse_value(sub.c_str()+pos,gauss_obs_duration);
 	      }
 	    if (extract_xml_record(field,"gauss_obs_interval",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> gauss_obs_interval;
+	        xml_parse_value(sub.c_str()+pos,gauss_obs_interval);
 	      }
 	    if (extract_xml_record(field,"pulse_obs_duration",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulse_obs_duration;
+	        xml_parse_value(sub.c_str()+pos,pulse_obs_duration);
 	      }
 	    if (extract_xml_record(field,"pulse_obs_interval",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulse_obs_interval;
+	        xml_parse_value(sub.c_str()+pos,pulse_obs_interval);
 	      }
 	    if (extract_xml_record(field,"triplet_obs_duration",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> triplet_obs_duration;
+	        xml_parse_value(sub.c_str()+pos,triplet_obs_duration);
 	      }
 	    if (extract_xml_record(field,"triplet_obs_interval",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> triplet_obs_interval;
+	        xml_parse_value(sub.c_str()+pos,triplet_obs_interval);
 	      }
 	    if (extract_xml_record(field,"min_spike_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> min_spike_id;
+	        xml_parse_value(sub.c_str()+pos,min_spike_id);
 	      }
 	    if (extract_xml_record(field,"min_autocorr_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> min_autocorr_id;
+	        xml_parse_value(sub.c_str()+pos,min_autocorr_id);
 	      }
 	    if (extract_xml_record(field,"min_gaussian_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> min_gaussian_id;
+	        xml_parse_value(sub.c_str()+pos,min_gaussian_id);
 	      }
 	    if (extract_xml_record(field,"min_pulse_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> min_pulse_id;
+	        xml_parse_value(sub.c_str()+pos,min_pulse_id);
 	      }
 	    if (extract_xml_record(field,"min_triplet_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> min_triplet_id;
+	        xml_parse_value(sub.c_str()+pos,min_triplet_id);
 	      }
 	    if (extract_xml_record(field,"min_app_version",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> min_app_version;
+	        xml_parse_value(sub.c_str()+pos,min_app_version);
 	      }
 	    if (extract_xml_record(field,"info_xml",sub)) {
 	        pos=sub.find(">");
@@ -3180,19 +3118,24 @@ std::string candidate_t::print(int full_subtables, int show_ids, int no_refs) co
 
 std::string candidate_t::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void candidate_t::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	rv << xml_indent() << "<type>" << type << "</type>\n";
-	rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<num_obs>" << num_obs << "</num_obs>\n";
-	rv << xml_indent() << "<score>" << score << "</score>\n";
-	rv << xml_indent() << "<is_rfi>" << is_rfi << "</is_rfi>\n";
+	rv.indent() << "<type>" << type << "</type>\n";
+	rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<num_obs>" << num_obs << "</num_obs>\n";
+	rv.indent() << "<score>" << score << "</score>\n";
+	rv.indent() << "<is_rfi>" << is_rfi << "</is_rfi>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -3203,32 +3146,27 @@ std::string candidate_t::print_xml(int full_subtables, int show_ids, int no_refs
 	    if (extract_xml_record(field,"type",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> type;
+	        xml_parse_value(sub.c_str()+pos,type);
 	      }
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"num_obs",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_obs;
+	        xml_parse_value(sub.c_str()+pos,num_obs);
 	      }
 	    if (extract_xml_record(field,"score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> score;
+	        xml_parse_value(sub.c_str()+pos,score);
 	      }
 	    if (extract_xml_record(field,"is_rfi",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> is_rfi;
+	        xml_parse_value(sub.c_str()+pos,is_rfi);
 	      }
 	      }
 	      }
@@ -3497,46 +3435,51 @@ std::string meta_candidate::print(int full_subtables, int show_ids, int no_refs)
 
 std::string meta_candidate::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void meta_candidate::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<version>" << version << "</version>\n";
-	rv << xml_indent() << "<time_last_updated>" << time_last_updated << "</time_last_updated>\n";
-	rv << xml_indent() << "<num_spikes>" << num_spikes << "</num_spikes>\n";
-	rv << xml_indent() << "<num_spike_b_multiplets>" << num_spike_b_multiplets << "</num_spike_b_multiplets>\n";
-	rv << xml_indent() << "<best_spike_b_mp_score>" << best_spike_b_mp_score << "</best_spike_b_mp_score>\n";
-	rv << xml_indent() << "<num_spike_nb_multiplets>" << num_spike_nb_multiplets << "</num_spike_nb_multiplets>\n";
-	rv << xml_indent() << "<best_spike_nb_mp_score>" << best_spike_nb_mp_score << "</best_spike_nb_mp_score>\n";
-	rv << xml_indent() << "<spike_high_id>" << spike_high_id << "</spike_high_id>\n";
-	rv << xml_indent() << "<num_gaussians>" << num_gaussians << "</num_gaussians>\n";
-	rv << xml_indent() << "<num_gaussian_b_multiplets>" << num_gaussian_b_multiplets << "</num_gaussian_b_multiplets>\n";
-	rv << xml_indent() << "<best_gaussian_b_mp_score>" << best_gaussian_b_mp_score << "</best_gaussian_b_mp_score>\n";
-	rv << xml_indent() << "<num_gaussian_nb_multiplets>" << num_gaussian_nb_multiplets << "</num_gaussian_nb_multiplets>\n";
-	rv << xml_indent() << "<best_gaussian_nb_mp_score>" << best_gaussian_nb_mp_score << "</best_gaussian_nb_mp_score>\n";
-	rv << xml_indent() << "<gaussian_high_id>" << gaussian_high_id << "</gaussian_high_id>\n";
-	rv << xml_indent() << "<num_pulses>" << num_pulses << "</num_pulses>\n";
-	rv << xml_indent() << "<num_pulse_b_multiplets>" << num_pulse_b_multiplets << "</num_pulse_b_multiplets>\n";
-	rv << xml_indent() << "<best_pulse_b_mp_score>" << best_pulse_b_mp_score << "</best_pulse_b_mp_score>\n";
-	rv << xml_indent() << "<num_pulse_nb_multiplets>" << num_pulse_nb_multiplets << "</num_pulse_nb_multiplets>\n";
-	rv << xml_indent() << "<best_pulse_nb_mp_score>" << best_pulse_nb_mp_score << "</best_pulse_nb_mp_score>\n";
-	rv << xml_indent() << "<pulse_high_id>" << pulse_high_id << "</pulse_high_id>\n";
-	rv << xml_indent() << "<num_triplets>" << num_triplets << "</num_triplets>\n";
-	rv << xml_indent() << "<num_triplet_b_multiplets>" << num_triplet_b_multiplets << "</num_triplet_b_multiplets>\n";
-	rv << xml_indent() << "<best_triplet_b_mp_score>" << best_triplet_b_mp_score << "</best_triplet_b_mp_score>\n";
-	rv << xml_indent() << "<num_triplet_nb_multiplets>" << num_triplet_nb_multiplets << "</num_triplet_nb_multiplets>\n";
-	rv << xml_indent() << "<best_triplet_nb_mp_score>" << best_triplet_nb_mp_score << "</best_triplet_nb_mp_score>\n";
-	rv << xml_indent() << "<triplet_high_id>" << triplet_high_id << "</triplet_high_id>\n";
-	rv << xml_indent() << "<num_stars>" << num_stars << "</num_stars>\n";
-	rv << xml_indent() << "<best_star_score>" << best_star_score << "</best_star_score>\n";
-	rv << xml_indent() << "<meta_score>" << meta_score << "</meta_score>\n";
-	rv << xml_indent() << "<rfi_clean>" << rfi_clean << "</rfi_clean>\n";
-	rv << xml_indent() << "<state>" << state << "</state>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<version>" << version << "</version>\n";
+	rv.indent() << "<time_last_updated>" << time_last_updated << "</time_last_updated>\n";
+	rv.indent() << "<num_spikes>" << num_spikes << "</num_spikes>\n";
+	rv.indent() << "<num_spike_b_multiplets>" << num_spike_b_multiplets << "</num_spike_b_multiplets>\n";
+	rv.indent() << "<best_spike_b_mp_score>" << best_spike_b_mp_score << "</best_spike_b_mp_score>\n";
+	rv.indent() << "<num_spike_nb_multiplets>" << num_spike_nb_multiplets << "</num_spike_nb_multiplets>\n";
+	rv.indent() << "<best_spike_nb_mp_score>" << best_spike_nb_mp_score << "</best_spike_nb_mp_score>\n";
+	rv.indent() << "<spike_high_id>" << spike_high_id << "</spike_high_id>\n";
+	rv.indent() << "<num_gaussians>" << num_gaussians << "</num_gaussians>\n";
+	rv.indent() << "<num_gaussian_b_multiplets>" << num_gaussian_b_multiplets << "</num_gaussian_b_multiplets>\n";
+	rv.indent() << "<best_gaussian_b_mp_score>" << best_gaussian_b_mp_score << "</best_gaussian_b_mp_score>\n";
+	rv.indent() << "<num_gaussian_nb_multiplets>" << num_gaussian_nb_multiplets << "</num_gaussian_nb_multiplets>\n";
+	rv.indent() << "<best_gaussian_nb_mp_score>" << best_gaussian_nb_mp_score << "</best_gaussian_nb_mp_score>\n";
+	rv.indent() << "<gaussian_high_id>" << gaussian_high_id << "</gaussian_high_id>\n";
+	rv.indent() << "<num_pulses>" << num_pulses << "</num_pulses>\n";
+	rv.indent() << "<num_pulse_b_multiplets>" << num_pulse_b_multiplets << "</num_pulse_b_multiplets>\n";
+	rv.indent() << "<best_pulse_b_mp_score>" << best_pulse_b_mp_score << "</best_pulse_b_mp_score>\n";
+	rv.indent() << "<num_pulse_nb_multiplets>" << num_pulse_nb_multiplets << "</num_pulse_nb_multiplets>\n";
+	rv.indent() << "<best_pulse_nb_mp_score>" << best_pulse_nb_mp_score << "</best_pulse_nb_mp_score>\n";
+	rv.indent() << "<pulse_high_id>" << pulse_high_id << "</pulse_high_id>\n";
+	rv.indent() << "<num_triplets>" << num_triplets << "</num_triplets>\n";
+	rv.indent() << "<num_triplet_b_multiplets>" << num_triplet_b_multiplets << "</num_triplet_b_multiplets>\n";
+	rv.indent() << "<best_triplet_b_mp_score>" << best_triplet_b_mp_score << "</best_triplet_b_mp_score>\n";
+	rv.indent() << "<num_triplet_nb_multiplets>" << num_triplet_nb_multiplets << "</num_triplet_nb_multiplets>\n";
+	rv.indent() << "<best_triplet_nb_mp_score>" << best_triplet_nb_mp_score << "</best_triplet_nb_mp_score>\n";
+	rv.indent() << "<triplet_high_id>" << triplet_high_id << "</triplet_high_id>\n";
+	rv.indent() << "<num_stars>" << num_stars << "</num_stars>\n";
+	rv.indent() << "<best_star_score>" << best_star_score << "</best_star_score>\n";
+	rv.indent() << "<meta_score>" << meta_score << "</meta_score>\n";
+	rv.indent() << "<rfi_clean>" << rfi_clean << "</rfi_clean>\n";
+	rv.indent() << "<state>" << state << "</state>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -3547,194 +3490,162 @@ std::string meta_candidate::print_xml(int full_subtables, int show_ids, int no_r
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"version",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> version;
+	        xml_parse_value(sub.c_str()+pos,version);
 	      }
 	    if (extract_xml_record(field,"time_last_updated",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time_last_updated;
+	        xml_parse_value(sub.c_str()+pos,time_last_updated);
 	      }
 	    if (extract_xml_record(field,"num_spikes",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_spikes;
+	        xml_parse_value(sub.c_str()+pos,num_spikes);
 	      }
 	    if (extract_xml_record(field,"num_spike_b_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_spike_b_multiplets;
+	        xml_parse_value(sub.c_str()+pos,num_spike_b_multiplets);
 	      }
 	    if (extract_xml_record(field,"best_spike_b_mp_score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> best_spike_b_mp_score;
+	        xml_parse_value(sub.c_str()+pos,best_spike_b_mp_score);
 	      }
 	    if (extract_xml_record(field,"num_spike_nb_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_spike_nb_multiplets;
+	        xml_parse_value(sub.c_str()+pos,num_spike_nb_multiplets);
 	      }
 	    if (extract_xml_record(field,"best_spike_nb_mp_score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> best_spike_nb_mp_score;
+	        xml_parse_value(sub.c_str()+pos,best_spike_nb_mp_score);
 	      }
 	    if (extract_xml_record(field,"spike_high_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> spike_high_id;
+	        xml_parse_value(sub.c_str()+pos,spike_high_id);
 	      }
 	    if (extract_xml_record(field,"num_gaussians",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_gaussians;
+	        xml_parse_value(sub.c_str()+pos,num_gaussians);
 	      }
 	    if (extract_xml_record(field,"num_gaussian_b_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_gaussian_b_multiplets;
+	        xml_parse_value(sub.c_str()+pos,num_gaussian_b_multiplets);
 	      }
 	    if (extract_xml_record(field,"best_gaussian_b_mp_score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> best_gaussian_b_mp_score;
+	        xml_parse_value(sub.c_str()+pos,best_gaussian_b_mp_score);
 	      }
 	    if (extract_xml_record(field,"num_gaussian_nb_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_gaussian_nb_multiplets;
+	        xml_parse_value(sub.c_str()+pos,num_gaussian_nb_multiplets);
 	      }
 	    if (extract_xml_record(field,"best_gaussian_nb_mp_score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> best_gaussian_nb_mp_score;
+	        xml_parse_value(sub.c_str()+pos,best_gaussian_nb_mp_score);
 	      }
 	    if (extract_xml_record(field,"gaussian_high_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> gaussian_high_id;
+	        xml_parse_value(sub.c_str()+pos,gaussian_high_id);
 	      }
 	    if (extract_xml_record(field,"num_pulses",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_pulses;
+	        xml_parse_value(sub.c_str()+pos,num_pulses);
 	      }
 	    if (extract_xml_record(field,"num_pulse_b_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_pulse_b_multiplets;
+	        xml_parse_value(sub.c_str()+pos,num_pulse_b_multiplets);
 	      }
 	    if (extract_xml_record(field,"best_pulse_b_mp_score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> best_pulse_b_mp_score;
+	        xml_parse_value(sub.c_str()+pos,best_pulse_b_mp_score);
 	      }
 	    if (extract_xml_record(field,"num_pulse_nb_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_pulse_nb_multiplets;
+	        xml_parse_value(sub.c_str()+pos,num_pulse_nb_multiplets);
 	      }
 	    if (extract_xml_record(field,"best_pulse_nb_mp_score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> best_pulse_nb_mp_score;
+	        xml_parse_value(sub.c_str()+pos,best_pulse_nb_mp_score);
 	      }
 	    if (extract_xml_record(field,"pulse_high_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulse_high_id;
+	        xml_parse_value(sub.c_str()+pos,pulse_high_id);
 	      }
 	    if (extract_xml_record(field,"num_triplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_triplets;
+	        xml_parse_value(sub.c_str()+pos,num_triplets);
 	      }
 	    if (extract_xml_record(field,"num_triplet_b_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_triplet_b_multiplets;
+	        xml_parse_value(sub.c_str()+pos,num_triplet_b_multiplets);
 	      }
 	    if (extract_xml_record(field,"best_triplet_b_mp_score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> best_triplet_b_mp_score;
+	        xml_parse_value(sub.c_str()+pos,best_triplet_b_mp_score);
 	      }
 	    if (extract_xml_record(field,"num_triplet_nb_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_triplet_nb_multiplets;
+	        xml_parse_value(sub.c_str()+pos,num_triplet_nb_multiplets);
 	      }
 	    if (extract_xml_record(field,"best_triplet_nb_mp_score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> best_triplet_nb_mp_score;
+	        xml_parse_value(sub.c_str()+pos,best_triplet_nb_mp_score);
 	      }
 	    if (extract_xml_record(field,"triplet_high_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> triplet_high_id;
+	        xml_parse_value(sub.c_str()+pos,triplet_high_id);
 	      }
 	    if (extract_xml_record(field,"num_stars",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_stars;
+	        xml_parse_value(sub.c_str()+pos,num_stars);
 	      }
 	    if (extract_xml_record(field,"best_star_score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> best_star_score;
+	        xml_parse_value(sub.c_str()+pos,best_star_score);
 	      }
 	    if (extract_xml_record(field,"meta_score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> meta_score;
+	        xml_parse_value(sub.c_str()+pos,meta_score);
 	      }
 	    if (extract_xml_record(field,"rfi_clean",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_clean;
+	        xml_parse_value(sub.c_str()+pos,rfi_clean);
 	      }
 	    if (extract_xml_record(field,"state",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> state;
+	        xml_parse_value(sub.c_str()+pos,state);
 	      }
 	      }
 	      }
@@ -4093,37 +4004,43 @@ std::string multiplet::print(int full_subtables, int show_ids, int no_refs) cons
 
 std::string multiplet::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void multiplet::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<version>" << version << "</version>\n";
-	rv << xml_indent() << "<signal_type>" << signal_type << "</signal_type>\n";
-	rv << xml_indent() << "<mp_type>" << mp_type << "</mp_type>\n";
-	rv << xml_indent() << "<qpix>" << qpix << "</qpix>\n";
-	rv << xml_indent() << "<freq_win>" << freq_win << "</freq_win>\n";
-	rv << xml_indent() << "<mean_ra>" << mean_ra << "</mean_ra>\n";
-	rv << xml_indent() << "<mean_decl>" << mean_decl << "</mean_decl>\n";
-	rv << xml_indent() << "<ra_stddev>" << ra_stddev << "</ra_stddev>\n";
-	rv << xml_indent() << "<decl_stddev>" << decl_stddev << "</decl_stddev>\n";
-	rv << xml_indent() << "<mean_angular_distance>" << mean_angular_distance << "</mean_angular_distance>\n";
-	rv << xml_indent() << "<angular_distance_stddev>" << angular_distance_stddev << "</angular_distance_stddev>\n";
-	rv << xml_indent() << "<mean_frequency>" << mean_frequency << "</mean_frequency>\n";
-	rv << xml_indent() << "<frequency_stddev>" << frequency_stddev << "</frequency_stddev>\n";
-	rv << xml_indent() << "<mean_chirp>" << mean_chirp << "</mean_chirp>\n";
-	rv << xml_indent() << "<chirp_stddev>" << chirp_stddev << "</chirp_stddev>\n";
-	rv << xml_indent() << "<mean_period>" << mean_period << "</mean_period>\n";
-	rv << xml_indent() << "<period_stddev>" << period_stddev << "</period_stddev>\n";
-	rv << xml_indent() << "<mean_snr>" << mean_snr << "</mean_snr>\n";
-	rv << xml_indent() << "<snr_stddev>" << snr_stddev << "</snr_stddev>\n";
-	rv << xml_indent() << "<mean_threshold>" << mean_threshold << "</mean_threshold>\n";
-	rv << xml_indent() << "<threshold_stddev>" << threshold_stddev << "</threshold_stddev>\n";
-	rv << xml_indent() << "<score>" << score << "</score>\n";
-	rv << xml_indent() << "<num_detections>" << num_detections << "</num_detections>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<version>" << version << "</version>\n";
+	rv.indent() << "<signal_type>" << signal_type << "</signal_type>\n";
+	rv.indent() << "<mp_type>" << mp_type << "</mp_type>\n";
+	rv.indent() << "<qpix>" << qpix << "</qpix>\n";
+	rv.indent() << "<freq_win>" << freq_win << "</freq_win>\n";
+	rv.indent() << "<mean_ra>" << mean_ra << "</mean_ra>\n";
+	rv.indent() << "<mean_decl>" << mean_decl << "</mean_decl>\n";
+	rv.indent() << "<ra_stddev>" << ra_stddev << "</ra_stddev>\n";
+	rv.indent() << "<decl_stddev>" << decl_stddev << "</decl_stddev>\n";
+	rv.indent() << "<mean_angular_distance>" << mean_angular_distance << "</mean_angular_distance>\n";
+	rv.indent() << "<angular_distance_stddev>" << angular_distance_stddev << "</angular_distance_stddev>\n";
+	rv.indent() << "<mean_frequency>" << mean_frequency << "</mean_frequency>\n";
+	rv.indent() << "<frequency_stddev>" << frequency_stddev << "</frequency_stddev>\n";
+	rv.indent() << "<mean_chirp>" << mean_chirp << "</mean_chirp>\n";
+	rv.indent() << "<chirp_stddev>" << chirp_stddev << "</chirp_stddev>\n";
+	rv.indent() << "<mean_period>" << mean_period << "</mean_period>\n";
+	rv.indent() << "<period_stddev>" << period_stddev << "</period_stddev>\n";
+	rv.indent() << "<mean_snr>" << mean_snr << "</mean_snr>\n";
+	rv.indent() << "<snr_stddev>" << snr_stddev << "</snr_stddev>\n";
+	rv.indent() << "<mean_threshold>" << mean_threshold << "</mean_threshold>\n";
+	rv.indent() << "<threshold_stddev>" << threshold_stddev << "</threshold_stddev>\n";
+	rv.indent() << "<score>" << score << "</score>\n";
+	rv.indent() << "<num_detections>" << num_detections << "</num_detections>\n";
 	if (signal_ids.size()) {
-	  rv << xml_indent() << "<signal_ids";
+	  rv.indent() << "<signal_ids";
 	  {
 	    std::string enc_string=signal_ids.print_xml();
 	    rv << " length=" << enc_string.size() << " encoding=\"" << xml_encoding_names[signal_ids.encoding] << "\">" ;
@@ -4132,8 +4049,7 @@ std::string multiplet::print_xml(int full_subtables, int show_ids, int no_refs,c
 }
 	rv << "</signal_ids>\n"; 
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -4144,146 +4060,122 @@ std::string multiplet::print_xml(int full_subtables, int show_ids, int no_refs,c
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"version",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> version;
+	        xml_parse_value(sub.c_str()+pos,version);
 	      }
 	    if (extract_xml_record(field,"signal_type",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> signal_type;
+	        xml_parse_value(sub.c_str()+pos,signal_type);
 	      }
 	    if (extract_xml_record(field,"mp_type",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mp_type;
+	        xml_parse_value(sub.c_str()+pos,mp_type);
 	      }
 	    if (extract_xml_record(field,"qpix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> qpix;
+	        xml_parse_value(sub.c_str()+pos,qpix);
 	      }
 	    if (extract_xml_record(field,"freq_win",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> freq_win;
+	        xml_parse_value(sub.c_str()+pos,freq_win);
 	      }
 	    if (extract_xml_record(field,"mean_ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_ra;
+	        xml_parse_value(sub.c_str()+pos,mean_ra);
 	      }
 	    if (extract_xml_record(field,"mean_decl",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_decl;
+	        xml_parse_value(sub.c_str()+pos,mean_decl);
 	      }
 	    if (extract_xml_record(field,"ra_stddev",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra_stddev;
+	        xml_parse_value(sub.c_str()+pos,ra_stddev);
 	      }
 	    if (extract_xml_record(field,"decl_stddev",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> decl_stddev;
+	        xml_parse_value(sub.c_str()+pos,decl_stddev);
 	      }
 	    if (extract_xml_record(field,"mean_angular_distance",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_angular_distance;
+	        xml_parse_value(sub.c_str()+pos,mean_angular_distance);
 	      }
 	    if (extract_xml_record(field,"angular_distance_stddev",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> angular_distance_stddev;
+	        xml_parse_value(sub.c_str()+pos,angular_distance_stddev);
 	      }
 	    if (extract_xml_record(field,"mean_frequency",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_frequency;
+	        xml_parse_value(sub.c_str()+pos,mean_frequency);
 	      }
 	    if (extract_xml_record(field,"frequency_stddev",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> frequency_stddev;
+	        xml_parse_value(sub.c_str()+pos,frequency_stddev);
 	      }
 	    if (extract_xml_record(field,"mean_chirp",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_chirp;
+	        xml_parse_value(sub.c_str()+pos,mean_chirp);
 	      }
 	    if (extract_xml_record(field,"chirp_stddev",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chirp_stddev;
+	        xml_parse_value(sub.c_str()+pos,chirp_stddev);
 	      }
 	    if (extract_xml_record(field,"mean_period",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_period;
+	        xml_parse_value(sub.c_str()+pos,mean_period);
 	      }
 	    if (extract_xml_record(field,"period_stddev",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> period_stddev;
+	        xml_parse_value(sub.c_str()+pos,period_stddev);
 	      }
 	    if (extract_xml_record(field,"mean_snr",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_snr;
+	        xml_parse_value(sub.c_str()+pos,mean_snr);
 	      }
 	    if (extract_xml_record(field,"snr_stddev",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> snr_stddev;
+	        xml_parse_value(sub.c_str()+pos,snr_stddev);
 	      }
 	    if (extract_xml_record(field,"mean_threshold",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_threshold;
+	        xml_parse_value(sub.c_str()+pos,mean_threshold);
 	      }
 	    if (extract_xml_record(field,"threshold_stddev",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> threshold_stddev;
+	        xml_parse_value(sub.c_str()+pos,threshold_stddev);
 	      }
 	    if (extract_xml_record(field,"score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> score;
+	        xml_parse_value(sub.c_str()+pos,score);
 	      }
 	    if (extract_xml_record(field,"num_detections",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> num_detections;
+	        xml_parse_value(sub.c_str()+pos,num_detections);
 	      }
 	    signal_ids.clear();
 	    if (extract_xml_record(field,"signal_ids",sub)) {
@@ -4291,9 +4183,8 @@ std::string multiplet::print_xml(int full_subtables, int show_ids, int no_refs,c
 	      do {
 	        if (pos!=std::string::npos) {
 	          do { pos++; } while ((sub[pos]=='\n') || (sub[pos]==','));
-	          std::istringstream in(std::string(sub.c_str()+pos)); 
 	          sqlint8_t tmp;
-	          in >> tmp;
+	          xml_parse_value(sub.c_str()+pos,tmp);
 	          signal_ids.push_back(tmp);
 	        }
 	      } while ((pos=sub.find(",",pos)) != std::string::npos); 
@@ -4563,44 +4454,49 @@ std::string star::print(int full_subtables, int show_ids, int no_refs) const
 
 std::string star::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void star::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	{
 	  std::string enc_field=xml_encode_string(object_type,std::min(strlen(object_type),sizeof(object_type)));
-	  rv << xml_indent() << "<object_type>";
+	  rv.indent() << "<object_type>";
 	  rv << enc_field << "</object_type>\n";
 	}
 	{
 	  std::string enc_field=xml_encode_string(catalog_name,std::min(strlen(catalog_name),sizeof(catalog_name)));
-	  rv << xml_indent() << "<catalog_name>";
+	  rv.indent() << "<catalog_name>";
 	  rv << enc_field << "</catalog_name>\n";
 	}
-	rv << xml_indent() << "<catalog_number>" << catalog_number << "</catalog_number>\n";
+	rv.indent() << "<catalog_number>" << catalog_number << "</catalog_number>\n";
 	{
 	  std::string enc_field=xml_encode_string(object_name,std::min(strlen(object_name),sizeof(object_name)));
-	  rv << xml_indent() << "<object_name>";
+	  rv.indent() << "<object_name>";
 	  rv << enc_field << "</object_name>\n";
 	}
-	rv << xml_indent() << "<ra>" << ra << "</ra>\n";
-	rv << xml_indent() << "<decl>" << decl << "</decl>\n";
-	rv << xml_indent() << "<qpix>" << qpix << "</qpix>\n";
-	rv << xml_indent() << "<v_mag>" << v_mag << "</v_mag>\n";
-	rv << xml_indent() << "<b_minus_v>" << b_minus_v << "</b_minus_v>\n";
-	rv << xml_indent() << "<parallax>" << parallax << "</parallax>\n";
+	rv.indent() << "<ra>" << ra << "</ra>\n";
+	rv.indent() << "<decl>" << decl << "</decl>\n";
+	rv.indent() << "<qpix>" << qpix << "</qpix>\n";
+	rv.indent() << "<v_mag>" << v_mag << "</v_mag>\n";
+	rv.indent() << "<b_minus_v>" << b_minus_v << "</b_minus_v>\n";
+	rv.indent() << "<parallax>" << parallax << "</parallax>\n";
 	{
 	  std::string enc_field=xml_encode_string(stellar_type,std::min(strlen(stellar_type),sizeof(stellar_type)));
-	  rv << xml_indent() << "<stellar_type>";
+	  rv.indent() << "<stellar_type>";
 	  rv << enc_field << "</stellar_type>\n";
 	}
-	rv << xml_indent() << "<planets>" << planets << "</planets>\n";
-	rv << xml_indent() << "<score>" << score << "</score>\n";
+	rv.indent() << "<planets>" << planets << "</planets>\n";
+	rv.indent() << "<score>" << score << "</score>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -4611,8 +4507,7 @@ std::string star::print_xml(int full_subtables, int show_ids, int no_refs,const
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"object_type",sub)) {
 	        pos=sub.find(">");
@@ -4637,8 +4532,7 @@ std::string star::print_xml(int full_subtables, int show_ids, int no_refs,const
 	    if (extract_xml_record(field,"catalog_number",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> catalog_number;
+	        xml_parse_value(sub.c_str()+pos,catalog_number);
 	      }
 	    if (extract_xml_record(field,"object_name",sub)) {
 	        pos=sub.find(">");
@@ -4653,38 +4547,32 @@ std::string star::print_xml(int full_subtables, int show_ids, int no_refs,const
 	    if (extract_xml_record(field,"ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra;
+	        xml_parse_value(sub.c_str()+pos,ra);
 	      }
 	    if (extract_xml_record(field,"decl",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> decl;
+	        xml_parse_value(sub.c_str()+pos,decl);
 	      }
 	    if (extract_xml_record(field,"qpix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> qpix;
+	        xml_parse_value(sub.c_str()+pos,qpix);
 	      }
 	    if (extract_xml_record(field,"v_mag",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> v_mag;
+	        xml_parse_value(sub.c_str()+pos,v_mag);
 	      }
 	    if (extract_xml_record(field,"b_minus_v",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> b_minus_v;
+	        xml_parse_value(sub.c_str()+pos,b_minus_v);
 	      }
 	    if (extract_xml_record(field,"parallax",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> parallax;
+	        xml_parse_value(sub.c_str()+pos,parallax);
 	      }
 	    if (extract_xml_record(field,"stellar_type",sub)) {
 	        pos=sub.find(">");
@@ -4699,14 +4587,12 @@ std::string star::print_xml(int full_subtables, int show_ids, int no_refs,const
 	    if (extract_xml_record(field,"planets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> planets;
+	        xml_parse_value(sub.c_str()+pos,planets);
 	      }
 	    if (extract_xml_record(field,"score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> score;
+	        xml_parse_value(sub.c_str()+pos,score);
 	      }
 	      }
 	      }
@@ -4926,29 +4812,34 @@ std::string candidate_count::print(int full_subtables, int show_ids, int no_refs
 
 std::string candidate_count::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void candidate_count::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<spikes>" << spikes << "</spikes>\n";
-	rv << xml_indent() << "<gaussians>" << gaussians << "</gaussians>\n";
-	rv << xml_indent() << "<pulses>" << pulses << "</pulses>\n";
-	rv << xml_indent() << "<triplets>" << triplets << "</triplets>\n";
-	rv << xml_indent() << "<spike_barycentric_multiplets>" << spike_barycentric_multiplets << "</spike_barycentric_multiplets>\n";
-	rv << xml_indent() << "<gaussian_barycentric_multiplets>" << gaussian_barycentric_multiplets << "</gaussian_barycentric_multiplets>\n";
-	rv << xml_indent() << "<pulse_barycentric_multiplets>" << pulse_barycentric_multiplets << "</pulse_barycentric_multiplets>\n";
-	rv << xml_indent() << "<triplet_barycentric_multiplets>" << triplet_barycentric_multiplets << "</triplet_barycentric_multiplets>\n";
-	rv << xml_indent() << "<spike_nonbarycentric_multiplets>" << spike_nonbarycentric_multiplets << "</spike_nonbarycentric_multiplets>\n";
-	rv << xml_indent() << "<gaussian_nonbarycentric_multiplets>" << gaussian_nonbarycentric_multiplets << "</gaussian_nonbarycentric_multiplets>\n";
-	rv << xml_indent() << "<pulse_nonbarycentric_multiplets>" << pulse_nonbarycentric_multiplets << "</pulse_nonbarycentric_multiplets>\n";
-	rv << xml_indent() << "<triplet_nonbarycentric_multiplets>" << triplet_nonbarycentric_multiplets << "</triplet_nonbarycentric_multiplets>\n";
-	rv << xml_indent() << "<stars>" << stars << "</stars>\n";
-	rv << xml_indent() << "<time_last_updated>" << time_last_updated << "</time_last_updated>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<spikes>" << spikes << "</spikes>\n";
+	rv.indent() << "<gaussians>" << gaussians << "</gaussians>\n";
+	rv.indent() << "<pulses>" << pulses << "</pulses>\n";
+	rv.indent() << "<triplets>" << triplets << "</triplets>\n";
+	rv.indent() << "<spike_barycentric_multiplets>" << spike_barycentric_multiplets << "</spike_barycentric_multiplets>\n";
+	rv.indent() << "<gaussian_barycentric_multiplets>" << gaussian_barycentric_multiplets << "</gaussian_barycentric_multiplets>\n";
+	rv.indent() << "<pulse_barycentric_multiplets>" << pulse_barycentric_multiplets << "</pulse_barycentric_multiplets>\n";
+	rv.indent() << "<triplet_barycentric_multiplets>" << triplet_barycentric_multiplets << "</triplet_barycentric_multiplets>\n";
+	rv.indent() << "<spike_nonbarycentric_multiplets>" << spike_nonbarycentric_multiplets << "</spike_nonbarycentric_multiplets>\n";
+	rv.indent() << "<gaussian_nonbarycentric_multiplets>" << gaussian_nonbarycentric_multiplets << "</gaussian_nonbarycentric_multiplets>\n";
+	rv.indent() << "<pulse_nonbarycentric_multiplets>" << pulse_nonbarycentric_multiplets << "</pulse_nonbarycentric_multiplets>\n";
+	rv.indent() << "<triplet_nonbarycentric_multiplets>" << triplet_nonbarycentric_multiplets << "</triplet_nonbarycentric_multiplets>\n";
+	rv.indent() << "<stars>" << stars << "</stars>\n";
+	rv.indent() << "<time_last_updated>" << time_last_updated << "</time_last_updated>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -4959,92 +4850,77 @@ std::string candidate_count::print_xml(int full_subtables, int show_ids, int no_
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"spikes",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> spikes;
+	        xml_parse_value(sub.c_str()+pos,spikes);
 	      }
 	    if (extract_xml_record(field,"gaussians",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> gaussians;
+	        xml_parse_value(sub.c_str()+pos,gaussians);
 	      }
 	    if (extract_xml_record(field,"pulses",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulses;
+	        xml_parse_value(sub.c_str()+pos,pulses);
 	      }
 	    if (extract_xml_record(field,"triplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> triplets;
+	        xml_parse_value(sub.c_str()+pos,triplets);
 	      }
 	    if (extract_xml_record(field,"spike_barycentric_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> spike_barycentric_multiplets;
+	        xml_parse_value(sub.c_str()+pos,spike_barycentric_multiplets);
 	      }
 	    if (extract_xml_record(field,"gaussian_barycentric_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> gaussian_barycentric_multiplets;
+	        xml_parse_value(sub.c_str()+pos,gaussian_barycentric_multiplets);
 	      }
 	    if (extract_xml_record(field,"pulse_barycentric_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulse_barycentric_multiplets;
+	        xml_parse_value(sub.c_str()+pos,pulse_barycentric_multiplets);
 	      }
 	    if (extract_xml_record(field,"triplet_barycentric_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> triplet_barycentric_multiplets;
+	        xml_parse_value(sub.c_str()+pos,triplet_barycentric_multiplets);
 	      }
 	    if (extract_xml_record(field,"spike_nonbarycentric_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> spike_nonbarycentric_multiplets;
+	        xml_parse_value(sub.c_str()+pos,spike_nonbarycentric_multiplets);
 	      }
 	    if (extract_xml_record(field,"gaussian_nonbarycentric_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> gaussian_nonbarycentric_multiplets;
+	        xml_parse_value(sub.c_str()+pos,gaussian_nonbarycentric_multiplets);
 	      }
 	    if (extract_xml_record(field,"pulse_nonbarycentric_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulse_nonbarycentric_multiplets;
+	        xml_parse_value(sub.c_str()+pos,pulse_nonbarycentric_multiplets);
 	      }
 	    if (extract_xml_record(field,"triplet_nonbarycentric_multiplets",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> triplet_nonbarycentric_multiplets;
+	        xml_parse_value(sub.c_str()+pos,triplet_nonbarycentric_multiplets);
 	      }
 	    if (extract_xml_record(field,"stars",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> stars;
+	        xml_parse_value(sub.c_str()+pos,stars);
 	      }
 	    if (extract_xml_record(field,"time_last_updated",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time_last_updated;
+	        xml_parse_value(sub.c_str()+pos,time_last_updated);
 	      }
 	      }
 	      }
@@ -5233,26 +5109,31 @@ std::string tape::print(int full_subtables, int show_ids, int no_refs) const
 
 std::string tape::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void tape::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	{
 	  std::string enc_field=xml_encode_string(name,std::min(strlen(name),sizeof(name)));
-	  rv << xml_indent() << "<name>";
+	  rv.indent() << "<name>";
 	  rv << enc_field << "</name>\n";
 	}
-	rv << xml_indent() << "<start_time>" << start_time << "</start_time>\n";
-	rv << xml_indent() << "<last_block_time>" << last_block_time << "</last_block_time>\n";
-	rv << xml_indent() << "<last_block_done>" << last_block_done << "</last_block_done>\n";
-	rv << xml_indent() << "<missed>" << missed << "</missed>\n";
-	rv << xml_indent() << "<tape_quality>" << tape_quality << "</tape_quality>\n";
-	rv << xml_indent() << "<beam>" << beam << "</beam>\n";
+	rv.indent() << "<start_time>" << start_time << "</start_time>\n";
+	rv.indent() << "<last_block_time>" << last_block_time << "</last_block_time>\n";
+	rv.indent() << "<last_block_done>" << last_block_done << "</last_block_done>\n";
+	rv.indent() << "<missed>" << missed << "</missed>\n";
+	rv.indent() << "<tape_quality>" << tape_quality << "</tape_quality>\n";
+	rv.indent() << "<beam>" << beam << "</beam>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -5263,8 +5144,7 @@ std::string tape::print_xml(int full_subtables, int show_ids, int no_refs,const
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"name",sub)) {
 	        pos=sub.find(">");
@@ -5279,38 +5159,32 @@ std::string tape::print_xml(int full_subtables, int show_ids, int no_refs,const
 	    if (extract_xml_record(field,"start_time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> start_time;
+	        xml_parse_value(sub.c_str()+pos,start_time);
 	      }
 	    if (extract_xml_record(field,"last_block_time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> last_block_time;
+	        xml_parse_value(sub.c_str()+pos,last_block_time);
 	      }
 	    if (extract_xml_record(field,"last_block_done",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> last_block_done;
+	        xml_parse_value(sub.c_str()+pos,last_block_done);
 	      }
 	    if (extract_xml_record(field,"missed",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> missed;
+	        xml_parse_value(sub.c_str()+pos,missed);
 	      }
 	    if (extract_xml_record(field,"tape_quality",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> tape_quality;
+	        xml_parse_value(sub.c_str()+pos,tape_quality);
 	      }
 	    if (extract_xml_record(field,"beam",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> beam;
+	        xml_parse_value(sub.c_str()+pos,beam);
 	      }
 	      }
 	      }
@@ -5485,44 +5359,49 @@ std::string settings::print(int full_subtables, int show_ids, int no_refs) const
 
 std::string settings::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void settings::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<active>" << active << "</active>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<active>" << active << "</active>\n";
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << recorder_cfg.print_xml(full_subtables,show_ids,no_refs,"recorder_cfg");
 	} else {
-	    rv << xml_indent() << "<recorder_cfg><id>" << recorder_cfg.id << "</id></recorder_cfg>\n";
+	    rv.indent() << "<recorder_cfg><id>" << recorder_cfg.id << "</id></recorder_cfg>\n";
 	  }
 	}
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << splitter_cfg.print_xml(full_subtables,show_ids,no_refs,"splitter_cfg");
 	} else {
-	    rv << xml_indent() << "<splitter_cfg><id>" << splitter_cfg.id << "</id></splitter_cfg>\n";
+	    rv.indent() << "<splitter_cfg><id>" << splitter_cfg.id << "</id></splitter_cfg>\n";
 	  }
 	}
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << analysis_cfg.print_xml(full_subtables,show_ids,no_refs,"analysis_cfg");
 	} else {
-	    rv << xml_indent() << "<analysis_cfg><id>" << analysis_cfg.id << "</id></analysis_cfg>\n";
+	    rv.indent() << "<analysis_cfg><id>" << analysis_cfg.id << "</id></analysis_cfg>\n";
 	  }
 	}
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << receiver_cfg.print_xml(full_subtables,show_ids,no_refs,"receiver_cfg");
 	} else {
-	    rv << xml_indent() << "<receiver_cfg><id>" << receiver_cfg.id << "</id></receiver_cfg>\n";
+	    rv.indent() << "<receiver_cfg><id>" << receiver_cfg.id << "</id></receiver_cfg>\n";
 	  }
 	}
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -5533,14 +5412,12 @@ std::string settings::print_xml(int full_subtables, int show_ids, int no_refs,co
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"active",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> active;
+	        xml_parse_value(sub.c_str()+pos,active);
 	      }
 	    if (extract_xml_record(field,"recorder_cfg",sub)) {
 	      recorder_cfg.parse_xml(sub,"recorder_cfg");
@@ -5741,58 +5618,63 @@ std::string workunit_grp::print(int full_subtables, int show_ids, int no_refs) c
 
 std::string workunit_grp::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void workunit_grp::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << tape_info.print_xml(full_subtables,show_ids,no_refs,"tape_info");
 	} else {
-	    rv << xml_indent() << "<tape_info><id>" << tape_info.id << "</id></tape_info>\n";
+	    rv.indent() << "<tape_info><id>" << tape_info.id << "</id></tape_info>\n";
 	  }
 	}
 	{
 	  std::string enc_field=xml_encode_string(name,std::min(strlen(name),sizeof(name)));
-	  rv << xml_indent() << "<name>";
+	  rv.indent() << "<name>";
 	  rv << enc_field << "</name>\n";
 	}
-	rv << data_desc.print_xml(full_subtables,show_ids,no_refs,"data_desc");
+	data_desc.print_xml(rv,full_subtables,show_ids,no_refs,"data_desc");
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << receiver_cfg.print_xml(full_subtables,show_ids,no_refs,"receiver_cfg");
 	} else {
-	    rv << xml_indent() << "<receiver_cfg><id>" << receiver_cfg.id << "</id></receiver_cfg>\n";
+	    rv.indent() << "<receiver_cfg><id>" << receiver_cfg.id << "</id></receiver_cfg>\n";
 	  }
 	}
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << recorder_cfg.print_xml(full_subtables,show_ids,no_refs,"recorder_cfg");
 	} else {
-	    rv << xml_indent() << "<recorder_cfg><id>" << recorder_cfg.id << "</id></recorder_cfg>\n";
+	    rv.indent() << "<recorder_cfg><id>" << recorder_cfg.id << "</id></recorder_cfg>\n";
 	  }
 	}
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << splitter_cfg.print_xml(full_subtables,show_ids,no_refs,"splitter_cfg");
 	} else {
-	    rv << xml_indent() << "<splitter_cfg><id>" << splitter_cfg.id << "</id></splitter_cfg>\n";
+	    rv.indent() << "<splitter_cfg><id>" << splitter_cfg.id << "</id></splitter_cfg>\n";
 	  }
 	}
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << analysis_cfg.print_xml(full_subtables,show_ids,no_refs,"analysis_cfg");
 	} else {
-	    rv << xml_indent() << "<analysis_cfg><id>" << analysis_cfg.id << "</id></analysis_cfg>\n";
+	    rv.indent() << "<analysis_cfg><id>" << analysis_cfg.id << "</id></analysis_cfg>\n";
 	  }
 	}
-	rv << xml_indent() << "<sb_id>" << sb_id << "</sb_id>\n";
-	rv << xml_indent() << "<iq_modified>" << iq_modified << "</iq_modified>\n";
+	rv.indent() << "<sb_id>" << sb_id << "</sb_id>\n";
+	rv.indent() << "<iq_modified>" << iq_modified << "</iq_modified>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -5803,8 +5685,7 @@ std::string workunit_grp::print_xml(int full_subtables, int show_ids, int no_ref
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"tape_info",sub)) {
 	      tape_info.parse_xml(sub,"tape_info");
@@ -5837,14 +5718,12 @@ std::string workunit_grp::print_xml(int full_subtables, int show_ids, int no_ref
 	    if (extract_xml_record(field,"sb_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> sb_id;
+	        xml_parse_value(sub.c_str()+pos,sb_id);
 	      }
 	    if (extract_xml_record(field,"iq_modified",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> iq_modified;
+	        xml_parse_value(sub.c_str()+pos,iq_modified);
 	      }
 	      }
 	      }
@@ -5998,29 +5877,34 @@ std::string workunit_header::print(int full_subtables, int show_ids, int no_refs
 
 std::string workunit_header::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void workunit_header::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	{
 	  std::string enc_field=xml_encode_string(name,std::min(strlen(name),sizeof(name)));
-	  rv << xml_indent() << "<name>";
+	  rv.indent() << "<name>";
 	  rv << enc_field << "</name>\n";
 	}
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << group_info.print_xml(full_subtables,show_ids,no_refs,"group_info");
 	} else {
-	    rv << xml_indent() << "<group_info><id>" << group_info.id << "</id></group_info>\n";
+	    rv.indent() << "<group_info><id>" << group_info.id << "</id></group_info>\n";
 	  }
 	}
-	rv << subband_desc.print_xml(full_subtables,show_ids,no_refs,"subband_desc");
-	rv << xml_indent() << "<sb_id>" << sb_id << "</sb_id>\n";
+	subband_desc.print_xml(rv,full_subtables,show_ids,no_refs,"subband_desc");
+	rv.indent() << "<sb_id>" << sb_id << "</sb_id>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -6031,8 +5915,7 @@ std::string workunit_header::print_xml(int full_subtables, int show_ids, int no_
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"name",sub)) {
 	        pos=sub.find(">");
@@ -6053,8 +5936,7 @@ std::string workunit_header::print_xml(int full_subtables, int show_ids, int no_
 	    if (extract_xml_record(field,"sb_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> sb_id;
+	        xml_parse_value(sub.c_str()+pos,sb_id);
 	      }
 	      }
 	      }
@@ -6217,30 +6099,35 @@ std::string result::print(int full_subtables, int show_ids, int no_refs) const
 
 std::string result::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void result::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<boinc_result>" << boinc_result << "</boinc_result>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<boinc_result>" << boinc_result << "</boinc_result>\n";
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << wuid.print_xml(full_subtables,show_ids,no_refs,"wuid");
 	} else {
-	    rv << xml_indent() << "<wuid><id>" << wuid.id << "</id></wuid>\n";
+	    rv.indent() << "<wuid><id>" << wuid.id << "</id></wuid>\n";
 	  }
 	}
-	rv << xml_indent() << "<received>" << received << "</received>\n";
-	rv << xml_indent() << "<hostid>" << hostid << "</hostid>\n";
-	rv << xml_indent() << "<versionid>" << versionid << "</versionid>\n";
-	rv << xml_indent() << "<return_code>" << return_code << "</return_code>\n";
-	rv << xml_indent() << "<overflow>" << overflow << "</overflow>\n";
-	rv << xml_indent() << "<reserved>" << reserved << "</reserved>\n";
-	rv << xml_indent() << "<sb_id>" << sb_id << "</sb_id>\n";
+	rv.indent() << "<received>" << received << "</received>\n";
+	rv.indent() << "<hostid>" << hostid << "</hostid>\n";
+	rv.indent() << "<versionid>" << versionid << "</versionid>\n";
+	rv.indent() << "<return_code>" << return_code << "</return_code>\n";
+	rv.indent() << "<overflow>" << overflow << "</overflow>\n";
+	rv.indent() << "<reserved>" << reserved << "</reserved>\n";
+	rv.indent() << "<sb_id>" << sb_id << "</sb_id>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -6251,14 +6138,12 @@ std::string result::print_xml(int full_subtables, int show_ids, int no_refs,cons
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"boinc_result",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> boinc_result;
+	        xml_parse_value(sub.c_str()+pos,boinc_result);
 	      }
 	    if (extract_xml_record(field,"wuid",sub)) {
 	      wuid.parse_xml(sub,"wuid");
@@ -6266,44 +6151,37 @@ std::string result::print_xml(int full_subtables, int show_ids, int no_refs,cons
 	    if (extract_xml_record(field,"received",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> received;
+	        xml_parse_value(sub.c_str()+pos,received);
 	      }
 	    if (extract_xml_record(field,"hostid",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> hostid;
+	        xml_parse_value(sub.c_str()+pos,hostid);
 	      }
 	    if (extract_xml_record(field,"versionid",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> versionid;
+	        xml_parse_value(sub.c_str()+pos,versionid);
 	      }
 	    if (extract_xml_record(field,"return_code",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> return_code;
+	        xml_parse_value(sub.c_str()+pos,return_code);
 	      }
 	    if (extract_xml_record(field,"overflow",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> overflow;
+	        xml_parse_value(sub.c_str()+pos,overflow);
 	      }
 	    if (extract_xml_record(field,"reserved",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> reserved;
+	        xml_parse_value(sub.c_str()+pos,reserved);
 	      }
 	    if (extract_xml_record(field,"sb_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> sb_id;
+	        xml_parse_value(sub.c_str()+pos,sb_id);
 	      }
 	      }
 	      }
@@ -6522,37 +6400,42 @@ std::string triplet::print(int full_subtables, int show_ids, int no_refs) const
 
 std::string triplet::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void triplet::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << result_id.print_xml(full_subtables,show_ids,no_refs,"result_id");
 	} else {
-	    rv << xml_indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
+	    rv.indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
 	  }
 	}
-	rv << xml_indent() << "<peak_power>" << peak_power << "</peak_power>\n";
-	rv << xml_indent() << "<mean_power>" << mean_power << "</mean_power>\n";
-	rv << xml_indent() << "<time>" << time << "</time>\n";
-	rv << xml_indent() << "<ra>" << ra << "</ra>\n";
-	rv << xml_indent() << "<decl>" << decl << "</decl>\n";
-	rv << xml_indent() << "<q_pix>" << q_pix << "</q_pix>\n";
-	rv << xml_indent() << "<freq>" << freq << "</freq>\n";
-	rv << xml_indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
-	rv << xml_indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
-	rv << xml_indent() << "<fft_len>" << fft_len << "</fft_len>\n";
-	rv << xml_indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
-	rv << xml_indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
-	rv << xml_indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
-	rv << xml_indent() << "<reserved>" << reserved << "</reserved>\n";
-	rv << xml_indent() << "<period>" << period << "</period>\n";
+	rv.indent() << "<peak_power>" << peak_power << "</peak_power>\n";
+	rv.indent() << "<mean_power>" << mean_power << "</mean_power>\n";
+	rv.indent() << "<time>" << time << "</time>\n";
+	rv.indent() << "<ra>" << ra << "</ra>\n";
+	rv.indent() << "<decl>" << decl << "</decl>\n";
+	rv.indent() << "<q_pix>" << q_pix << "</q_pix>\n";
+	rv.indent() << "<freq>" << freq << "</freq>\n";
+	rv.indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
+	rv.indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
+	rv.indent() << "<fft_len>" << fft_len << "</fft_len>\n";
+	rv.indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
+	rv.indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
+	rv.indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
+	rv.indent() << "<reserved>" << reserved << "</reserved>\n";
+	rv.indent() << "<period>" << period << "</period>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -6563,8 +6446,7 @@ std::string triplet::print_xml(int full_subtables, int show_ids, int no_refs,con
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"result_id",sub)) {
 	      result_id.parse_xml(sub,"result_id");
@@ -6572,92 +6454,77 @@ std::string triplet::print_xml(int full_subtables, int show_ids, int no_refs,con
 	    if (extract_xml_record(field,"peak_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> peak_power;
+	        xml_parse_value(sub.c_str()+pos,peak_power);
 	      }
 	    if (extract_xml_record(field,"mean_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_power;
+	        xml_parse_value(sub.c_str()+pos,mean_power);
 	      }
 	    if (extract_xml_record(field,"time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time;
+	        xml_parse_value(sub.c_str()+pos,time);
 	      }
 	    if (extract_xml_record(field,"ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra;
+	        xml_parse_value(sub.c_str()+pos,ra);
 	      }
 	    if (extract_xml_record(field,"decl",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> decl;
+	        xml_parse_value(sub.c_str()+pos,decl);
 	      }
 	    if (extract_xml_record(field,"q_pix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> q_pix;
+	        xml_parse_value(sub.c_str()+pos,q_pix);
 	      }
 	    if (extract_xml_record(field,"freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> freq;
+	        xml_parse_value(sub.c_str()+pos,freq);
 	      }
 	    if (extract_xml_record(field,"detection_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> detection_freq;
+	        xml_parse_value(sub.c_str()+pos,detection_freq);
 	      }
 	    if (extract_xml_record(field,"barycentric_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> barycentric_freq;
+	        xml_parse_value(sub.c_str()+pos,barycentric_freq);
 	      }
 	    if (extract_xml_record(field,"fft_len",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fft_len;
+	        xml_parse_value(sub.c_str()+pos,fft_len);
 	      }
 	    if (extract_xml_record(field,"chirp_rate",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chirp_rate;
+	        xml_parse_value(sub.c_str()+pos,chirp_rate);
 	      }
 	    if (extract_xml_record(field,"rfi_checked",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_checked;
+	        xml_parse_value(sub.c_str()+pos,rfi_checked);
 	      }
 	    if (extract_xml_record(field,"rfi_found",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_found;
+	        xml_parse_value(sub.c_str()+pos,rfi_found);
 	      }
 	    if (extract_xml_record(field,"reserved",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> reserved;
+	        xml_parse_value(sub.c_str()+pos,reserved);
 	      }
 	    if (extract_xml_record(field,"period",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> period;
+	        xml_parse_value(sub.c_str()+pos,period);
 	      }
 	      }
 	      }
@@ -6904,37 +6771,42 @@ std::string triplet_small::print(int full_subtables, int show_ids, int no_refs)
 
 std::string triplet_small::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void triplet_small::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << result_id.print_xml(full_subtables,show_ids,no_refs,"result_id");
 	} else {
-	    rv << xml_indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
+	    rv.indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
 	  }
 	}
-	rv << xml_indent() << "<peak_power>" << peak_power << "</peak_power>\n";
-	rv << xml_indent() << "<mean_power>" << mean_power << "</mean_power>\n";
-	rv << xml_indent() << "<time>" << time << "</time>\n";
-	rv << xml_indent() << "<ra>" << ra << "</ra>\n";
-	rv << xml_indent() << "<decl>" << decl << "</decl>\n";
-	rv << xml_indent() << "<q_pix>" << q_pix << "</q_pix>\n";
-	rv << xml_indent() << "<freq>" << freq << "</freq>\n";
-	rv << xml_indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
-	rv << xml_indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
-	rv << xml_indent() << "<fft_len>" << fft_len << "</fft_len>\n";
-	rv << xml_indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
-	rv << xml_indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
-	rv << xml_indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
-	rv << xml_indent() << "<reserved>" << reserved << "</reserved>\n";
-	rv << xml_indent() << "<period>" << period << "</period>\n";
+	rv.indent() << "<peak_power>" << peak_power << "</peak_power>\n";
+	rv.indent() << "<mean_power>" << mean_power << "</mean_power>\n";
+	rv.indent() << "<time>" << time << "</time>\n";
+	rv.indent() << "<ra>" << ra << "</ra>\n";
+	rv.indent() << "<decl>" << decl << "</decl>\n";
+	rv.indent() << "<q_pix>" << q_pix << "</q_pix>\n";
+	rv.indent() << "<freq>" << freq << "</freq>\n";
+	rv.indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
+	rv.indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
+	rv.indent() << "<fft_len>" << fft_len << "</fft_len>\n";
+	rv.indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
+	rv.indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
+	rv.indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
+	rv.indent() << "<reserved>" << reserved << "</reserved>\n";
+	rv.indent() << "<period>" << period << "</period>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -6945,8 +6817,7 @@ std::string triplet_small::print_xml(int full_subtables, int show_ids, int no_re
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"result_id",sub)) {
 	      result_id.parse_xml(sub,"result_id");
@@ -6954,92 +6825,77 @@ std::string triplet_small::print_xml(int full_subtables, int show_ids, int no_re
 	    if (extract_xml_record(field,"peak_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> peak_power;
+	        xml_parse_value(sub.c_str()+pos,peak_power);
 	      }
 	    if (extract_xml_record(field,"mean_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_power;
+	        xml_parse_value(sub.c_str()+pos,mean_power);
 	      }
 	    if (extract_xml_record(field,"time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time;
+	        xml_parse_value(sub.c_str()+pos,time);
 	      }
 	    if (extract_xml_record(field,"ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra;
+	        xml_parse_value(sub.c_str()+pos,ra);
 	      }
 	    if (extract_xml_record(field,"decl",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> decl;
+	        xml_parse_value(sub.c_str()+pos,decl);
 	      }
 	    if (extract_xml_record(field,"q_pix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> q_pix;
+	        xml_parse_value(sub.c_str()+pos,q_pix);
 	      }
 	    if (extract_xml_record(field,"freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> freq;
+	        xml_parse_value(sub.c_str()+pos,freq);
 	      }
 	    if (extract_xml_record(field,"detection_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> detection_freq;
+	        xml_parse_value(sub.c_str()+pos,detection_freq);
 	      }
 	    if (extract_xml_record(field,"barycentric_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> barycentric_freq;
+	        xml_parse_value(sub.c_str()+pos,barycentric_freq);
 	      }
 	    if (extract_xml_record(field,"fft_len",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fft_len;
+	        xml_parse_value(sub.c_str()+pos,fft_len);
 	      }
 	    if (extract_xml_record(field,"chirp_rate",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chirp_rate;
+	        xml_parse_value(sub.c_str()+pos,chirp_rate);
 	      }
 	    if (extract_xml_record(field,"rfi_checked",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_checked;
+	        xml_parse_value(sub.c_str()+pos,rfi_checked);
 	      }
 	    if (extract_xml_record(field,"rfi_found",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_found;
+	        xml_parse_value(sub.c_str()+pos,rfi_found);
 	      }
 	    if (extract_xml_record(field,"reserved",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> reserved;
+	        xml_parse_value(sub.c_str()+pos,reserved);
 	      }
 	    if (extract_xml_record(field,"period",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> period;
+	        xml_parse_value(sub.c_str()+pos,period);
 	      }
 	      }
 	      }
@@ -7311,46 +7167,51 @@ std::string gaussian::print(int full_subtables, int show_ids, int no_refs) const
 
 std::string gaussian::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void gaussian::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << result_id.print_xml(full_subtables,show_ids,no_refs,"result_id");
 	} else {
-	    rv << xml_indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
+	    rv.indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
 	  }
 	}
-	rv << xml_indent() << "<peak_power>" << peak_power << "</peak_power>\n";
-	rv << xml_indent() << "<mean_power>" << mean_power << "</mean_power>\n";
-	rv << xml_indent() << "<time>" << time << "</time>\n";
-	rv << xml_indent() << "<ra>" << ra << "</ra>\n";
-	rv << xml_indent() << "<decl>" << decl << "</decl>\n";
-	rv << xml_indent() << "<q_pix>" << q_pix << "</q_pix>\n";
-	rv << xml_indent() << "<freq>" << freq << "</freq>\n";
-	rv << xml_indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
-	rv << xml_indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
-	rv << xml_indent() << "<fft_len>" << fft_len << "</fft_len>\n";
-	rv << xml_indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
-	rv << xml_indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
-	rv << xml_indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
-	rv << xml_indent() << "<reserved>" << reserved << "</reserved>\n";
-	rv << xml_indent() << "<sigma>" << sigma << "</sigma>\n";
-	rv << xml_indent() << "<chisqr>" << chisqr << "</chisqr>\n";
-	rv << xml_indent() << "<null_chisqr>" << null_chisqr << "</null_chisqr>\n";
-	rv << xml_indent() << "<score>" << score << "</score>\n";
-	rv << xml_indent() << "<max_power>" << max_power << "</max_power>\n";
+	rv.indent() << "<peak_power>" << peak_power << "</peak_power>\n";
+	rv.indent() << "<mean_power>" << mean_power << "</mean_power>\n";
+	rv.indent() << "<time>" << time << "</time>\n";
+	rv.indent() << "<ra>" << ra << "</ra>\n";
+	rv.indent() << "<decl>" << decl << "</decl>\n";
+	rv.indent() << "<q_pix>" << q_pix << "</q_pix>\n";
+	rv.indent() << "<freq>" << freq << "</freq>\n";
+	rv.indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
+	rv.indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
+	rv.indent() << "<fft_len>" << fft_len << "</fft_len>\n";
+	rv.indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
+	rv.indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
+	rv.indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
+	rv.indent() << "<reserved>" << reserved << "</reserved>\n";
+	rv.indent() << "<sigma>" << sigma << "</sigma>\n";
+	rv.indent() << "<chisqr>" << chisqr << "</chisqr>\n";
+	rv.indent() << "<null_chisqr>" << null_chisqr << "</null_chisqr>\n";
+	rv.indent() << "<score>" << score << "</score>\n";
+	rv.indent() << "<max_power>" << max_power << "</max_power>\n";
 	if (pot.size()) {
 	  std::string enc_field=xml_encode_string(pot,pot.encoding);
-	  rv << xml_indent() << "<pot length=" << enc_field.size() << " encoding=\"" << xml_encoding_names[pot.encoding] << "\">"; 
+	  rv.indent() << "<pot length=" << enc_field.size() << " encoding=\"" << xml_encoding_names[pot.encoding] << "\">"; 
 	  rv << enc_field << "</pot>\n";
 	}
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -7361,8 +7222,7 @@ std::string gaussian::print_xml(int full_subtables, int show_ids, int no_refs,co
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"result_id",sub)) {
 	      result_id.parse_xml(sub,"result_id");
@@ -7370,116 +7230,97 @@ std::string gaussian::print_xml(int full_subtables, int show_ids, int no_refs,co
 	    if (extract_xml_record(field,"peak_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> peak_power;
+	        xml_parse_value(sub.c_str()+pos,peak_power);
 	      }
 	    if (extract_xml_record(field,"mean_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_power;
+	        xml_parse_value(sub.c_str()+pos,mean_power);
 	      }
 	    if (extract_xml_record(field,"time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time;
+	        xml_parse_value(sub.c_str()+pos,time);
 	      }
 	    if (extract_xml_record(field,"ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra;
+	        xml_parse_value(sub.c_str()+pos,ra);
 	      }
 	    if (extract_xml_record(field,"decl",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> decl;
+	        xml_parse_value(sub.c_str()+pos,decl);
 	      }
 	    if (extract_xml_record(field,"q_pix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> q_pix;
+	        xml_parse_value(sub.c_str()+pos,q_pix);
 	      }
 	    if (extract_xml_record(field,"freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> freq;
+	        xml_parse_value(sub.c_str()+pos,freq);
 	      }
 	    if (extract_xml_record(field,"detection_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> detection_freq;
+	        xml_parse_value(sub.c_str()+pos,detection_freq);
 	      }
 	    if (extract_xml_record(field,"barycentric_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> barycentric_freq;
+	        xml_parse_value(sub.c_str()+pos,barycentric_freq);
 	      }
 	    if (extract_xml_record(field,"fft_len",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fft_len;
+	        xml_parse_value(sub.c_str()+pos,fft_len);
 	      }
 	    if (extract_xml_record(field,"chirp_rate",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chirp_rate;
+	        xml_parse_value(sub.c_str()+pos,chirp_rate);
 	      }
 	    if (extract_xml_record(field,"rfi_checked",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_checked;
+	        xml_parse_value(sub.c_str()+pos,rfi_checked);
 	      }
 	    if (extract_xml_record(field,"rfi_found",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_found;
+	        xml_parse_value(sub.c_str()+pos,rfi_found);
 	      }
 	    if (extract_xml_record(field,"reserved",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> reserved;
+	        xml_parse_value(sub.c_str()+pos,reserved);
 	      }
 	    if (extract_xml_record(field,"sigma",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> sigma;
+	        xml_parse_value(sub.c_str()+pos,sigma);
 	      }
 	    if (extract_xml_record(field,"chisqr",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chisqr;
+	        xml_parse_value(sub.c_str()+pos,chisqr);
 	      }
 	    if (extract_xml_record(field,"null_chisqr",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> null_chisqr;
+	        xml_parse_value(sub.c_str()+pos,null_chisqr);
 	      }
 	    if (extract_xml_record(field,"score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> score;
+	        xml_parse_value(sub.c_str()+pos,score);
 	      }
 	    if (extract_xml_record(field,"max_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_power;
+	        xml_parse_value(sub.c_str()+pos,max_power);
 	      }
 	    if (extract_xml_record(field,"pot",sub)) {
 	        std::istringstream in(sub.c_str());
@@ -7769,41 +7610,46 @@ std::string gaussian_small::print(int full_subtables, int show_ids, int no_refs)
 
 std::string gaussian_small::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void gaussian_small::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << result_id.print_xml(full_subtables,show_ids,no_refs,"result_id");
 	} else {
-	    rv << xml_indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
+	    rv.indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
 	  }
 	}
-	rv << xml_indent() << "<peak_power>" << peak_power << "</peak_power>\n";
-	rv << xml_indent() << "<mean_power>" << mean_power << "</mean_power>\n";
-	rv << xml_indent() << "<time>" << time << "</time>\n";
-	rv << xml_indent() << "<ra>" << ra << "</ra>\n";
-	rv << xml_indent() << "<decl>" << decl << "</decl>\n";
-	rv << xml_indent() << "<q_pix>" << q_pix << "</q_pix>\n";
-	rv << xml_indent() << "<freq>" << freq << "</freq>\n";
-	rv << xml_indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
-	rv << xml_indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
-	rv << xml_indent() << "<fft_len>" << fft_len << "</fft_len>\n";
-	rv << xml_indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
-	rv << xml_indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
-	rv << xml_indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
-	rv << xml_indent() << "<reserved>" << reserved << "</reserved>\n";
-	rv << xml_indent() << "<sigma>" << sigma << "</sigma>\n";
-	rv << xml_indent() << "<chisqr>" << chisqr << "</chisqr>\n";
-	rv << xml_indent() << "<null_chisqr>" << null_chisqr << "</null_chisqr>\n";
-	rv << xml_indent() << "<score>" << score << "</score>\n";
-	rv << xml_indent() << "<max_power>" << max_power << "</max_power>\n";
+	rv.indent() << "<peak_power>" << peak_power << "</peak_power>\n";
+	rv.indent() << "<mean_power>" << mean_power << "</mean_power>\n";
+	rv.indent() << "<time>" << time << "</time>\n";
+	rv.indent() << "<ra>" << ra << "</ra>\n";
+	rv.indent() << "<decl>" << decl << "</decl>\n";
+	rv.indent() << "<q_pix>" << q_pix << "</q_pix>\n";
+	rv.indent() << "<freq>" << freq << "</freq>\n";
+	rv.indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
+	rv.indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
+	rv.indent() << "<fft_len>" << fft_len << "</fft_len>\n";
+	rv.indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
+	rv.indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
+	rv.indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
+	rv.indent() << "<reserved>" << reserved << "</reserved>\n";
+	rv.indent() << "<sigma>" << sigma << "</sigma>\n";
+	rv.indent() << "<chisqr>" << chisqr << "</chisqr>\n";
+	rv.indent() << "<null_chisqr>" << null_chisqr << "</null_chisqr>\n";
+	rv.indent() << "<score>" << score << "</score>\n";
+	rv.indent() << "<max_power>" << max_power << "</max_power>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -7814,8 +7660,7 @@ std::string gaussian_small::print_xml(int full_subtables, int show_ids, int no_r
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"result_id",sub)) {
 	      result_id.parse_xml(sub,"result_id");
@@ -7823,116 +7668,97 @@ std::string gaussian_small::print_xml(int full_subtables, int show_ids, int no_r
 	    if (extract_xml_record(field,"peak_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> peak_power;
+	        xml_parse_value(sub.c_str()+pos,peak_power);
 	      }
 	    if (extract_xml_record(field,"mean_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_power;
+	        xml_parse_value(sub.c_str()+pos,mean_power);
 	      }
 	    if (extract_xml_record(field,"time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time;
+	        xml_parse_value(sub.c_str()+pos,time);
 	      }
 	    if (extract_xml_record(field,"ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra;
+	        xml_parse_value(sub.c_str()+pos,ra);
 	      }
 	    if (extract_xml_record(field,"decl",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> decl;
+	        xml_parse_value(sub.c_str()+pos,decl);
 	      }
 	    if (extract_xml_record(field,"q_pix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> q_pix;
+	        xml_parse_value(sub.c_str()+pos,q_pix);
 	      }
 	    if (extract_xml_record(field,"freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> freq;
+	        xml_parse_value(sub.c_str()+pos,freq);
 	      }
 	    if (extract_xml_record(field,"detection_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> detection_freq;
+	        xml_parse_value(sub.c_str()+pos,detection_freq);
 	      }
 	    if (extract_xml_record(field,"barycentric_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> barycentric_freq;
+	        xml_parse_value(sub.c_str()+pos,barycentric_freq);
 	      }
 	    if (extract_xml_record(field,"fft_len",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fft_len;
+	        xml_parse_value(sub.c_str()+pos,fft_len);
 	      }
 	    if (extract_xml_record(field,"chirp_rate",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chirp_rate;
+	        xml_parse_value(sub.c_str()+pos,chirp_rate);
 	      }
 	    if (extract_xml_record(field,"rfi_checked",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_checked;
+	        xml_parse_value(sub.c_str()+pos,rfi_checked);
 	      }
 	    if (extract_xml_record(field,"rfi_found",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_found;
+	        xml_parse_value(sub.c_str()+pos,rfi_found);
 	      }
 	    if (extract_xml_record(field,"reserved",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> reserved;
+	        xml_parse_value(sub.c_str()+pos,reserved);
 	      }
 	    if (extract_xml_record(field,"sigma",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> sigma;
+	        xml_parse_value(sub.c_str()+pos,sigma);
 	      }
 	    if (extract_xml_record(field,"chisqr",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chisqr;
+	        xml_parse_value(sub.c_str()+pos,chisqr);
 	      }
 	    if (extract_xml_record(field,"null_chisqr",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> null_chisqr;
+	        xml_parse_value(sub.c_str()+pos,null_chisqr);
 	      }
 	    if (extract_xml_record(field,"score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> score;
+	        xml_parse_value(sub.c_str()+pos,score);
 	      }
 	    if (extract_xml_record(field,"max_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_power;
+	        xml_parse_value(sub.c_str()+pos,max_power);
 	      }
 	      }
 	      }
@@ -8220,46 +8046,51 @@ std::string pulse::print(int full_subtables, int show_ids, int no_refs) const
 
 std::string pulse::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void pulse::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << result_id.print_xml(full_subtables,show_ids,no_refs,"result_id");
 	} else {
-	    rv << xml_indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
+	    rv.indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
 	  }
 	}
-	rv << xml_indent() << "<peak_power>" << peak_power << "</peak_power>\n";
-	rv << xml_indent() << "<mean_power>" << mean_power << "</mean_power>\n";
-	rv << xml_indent() << "<time>" << time << "</time>\n";
-	rv << xml_indent() << "<ra>" << ra << "</ra>\n";
-	rv << xml_indent() << "<decl>" << decl << "</decl>\n";
-	rv << xml_indent() << "<q_pix>" << q_pix << "</q_pix>\n";
-	rv << xml_indent() << "<freq>" << freq << "</freq>\n";
-	rv << xml_indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
-	rv << xml_indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
-	rv << xml_indent() << "<fft_len>" << fft_len << "</fft_len>\n";
-	rv << xml_indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
-	rv << xml_indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
-	rv << xml_indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
-	rv << xml_indent() << "<reserved>" << reserved << "</reserved>\n";
-	rv << xml_indent() << "<period>" << period << "</period>\n";
-	rv << xml_indent() << "<snr>" << snr << "</snr>\n";
-	rv << xml_indent() << "<thresh>" << thresh << "</thresh>\n";
-	rv << xml_indent() << "<score>" << score << "</score>\n";
-	rv << xml_indent() << "<len_prof>" << len_prof << "</len_prof>\n";
+	rv.indent() << "<peak_power>" << peak_power << "</peak_power>\n";
+	rv.indent() << "<mean_power>" << mean_power << "</mean_power>\n";
+	rv.indent() << "<time>" << time << "</time>\n";
+	rv.indent() << "<ra>" << ra << "</ra>\n";
+	rv.indent() << "<decl>" << decl << "</decl>\n";
+	rv.indent() << "<q_pix>" << q_pix << "</q_pix>\n";
+	rv.indent() << "<freq>" << freq << "</freq>\n";
+	rv.indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
+	rv.indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
+	rv.indent() << "<fft_len>" << fft_len << "</fft_len>\n";
+	rv.indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
+	rv.indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
+	rv.indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
+	rv.indent() << "<reserved>" << reserved << "</reserved>\n";
+	rv.indent() << "<period>" << period << "</period>\n";
+	rv.indent() << "<snr>" << snr << "</snr>\n";
+	rv.indent() << "<thresh>" << thresh << "</thresh>\n";
+	rv.indent() << "<score>" << score << "</score>\n";
+	rv.indent() << "<len_prof>" << len_prof << "</len_prof>\n";
 	if (pot.size()) {
 	  std::string enc_field=xml_encode_string(pot,pot.encoding);
-	  rv << xml_indent() << "<pot length=" << enc_field.size() << " encoding=\"" << xml_encoding_names[pot.encoding] << "\">"; 
+	  rv.indent() << "<pot length=" << enc_field.size() << " encoding=\"" << xml_encoding_names[pot.encoding] << "\">"; 
 	  rv << enc_field << "</pot>\n";
 	}
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -8270,8 +8101,7 @@ std::string pulse::print_xml(int full_subtables, int show_ids, int no_refs,const
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"result_id",sub)) {
 	      result_id.parse_xml(sub,"result_id");
@@ -8279,116 +8109,97 @@ std::string pulse::print_xml(int full_subtables, int show_ids, int no_refs,const
 	    if (extract_xml_record(field,"peak_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> peak_power;
+	        xml_parse_value(sub.c_str()+pos,peak_power);
 	      }
 	    if (extract_xml_record(field,"mean_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_power;
+	        xml_parse_value(sub.c_str()+pos,mean_power);
 	      }
 	    if (extract_xml_record(field,"time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time;
+	        xml_parse_value(sub.c_str()+pos,time);
 	      }
 	    if (extract_xml_record(field,"ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra;
+	        xml_parse_value(sub.c_str()+pos,ra);
 	      }
 	    if (extract_xml_record(field,"decl",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> decl;
+	        xml_parse_value(sub.c_str()+pos,decl);
 	      }
 	    if (extract_xml_record(field,"q_pix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> q_pix;
+	        xml_parse_value(sub.c_str()+pos,q_pix);
 	      }
 	    if (extract_xml_record(field,"freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> freq;
+	        xml_parse_value(sub.c_str()+pos,freq);
 	      }
 	    if (extract_xml_record(field,"detection_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> detection_freq;
+	        xml_parse_value(sub.c_str()+pos,detection_freq);
 	      }
 	    if (extract_xml_record(field,"barycentric_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> barycentric_freq;
+	        xml_parse_value(sub.c_str()+pos,barycentric_freq);
 	      }
 	    if (extract_xml_record(field,"fft_len",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fft_len;
+	        xml_parse_value(sub.c_str()+pos,fft_len);
 	      }
 	    if (extract_xml_record(field,"chirp_rate",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chirp_rate;
+	        xml_parse_value(sub.c_str()+pos,chirp_rate);
 	      }
 	    if (extract_xml_record(field,"rfi_checked",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_checked;
+	        xml_parse_value(sub.c_str()+pos,rfi_checked);
 	      }
 	    if (extract_xml_record(field,"rfi_found",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_found;
+	        xml_parse_value(sub.c_str()+pos,rfi_found);
 	      }
 	    if (extract_xml_record(field,"reserved",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> reserved;
+	        xml_parse_value(sub.c_str()+pos,reserved);
 	      }
 	    if (extract_xml_record(field,"period",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> period;
+	        xml_parse_value(sub.c_str()+pos,period);
 	      }
 	    if (extract_xml_record(field,"snr",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> snr;
+	        xml_parse_value(sub.c_str()+pos,snr);
 	      }
 	    if (extract_xml_record(field,"thresh",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> thresh;
+	        xml_parse_value(sub.c_str()+pos,thresh);
 	      }
 	    if (extract_xml_record(field,"score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> score;
+	        xml_parse_value(sub.c_str()+pos,score);
 	      }
 	    if (extract_xml_record(field,"len_prof",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> len_prof;
+	        xml_parse_value(sub.c_str()+pos,len_prof);
 	      }
 	    if (extract_xml_record(field,"pot",sub)) {
 	        std::istringstream in(sub.c_str());
@@ -8673,40 +8484,45 @@ std::string pulse_small::print(int full_subtables, int show_ids, int no_refs) co
 
 std::string pulse_small::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void pulse_small::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << result_id.print_xml(full_subtables,show_ids,no_refs,"result_id");
 	} else {
-	    rv << xml_indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
+	    rv.indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
 	  }
 	}
-	rv << xml_indent() << "<peak_power>" << peak_power << "</peak_power>\n";
-	rv << xml_indent() << "<mean_power>" << mean_power << "</mean_power>\n";
-	rv << xml_indent() << "<time>" << time << "</time>\n";
-	rv << xml_indent() << "<ra>" << ra << "</ra>\n";
-	rv << xml_indent() << "<decl>" << decl << "</decl>\n";
-	rv << xml_indent() << "<q_pix>" << q_pix << "</q_pix>\n";
-	rv << xml_indent() << "<freq>" << freq << "</freq>\n";
-	rv << xml_indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
-	rv << xml_indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
-	rv << xml_indent() << "<fft_len>" << fft_len << "</fft_len>\n";
-	rv << xml_indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
-	rv << xml_indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
-	rv << xml_indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
-	rv << xml_indent() << "<reserved>" << reserved << "</reserved>\n";
-	rv << xml_indent() << "<period>" << period << "</period>\n";
-	rv << xml_indent() << "<snr>" << snr << "</snr>\n";
-	rv << xml_indent() << "<thresh>" << thresh << "</thresh>\n";
-	rv << xml_indent() << "<score>" << score << "</score>\n";
+	rv.indent() << "<peak_power>" << peak_power << "</peak_power>\n";
+	rv.indent() << "<mean_power>" << mean_power << "</mean_power>\n";
+	rv.indent() << "<time>" << time << "</time>\n";
+	rv.indent() << "<ra>" << ra << "</ra>\n";
+	rv.indent() << "<decl>" << decl << "</decl>\n";
+	rv.indent() << "<q_pix>" << q_pix << "</q_pix>\n";
+	rv.indent() << "<freq>" << freq << "</freq>\n";
+	rv.indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
+	rv.indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
+	rv.indent() << "<fft_len>" << fft_len << "</fft_len>\n";
+	rv.indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
+	rv.indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
+	rv.indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
+	rv.indent() << "<reserved>" << reserved << "</reserved>\n";
+	rv.indent() << "<period>" << period << "</period>\n";
+	rv.indent() << "<snr>" << snr << "</snr>\n";
+	rv.indent() << "<thresh>" << thresh << "</thresh>\n";
+	rv.indent() << "<score>" << score << "</score>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -8717,8 +8533,7 @@ std::string pulse_small::print_xml(int full_subtables, int show_ids, int no_refs
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"result_id",sub)) {
 	      result_id.parse_xml(sub,"result_id");
@@ -8726,110 +8541,92 @@ std::string pulse_small::print_xml(int full_subtables, int show_ids, int no_refs
 	    if (extract_xml_record(field,"peak_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> peak_power;
+	        xml_parse_value(sub.c_str()+pos,peak_power);
 	      }
 	    if (extract_xml_record(field,"mean_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_power;
+	        xml_parse_value(sub.c_str()+pos,mean_power);
 	      }
 	    if (extract_xml_record(field,"time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time;
+	        xml_parse_value(sub.c_str()+pos,time);
 	      }
 	    if (extract_xml_record(field,"ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra;
+	        xml_parse_value(sub.c_str()+pos,ra);
 	      }
 	    if (extract_xml_record(field,"decl",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> decl;
+	        xml_parse_value(sub.c_str()+pos,decl);
 	      }
 	    if (extract_xml_record(field,"q_pix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> q_pix;
+	        xml_parse_value(sub.c_str()+pos,q_pix);
 	      }
 	    if (extract_xml_record(field,"freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> freq;
+	        xml_parse_value(sub.c_str()+pos,freq);
 	      }
 	    if (extract_xml_record(field,"detection_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> detection_freq;
+	        xml_parse_value(sub.c_str()+pos,detection_freq);
 	      }
 	    if (extract_xml_record(field,"barycentric_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> barycentric_freq;
+	        xml_parse_value(sub.c_str()+pos,barycentric_freq);
 	      }
 	    if (extract_xml_record(field,"fft_len",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fft_len;
+	        xml_parse_value(sub.c_str()+pos,fft_len);
 	      }
 	    if (extract_xml_record(field,"chirp_rate",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chirp_rate;
+	        xml_parse_value(sub.c_str()+pos,chirp_rate);
 	      }
 	    if (extract_xml_record(field,"rfi_checked",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_checked;
+	        xml_parse_value(sub.c_str()+pos,rfi_checked);
 	      }
 	    if (extract_xml_record(field,"rfi_found",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_found;
+	        xml_parse_value(sub.c_str()+pos,rfi_found);
 	      }
 	    if (extract_xml_record(field,"reserved",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> reserved;
+	        xml_parse_value(sub.c_str()+pos,reserved);
 	      }
 	    if (extract_xml_record(field,"period",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> period;
+	        xml_parse_value(sub.c_str()+pos,period);
 	      }
 	    if (extract_xml_record(field,"snr",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> snr;
+	        xml_parse_value(sub.c_str()+pos,snr);
 	      }
 	    if (extract_xml_record(field,"thresh",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> thresh;
+	        xml_parse_value(sub.c_str()+pos,thresh);
 	      }
 	    if (extract_xml_record(field,"score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> score;
+	        xml_parse_value(sub.c_str()+pos,score);
 	      }
 	      }
 	      }
@@ -9032,21 +8829,26 @@ std::string sah_pointing::print(int full_subtables, int show_ids, int no_refs) c
 
 std::string sah_pointing::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void sah_pointing::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<time_id>" << time_id << "</time_id>\n";
-	rv << xml_indent() << "<time>" << time << "</time>\n";
-	rv << xml_indent() << "<ra>" << ra << "</ra>\n";
-	rv << xml_indent() << "<dec>" << dec << "</dec>\n";
-	rv << xml_indent() << "<q_pix>" << q_pix << "</q_pix>\n";
-	rv << xml_indent() << "<angle_range>" << angle_range << "</angle_range>\n";
-	rv << xml_indent() << "<bad>" << bad << "</bad>\n";
+	if (show_ids) rv.indent() << "<time_id>" << time_id << "</time_id>\n";
+	rv.indent() << "<time>" << time << "</time>\n";
+	rv.indent() << "<ra>" << ra << "</ra>\n";
+	rv.indent() << "<dec>" << dec << "</dec>\n";
+	rv.indent() << "<q_pix>" << q_pix << "</q_pix>\n";
+	rv.indent() << "<angle_range>" << angle_range << "</angle_range>\n";
+	rv.indent() << "<bad>" << bad << "</bad>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -9057,44 +8859,37 @@ std::string sah_pointing::print_xml(int full_subtables, int show_ids, int no_ref
 	    if (extract_xml_record(field,"time_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time_id;
+	        xml_parse_value(sub.c_str()+pos,time_id);
 	      }
 	    if (extract_xml_record(field,"time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time;
+	        xml_parse_value(sub.c_str()+pos,time);
 	      }
 	    if (extract_xml_record(field,"ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra;
+	        xml_parse_value(sub.c_str()+pos,ra);
 	      }
 	    if (extract_xml_record(field,"dec",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> dec;
+	        xml_parse_value(sub.c_str()+pos,dec);
 	      }
 	    if (extract_xml_record(field,"q_pix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> q_pix;
+	        xml_parse_value(sub.c_str()+pos,q_pix);
 	      }
 	    if (extract_xml_record(field,"angle_range",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> angle_range;
+	        xml_parse_value(sub.c_str()+pos,angle_range);
 	      }
 	    if (extract_xml_record(field,"bad",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> bad;
+	        xml_parse_value(sub.c_str()+pos,bad);
 	      }
 	      }
 	      }
@@ -9276,27 +9071,32 @@ std::string sky_map::print(int full_subtables, int show_ids, int no_refs) const
 
 std::string sky_map::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void sky_map::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<npix>" << npix << "</npix>\n";
-	rv << xml_indent() << "<qpix>" << qpix << "</qpix>\n";
-	rv << xml_indent() << "<fpix>" << fpix << "</fpix>\n";
-	rv << xml_indent() << "<spike_max_id>" << spike_max_id << "</spike_max_id>\n";
-	rv << xml_indent() << "<gaussian_max_id>" << gaussian_max_id << "</gaussian_max_id>\n";
-	rv << xml_indent() << "<pulse_max_id>" << pulse_max_id << "</pulse_max_id>\n";
-	rv << xml_indent() << "<triplet_max_id>" << triplet_max_id << "</triplet_max_id>\n";
-	rv << xml_indent() << "<spike_count>" << spike_count << "</spike_count>\n";
-	rv << xml_indent() << "<gaussian_count>" << gaussian_count << "</gaussian_count>\n";
-	rv << xml_indent() << "<pulse_count>" << pulse_count << "</pulse_count>\n";
-	rv << xml_indent() << "<triplet_count>" << triplet_count << "</triplet_count>\n";
-	rv << xml_indent() << "<new_data>" << new_data << "</new_data>\n";
-	rv << xml_indent() << "<score>" << score << "</score>\n";
+	if (show_ids) rv.indent() << "<npix>" << npix << "</npix>\n";
+	rv.indent() << "<qpix>" << qpix << "</qpix>\n";
+	rv.indent() << "<fpix>" << fpix << "</fpix>\n";
+	rv.indent() << "<spike_max_id>" << spike_max_id << "</spike_max_id>\n";
+	rv.indent() << "<gaussian_max_id>" << gaussian_max_id << "</gaussian_max_id>\n";
+	rv.indent() << "<pulse_max_id>" << pulse_max_id << "</pulse_max_id>\n";
+	rv.indent() << "<triplet_max_id>" << triplet_max_id << "</triplet_max_id>\n";
+	rv.indent() << "<spike_count>" << spike_count << "</spike_count>\n";
+	rv.indent() << "<gaussian_count>" << gaussian_count << "</gaussian_count>\n";
+	rv.indent() << "<pulse_count>" << pulse_count << "</pulse_count>\n";
+	rv.indent() << "<triplet_count>" << triplet_count << "</triplet_count>\n";
+	rv.indent() << "<new_data>" << new_data << "</new_data>\n";
+	rv.indent() << "<score>" << score << "</score>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -9307,80 +9107,67 @@ std::string sky_map::print_xml(int full_subtables, int show_ids, int no_refs,con
 	    if (extract_xml_record(field,"npix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> npix;
+	        xml_parse_value(sub.c_str()+pos,npix);
 	      }
 	    if (extract_xml_record(field,"qpix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> qpix;
+	        xml_parse_value(sub.c_str()+pos,qpix);
 	      }
 	    if (extract_xml_record(field,"fpix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fpix;
+	        xml_parse_value(sub.c_str()+pos,fpix);
 	      }
 	    if (extract_xml_record(field,"spike_max_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> spike_max_id;
+	        xml_parse_value(sub.c_str()+pos,spike_max_id);
 	      }
 	    if (extract_xml_record(field,"gaussian_max_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> gaussian_max_id;
+	        xml_parse_value(sub.c_str()+pos,gaussian_max_id);
 	      }
 	    if (extract_xml_record(field,"pulse_max_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulse_max_id;
+	        xml_parse_value(sub.c_str()+pos,pulse_max_id);
 	      }
 	    if (extract_xml_record(field,"triplet_max_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> triplet_max_id;
+	        xml_parse_value(sub.c_str()+pos,triplet_max_id);
 	      }
 	    if (extract_xml_record(field,"spike_count",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> spike_count;
+	        xml_parse_value(sub.c_str()+pos,spike_count);
 	      }
 	    if (extract_xml_record(field,"gaussian_count",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> gaussian_count;
+	        xml_parse_value(sub.c_str()+pos,gaussian_count);
 	      }
 	    if (extract_xml_record(field,"pulse_count",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> pulse_count;
+	        xml_parse_value(sub.c_str()+pos,pulse_count);
 	      }
 	    if (extract_xml_record(field,"triplet_count",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> triplet_count;
+	        xml_parse_value(sub.c_str()+pos,triplet_count);
 	      }
 	    if (extract_xml_record(field,"new_data",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> new_data;
+	        xml_parse_value(sub.c_str()+pos,new_data);
 	      }
 	    if (extract_xml_record(field,"score",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> score;
+	        xml_parse_value(sub.c_str()+pos,score);
 	      }
 	      }
 	      }
@@ -9531,16 +9318,21 @@ std::string hotpix::print(int full_subtables, int show_ids, int no_refs) const
 
 std::string hotpix::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void hotpix::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<last_hit_time>" << last_hit_time << "</last_hit_time>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<last_hit_time>" << last_hit_time << "</last_hit_time>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -9551,14 +9343,12 @@ std::string hotpix::print_xml(int full_subtables, int show_ids, int no_refs,cons
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"last_hit_time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> last_hit_time;
+	        xml_parse_value(sub.c_str()+pos,last_hit_time);
 	      }
 	      }
 	      }
@@ -9741,36 +9531,41 @@ std::string spike::print(int full_subtables, int show_ids, int no_refs) const
 
 std::string spike::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void spike::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << result_id.print_xml(full_subtables,show_ids,no_refs,"result_id");
 	} else {
-	    rv << xml_indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
+	    rv.indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
 	  }
 	}
-	rv << xml_indent() << "<peak_power>" << peak_power << "</peak_power>\n";
-	rv << xml_indent() << "<mean_power>" << mean_power << "</mean_power>\n";
-	rv << xml_indent() << "<time>" << time << "</time>\n";
-	rv << xml_indent() << "<ra>" << ra << "</ra>\n";
-	rv << xml_indent() << "<decl>" << decl << "</decl>\n";
-	rv << xml_indent() << "<q_pix>" << q_pix << "</q_pix>\n";
-	rv << xml_indent() << "<freq>" << freq << "</freq>\n";
-	rv << xml_indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
-	rv << xml_indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
-	rv << xml_indent() << "<fft_len>" << fft_len << "</fft_len>\n";
-	rv << xml_indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
-	rv << xml_indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
-	rv << xml_indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
-	rv << xml_indent() << "<reserved>" << reserved << "</reserved>\n";
+	rv.indent() << "<peak_power>" << peak_power << "</peak_power>\n";
+	rv.indent() << "<mean_power>" << mean_power << "</mean_power>\n";
+	rv.indent() << "<time>" << time << "</time>\n";
+	rv.indent() << "<ra>" << ra << "</ra>\n";
+	rv.indent() << "<decl>" << decl << "</decl>\n";
+	rv.indent() << "<q_pix>" << q_pix << "</q_pix>\n";
+	rv.indent() << "<freq>" << freq << "</freq>\n";
+	rv.indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
+	rv.indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
+	rv.indent() << "<fft_len>" << fft_len << "</fft_len>\n";
+	rv.indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
+	rv.indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
+	rv.indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
+	rv.indent() << "<reserved>" << reserved << "</reserved>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -9781,8 +9576,7 @@ std::string spike::print_xml(int full_subtables, int show_ids, int no_refs,const
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"result_id",sub)) {
 	      result_id.parse_xml(sub,"result_id");
@@ -9790,86 +9584,72 @@ std::string spike::print_xml(int full_subtables, int show_ids, int no_refs,const
 	    if (extract_xml_record(field,"peak_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> peak_power;
+	        xml_parse_value(sub.c_str()+pos,peak_power);
 	      }
 	    if (extract_xml_record(field,"mean_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_power;
+	        xml_parse_value(sub.c_str()+pos,mean_power);
 	      }
 	    if (extract_xml_record(field,"time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time;
+	        xml_parse_value(sub.c_str()+pos,time);
 	      }
 	    if (extract_xml_record(field,"ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra;
+	        xml_parse_value(sub.c_str()+pos,ra);
 	      }
 	    if (extract_xml_record(field,"decl",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> decl;
+	        xml_parse_value(sub.c_str()+pos,decl);
 	      }
 	    if (extract_xml_record(field,"q_pix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> q_pix;
+	        xml_parse_value(sub.c_str()+pos,q_pix);
 	      }
 	    if (extract_xml_record(field,"freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> freq;
+	        xml_parse_value(sub.c_str()+pos,freq);
 	      }
 	    if (extract_xml_record(field,"detection_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> detection_freq;
+	        xml_parse_value(sub.c_str()+pos,detection_freq);
 	      }
 	    if (extract_xml_record(field,"barycentric_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> barycentric_freq;
+	        xml_parse_value(sub.c_str()+pos,barycentric_freq);
 	      }
 	    if (extract_xml_record(field,"fft_len",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fft_len;
+	        xml_parse_value(sub.c_str()+pos,fft_len);
 	      }
 	    if (extract_xml_record(field,"chirp_rate",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chirp_rate;
+	        xml_parse_value(sub.c_str()+pos,chirp_rate);
 	      }
 	    if (extract_xml_record(field,"rfi_checked",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_checked;
+	        xml_parse_value(sub.c_str()+pos,rfi_checked);
 	      }
 	    if (extract_xml_record(field,"rfi_found",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_found;
+	        xml_parse_value(sub.c_str()+pos,rfi_found);
 	      }
 	    if (extract_xml_record(field,"reserved",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> reserved;
+	        xml_parse_value(sub.c_str()+pos,reserved);
 	      }
 	      }
 	      }
@@ -10107,36 +9887,41 @@ std::string spike_small::print(int full_subtables, int show_ids, int no_refs) co
 
 std::string spike_small::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void spike_small::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << result_id.print_xml(full_subtables,show_ids,no_refs,"result_id");
 	} else {
-	    rv << xml_indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
+	    rv.indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
 	  }
 	}
-	rv << xml_indent() << "<peak_power>" << peak_power << "</peak_power>\n";
-	rv << xml_indent() << "<mean_power>" << mean_power << "</mean_power>\n";
-	rv << xml_indent() << "<time>" << time << "</time>\n";
-	rv << xml_indent() << "<ra>" << ra << "</ra>\n";
-	rv << xml_indent() << "<decl>" << decl << "</decl>\n";
-	rv << xml_indent() << "<q_pix>" << q_pix << "</q_pix>\n";
-	rv << xml_indent() << "<freq>" << freq << "</freq>\n";
-	rv << xml_indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
-	rv << xml_indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
-	rv << xml_indent() << "<fft_len>" << fft_len << "</fft_len>\n";
-	rv << xml_indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
-	rv << xml_indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
-	rv << xml_indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
-	rv << xml_indent() << "<reserved>" << reserved << "</reserved>\n";
+	rv.indent() << "<peak_power>" << peak_power << "</peak_power>\n";
+	rv.indent() << "<mean_power>" << mean_power << "</mean_power>\n";
+	rv.indent() << "<time>" << time << "</time>\n";
+	rv.indent() << "<ra>" << ra << "</ra>\n";
+	rv.indent() << "<decl>" << decl << "</decl>\n";
+	rv.indent() << "<q_pix>" << q_pix << "</q_pix>\n";
+	rv.indent() << "<freq>" << freq << "</freq>\n";
+	rv.indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
+	rv.indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
+	rv.indent() << "<fft_len>" << fft_len << "</fft_len>\n";
+	rv.indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
+	rv.indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
+	rv.indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
+	rv.indent() << "<reserved>" << reserved << "</reserved>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -10147,8 +9932,7 @@ std::string spike_small::print_xml(int full_subtables, int show_ids, int no_refs
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"result_id",sub)) {
 	      result_id.parse_xml(sub,"result_id");
@@ -10156,86 +9940,72 @@ std::string spike_small::print_xml(int full_subtables, int show_ids, int no_refs
 	    if (extract_xml_record(field,"peak_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> peak_power;
+	        xml_parse_value(sub.c_str()+pos,peak_power);
 	      }
 	    if (extract_xml_record(field,"mean_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_power;
+	        xml_parse_value(sub.c_str()+pos,mean_power);
 	      }
 	    if (extract_xml_record(field,"time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time;
+	        xml_parse_value(sub.c_str()+pos,time);
 	      }
 	    if (extract_xml_record(field,"ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra;
+	        xml_parse_value(sub.c_str()+pos,ra);
 	      }
 	    if (extract_xml_record(field,"decl",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> decl;
+	        xml_parse_value(sub.c_str()+pos,decl);
 	      }
 	    if (extract_xml_record(field,"q_pix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> q_pix;
+	        xml_parse_value(sub.c_str()+pos,q_pix);
 	      }
 	    if (extract_xml_record(field,"freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> freq;
+	        xml_parse_value(sub.c_str()+pos,freq);
 	      }
 	    if (extract_xml_record(field,"detection_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> detection_freq;
+	        xml_parse_value(sub.c_str()+pos,detection_freq);
 	      }
 	    if (extract_xml_record(field,"barycentric_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> barycentric_freq;
+	        xml_parse_value(sub.c_str()+pos,barycentric_freq);
 	      }
 	    if (extract_xml_record(field,"fft_len",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fft_len;
+	        xml_parse_value(sub.c_str()+pos,fft_len);
 	      }
 	    if (extract_xml_record(field,"chirp_rate",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chirp_rate;
+	        xml_parse_value(sub.c_str()+pos,chirp_rate);
 	      }
 	    if (extract_xml_record(field,"rfi_checked",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_checked;
+	        xml_parse_value(sub.c_str()+pos,rfi_checked);
 	      }
 	    if (extract_xml_record(field,"rfi_found",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_found;
+	        xml_parse_value(sub.c_str()+pos,rfi_found);
 	      }
 	    if (extract_xml_record(field,"reserved",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> reserved;
+	        xml_parse_value(sub.c_str()+pos,reserved);
 	      }
 	      }
 	      }
@@ -10478,37 +10248,42 @@ std::string autocorr::print(int full_subtables, int show_ids, int no_refs) const
 
 std::string autocorr::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void autocorr::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << result_id.print_xml(full_subtables,show_ids,no_refs,"result_id");
 	} else {
-	    rv << xml_indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
+	    rv.indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
 	  }
 	}
-	rv << xml_indent() << "<peak_power>" << peak_power << "</peak_power>\n";
-	rv << xml_indent() << "<mean_power>" << mean_power << "</mean_power>\n";
-	rv << xml_indent() << "<time>" << time << "</time>\n";
-	rv << xml_indent() << "<ra>" << ra << "</ra>\n";
-	rv << xml_indent() << "<decl>" << decl << "</decl>\n";
-	rv << xml_indent() << "<q_pix>" << q_pix << "</q_pix>\n";
-	rv << xml_indent() << "<delay>" << delay << "</delay>\n";
-	rv << xml_indent() << "<freq>" << freq << "</freq>\n";
-	rv << xml_indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
-	rv << xml_indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
-	rv << xml_indent() << "<fft_len>" << fft_len << "</fft_len>\n";
-	rv << xml_indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
-	rv << xml_indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
-	rv << xml_indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
-	rv << xml_indent() << "<reserved>" << reserved << "</reserved>\n";
+	rv.indent() << "<peak_power>" << peak_power << "</peak_power>\n";
+	rv.indent() << "<mean_power>" << mean_power << "</mean_power>\n";
+	rv.indent() << "<time>" << time << "</time>\n";
+	rv.indent() << "<ra>" << ra << "</ra>\n";
+	rv.indent() << "<decl>" << decl << "</decl>\n";
+	rv.indent() << "<q_pix>" << q_pix << "</q_pix>\n";
+	rv.indent() << "<delay>" << delay << "</delay>\n";
+	rv.indent() << "<freq>" << freq << "</freq>\n";
+	rv.indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
+	rv.indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
+	rv.indent() << "<fft_len>" << fft_len << "</fft_len>\n";
+	rv.indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
+	rv.indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
+	rv.indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
+	rv.indent() << "<reserved>" << reserved << "</reserved>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -10519,8 +10294,7 @@ std::string autocorr::print_xml(int full_subtables, int show_ids, int no_refs,co
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"result_id",sub)) {
 	      result_id.parse_xml(sub,"result_id");
@@ -10528,92 +10302,77 @@ std::string autocorr::print_xml(int full_subtables, int show_ids, int no_refs,co
 	    if (extract_xml_record(field,"peak_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> peak_power;
+	        xml_parse_value(sub.c_str()+pos,peak_power);
 	      }
 	    if (extract_xml_record(field,"mean_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_power;
+	        xml_parse_value(sub.c_str()+pos,mean_power);
 	      }
 	    if (extract_xml_record(field,"time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time;
+	        xml_parse_value(sub.c_str()+pos,time);
 	      }
 	    if (extract_xml_record(field,"ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra;
+	        xml_parse_value(sub.c_str()+pos,ra);
 	      }
 	    if (extract_xml_record(field,"decl",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> decl;
+	        xml_parse_value(sub.c_str()+pos,decl);
 	      }
 	    if (extract_xml_record(field,"q_pix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> q_pix;
+	        xml_parse_value(sub.c_str()+pos,q_pix);
 	      }
 	    if (extract_xml_record(field,"delay",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> delay;
+	        xml_parse_value(sub.c_str()+pos,delay);
 	      }
 	    if (extract_xml_record(field,"freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> freq;
+	        xml_parse_value(sub.c_str()+pos,freq);
 	      }
 	    if (extract_xml_record(field,"detection_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> detection_freq;
+	        xml_parse_value(sub.c_str()+pos,detection_freq);
 	      }
 	    if (extract_xml_record(field,"barycentric_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> barycentric_freq;
+	        xml_parse_value(sub.c_str()+pos,barycentric_freq);
 	      }
 	    if (extract_xml_record(field,"fft_len",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fft_len;
+	        xml_parse_value(sub.c_str()+pos,fft_len);
 	      }
 	    if (extract_xml_record(field,"chirp_rate",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chirp_rate;
+	        xml_parse_value(sub.c_str()+pos,chirp_rate);
 	      }
 	    if (extract_xml_record(field,"rfi_checked",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_checked;
+	        xml_parse_value(sub.c_str()+pos,rfi_checked);
 	      }
 	    if (extract_xml_record(field,"rfi_found",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_found;
+	        xml_parse_value(sub.c_str()+pos,rfi_found);
 	      }
 	    if (extract_xml_record(field,"reserved",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> reserved;
+	        xml_parse_value(sub.c_str()+pos,reserved);
 	      }
 	      }
 	      }
@@ -10860,37 +10619,42 @@ std::string autocorr_small::print(int full_subtables, int show_ids, int no_refs)
 
 std::string autocorr_small::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void autocorr_small::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
 	if (!no_refs) {
 	  if (full_subtables) {
 	    rv << result_id.print_xml(full_subtables,show_ids,no_refs,"result_id");
 	} else {
-	    rv << xml_indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
+	    rv.indent() << "<result_id><id>" << result_id.id << "</id></result_id>\n";
 	  }
 	}
-	rv << xml_indent() << "<peak_power>" << peak_power << "</peak_power>\n";
-	rv << xml_indent() << "<mean_power>" << mean_power << "</mean_power>\n";
-	rv << xml_indent() << "<time>" << time << "</time>\n";
-	rv << xml_indent() << "<ra>" << ra << "</ra>\n";
-	rv << xml_indent() << "<decl>" << decl << "</decl>\n";
-	rv << xml_indent() << "<q_pix>" << q_pix << "</q_pix>\n";
-	rv << xml_indent() << "<delay>" << delay << "</delay>\n";
-	rv << xml_indent() << "<freq>" << freq << "</freq>\n";
-	rv << xml_indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
-	rv << xml_indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
-	rv << xml_indent() << "<fft_len>" << fft_len << "</fft_len>\n";
-	rv << xml_indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
-	rv << xml_indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
-	rv << xml_indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
-	rv << xml_indent() << "<reserved>" << reserved << "</reserved>\n";
+	rv.indent() << "<peak_power>" << peak_power << "</peak_power>\n";
+	rv.indent() << "<mean_power>" << mean_power << "</mean_power>\n";
+	rv.indent() << "<time>" << time << "</time>\n";
+	rv.indent() << "<ra>" << ra << "</ra>\n";
+	rv.indent() << "<decl>" << decl << "</decl>\n";
+	rv.indent() << "<q_pix>" << q_pix << "</q_pix>\n";
+	rv.indent() << "<delay>" << delay << "</delay>\n";
+	rv.indent() << "<freq>" << freq << "</freq>\n";
+	rv.indent() << "<detection_freq>" << detection_freq << "</detection_freq>\n";
+	rv.indent() << "<barycentric_freq>" << barycentric_freq << "</barycentric_freq>\n";
+	rv.indent() << "<fft_len>" << fft_len << "</fft_len>\n";
+	rv.indent() << "<chirp_rate>" << chirp_rate << "</chirp_rate>\n";
+	rv.indent() << "<rfi_checked>" << rfi_checked << "</rfi_checked>\n";
+	rv.indent() << "<rfi_found>" << rfi_found << "</rfi_found>\n";
+	rv.indent() << "<reserved>" << reserved << "</reserved>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -10901,8 +10665,7 @@ std::string autocorr_small::print_xml(int full_subtables, int show_ids, int no_r
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"result_id",sub)) {
 	      result_id.parse_xml(sub,"result_id");
@@ -10910,92 +10673,77 @@ std::string autocorr_small::print_xml(int full_subtables, int show_ids, int no_r
 	    if (extract_xml_record(field,"peak_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> peak_power;
+	        xml_parse_value(sub.c_str()+pos,peak_power);
 	      }
 	    if (extract_xml_record(field,"mean_power",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> mean_power;
+	        xml_parse_value(sub.c_str()+pos,mean_power);
 	      }
 	    if (extract_xml_record(field,"time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> time;
+	        xml_parse_value(sub.c_str()+pos,time);
 	      }
 	    if (extract_xml_record(field,"ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra;
+	        xml_parse_value(sub.c_str()+pos,ra);
 	      }
 	    if (extract_xml_record(field,"decl",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> decl;
+	        xml_parse_value(sub.c_str()+pos,decl);
 	      }
 	    if (extract_xml_record(field,"q_pix",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> q_pix;
+	        xml_parse_value(sub.c_str()+pos,q_pix);
 	      }
 	    if (extract_xml_record(field,"delay",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> delay;
+	        xml_parse_value(sub.c_str()+pos,delay);
 	      }
 	    if (extract_xml_record(field,"freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> freq;
+	        xml_parse_value(sub.c_str()+pos,freq);
 	      }
 	    if (extract_xml_record(field,"detection_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> detection_freq;
+	        xml_parse_value(sub.c_str()+pos,detection_freq);
 	      }
 	    if (extract_xml_record(field,"barycentric_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> barycentric_freq;
+	        xml_parse_value(sub.c_str()+pos,barycentric_freq);
 	      }
 	    if (extract_xml_record(field,"fft_len",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fft_len;
+	        xml_parse_value(sub.c_str()+pos,fft_len);
 	      }
 	    if (extract_xml_record(field,"chirp_rate",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> chirp_rate;
+	        xml_parse_value(sub.c_str()+pos,chirp_rate);
 	      }
 	    if (extract_xml_record(field,"rfi_checked",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_checked;
+	        xml_parse_value(sub.c_str()+pos,rfi_checked);
 	      }
 	    if (extract_xml_record(field,"rfi_found",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> rfi_found;
+	        xml_parse_value(sub.c_str()+pos,rfi_found);
 	      }
 	    if (extract_xml_record(field,"reserved",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> reserved;
+	        xml_parse_value(sub.c_str()+pos,reserved);
 	      }
 	      }
 	      }
@@ -11201,44 +10949,49 @@ std::string classic_versions::print(int full_subtables, int show_ids, int no_ref
 
 std::string classic_versions::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void classic_versions::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<ver_major>" << ver_major << "</ver_major>\n";
-	rv << xml_indent() << "<ver_minor>" << ver_minor << "</ver_minor>\n";
-	rv << xml_indent() << "<platformid>" << platformid << "</platformid>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<ver_major>" << ver_major << "</ver_major>\n";
+	rv.indent() << "<ver_minor>" << ver_minor << "</ver_minor>\n";
+	rv.indent() << "<platformid>" << platformid << "</platformid>\n";
 	{
 	  std::string enc_field=xml_encode_string(comment,std::min(strlen(comment),sizeof(comment)));
-	  rv << xml_indent() << "<comment>";
+	  rv.indent() << "<comment>";
 	  rv << enc_field << "</comment>\n";
 	}
 	{
 	  std::string enc_field=xml_encode_string(filename,std::min(strlen(filename),sizeof(filename)));
-	  rv << xml_indent() << "<filename>";
+	  rv.indent() << "<filename>";
 	  rv << enc_field << "</filename>\n";
 	}
 	{
 	  std::string enc_field=xml_encode_string(md5_cksum,std::min(strlen(md5_cksum),sizeof(md5_cksum)));
-	  rv << xml_indent() << "<md5_cksum>";
+	  rv.indent() << "<md5_cksum>";
 	  rv << enc_field << "</md5_cksum>\n";
 	}
 	{
 	  std::string enc_field=xml_encode_string(sum_cksum,std::min(strlen(sum_cksum),sizeof(sum_cksum)));
-	  rv << xml_indent() << "<sum_cksum>";
+	  rv.indent() << "<sum_cksum>";
 	  rv << enc_field << "</sum_cksum>\n";
 	}
 	{
 	  std::string enc_field=xml_encode_string(cksum_cksum,std::min(strlen(cksum_cksum),sizeof(cksum_cksum)));
-	  rv << xml_indent() << "<cksum_cksum>";
+	  rv.indent() << "<cksum_cksum>";
 	  rv << enc_field << "</cksum_cksum>\n";
 	}
-	rv << xml_indent() << "<file_cksum>" << file_cksum << "</file_cksum>\n";
+	rv.indent() << "<file_cksum>" << file_cksum << "</file_cksum>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -11249,26 +11002,22 @@ std::string classic_versions::print_xml(int full_subtables, int show_ids, int no
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"ver_major",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ver_major;
+	        xml_parse_value(sub.c_str()+pos,ver_major);
 	      }
 	    if (extract_xml_record(field,"ver_minor",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ver_minor;
+	        xml_parse_value(sub.c_str()+pos,ver_minor);
 	      }
 	    if (extract_xml_record(field,"platformid",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> platformid;
+	        xml_parse_value(sub.c_str()+pos,platformid);
 	      }
 	    if (extract_xml_record(field,"comment",sub)) {
 	        pos=sub.find(">");
@@ -11323,8 +11072,7 @@ std::string classic_versions::print_xml(int full_subtables, int show_ids, int no
 	    if (extract_xml_record(field,"file_cksum",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> file_cksum;
+	        xml_parse_value(sub.c_str()+pos,file_cksum);
 	      }
 	      }
 	      }
@@ -11473,18 +11221,23 @@ std::string classic_active_versions::print(int full_subtables, int show_ids, int
 
 std::string classic_active_versions::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void classic_active_versions::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<versionid>" << versionid << "</versionid>\n";
-	rv << xml_indent() << "<ver_major>" << ver_major << "</ver_major>\n";
-	rv << xml_indent() << "<ver_minor>" << ver_minor << "</ver_minor>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<versionid>" << versionid << "</versionid>\n";
+	rv.indent() << "<ver_major>" << ver_major << "</ver_major>\n";
+	rv.indent() << "<ver_minor>" << ver_minor << "</ver_minor>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -11495,26 +11248,22 @@ std::string classic_active_versions::print_xml(int full_subtables, int show_ids,
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"versionid",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> versionid;
+	        xml_parse_value(sub.c_str()+pos,versionid);
 	      }
 	    if (extract_xml_record(field,"ver_major",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ver_major;
+	        xml_parse_value(sub.c_str()+pos,ver_major);
 	      }
 	    if (extract_xml_record(field,"ver_minor",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ver_minor;
+	        xml_parse_value(sub.c_str()+pos,ver_minor);
 	      }
 	      }
 	      }
@@ -11629,16 +11378,21 @@ std::string classic_active_versionids::print(int full_subtables, int show_ids, i
 
 std::string classic_active_versionids::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void classic_active_versionids::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<versionid>" << versionid << "</versionid>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<versionid>" << versionid << "</versionid>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -11649,14 +11403,12 @@ std::string classic_active_versionids::print_xml(int full_subtables, int show_id
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"versionid",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> versionid;
+	        xml_parse_value(sub.c_str()+pos,versionid);
 	      }
 	      }
 	      }
@@ -11883,40 +11635,45 @@ std::string rfi_zone::print(int full_subtables, int show_ids, int no_refs) const
 
 std::string rfi_zone::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void rfi_zone::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
-	if (show_ids) rv << xml_indent() << "<id>" << id << "</id>\n";
-	rv << xml_indent() << "<min_receiver_s4id>" << min_receiver_s4id << "</min_receiver_s4id>\n";
-	rv << xml_indent() << "<max_receiver_s4id>" << max_receiver_s4id << "</max_receiver_s4id>\n";
-	rv << xml_indent() << "<min_splitter_config>" << min_splitter_config << "</min_splitter_config>\n";
-	rv << xml_indent() << "<max_splitter_config>" << max_splitter_config << "</max_splitter_config>\n";
-	rv << xml_indent() << "<min_analysis_config>" << min_analysis_config << "</min_analysis_config>\n";
-	rv << xml_indent() << "<max_analysis_config>" << max_analysis_config << "</max_analysis_config>\n";
-	rv << xml_indent() << "<min_tape_id>" << min_tape_id << "</min_tape_id>\n";
-	rv << xml_indent() << "<max_tape_id>" << max_tape_id << "</max_tape_id>\n";
-	rv << xml_indent() << "<min_workunit_id>" << min_workunit_id << "</min_workunit_id>\n";
-	rv << xml_indent() << "<max_workunit_id>" << max_workunit_id << "</max_workunit_id>\n";
-	rv << xml_indent() << "<min_result_id>" << min_result_id << "</min_result_id>\n";
-	rv << xml_indent() << "<max_result_id>" << max_result_id << "</max_result_id>\n";
-	rv << xml_indent() << "<min_time>" << min_time << "</min_time>\n";
-	rv << xml_indent() << "<max_time>" << max_time << "</max_time>\n";
-	rv << xml_indent() << "<central_baseband_freq>" << central_baseband_freq << "</central_baseband_freq>\n";
-	rv << xml_indent() << "<baseband_freq_width>" << baseband_freq_width << "</baseband_freq_width>\n";
-	rv << xml_indent() << "<central_detection_freq>" << central_detection_freq << "</central_detection_freq>\n";
-	rv << xml_indent() << "<detection_freq_width>" << detection_freq_width << "</detection_freq_width>\n";
-	rv << xml_indent() << "<central_period>" << central_period << "</central_period>\n";
-	rv << xml_indent() << "<period_width>" << period_width << "</period_width>\n";
-	rv << xml_indent() << "<fft_len_flags>" << fft_len_flags << "</fft_len_flags>\n";
-	rv << xml_indent() << "<signal_type_flags>" << signal_type_flags << "</signal_type_flags>\n";
-	rv << xml_indent() << "<ra>" << ra << "</ra>\n";
-	rv << xml_indent() << "<dec>" << dec << "</dec>\n";
-	rv << xml_indent() << "<angular_distance>" << angular_distance << "</angular_distance>\n";
+	if (show_ids) rv.indent() << "<id>" << id << "</id>\n";
+	rv.indent() << "<min_receiver_s4id>" << min_receiver_s4id << "</min_receiver_s4id>\n";
+	rv.indent() << "<max_receiver_s4id>" << max_receiver_s4id << "</max_receiver_s4id>\n";
+	rv.indent() << "<min_splitter_config>" << min_splitter_config << "</min_splitter_config>\n";
+	rv.indent() << "<max_splitter_config>" << max_splitter_config << "</max_splitter_config>\n";
+	rv.indent() << "<min_analysis_config>" << min_analysis_config << "</min_analysis_config>\n";
+	rv.indent() << "<max_analysis_config>" << max_analysis_config << "</max_analysis_config>\n";
+	rv.indent() << "<min_tape_id>" << min_tape_id << "</min_tape_id>\n";
+	rv.indent() << "<max_tape_id>" << max_tape_id << "</max_tape_id>\n";
+	rv.indent() << "<min_workunit_id>" << min_workunit_id << "</min_workunit_id>\n";
+	rv.indent() << "<max_workunit_id>" << max_workunit_id << "</max_workunit_id>\n";
+	rv.indent() << "<min_result_id>" << min_result_id << "</min_result_id>\n";
+	rv.indent() << "<max_result_id>" << max_result_id << "</max_result_id>\n";
+	rv.indent() << "<min_time>" << min_time << "</min_time>\n";
+	rv.indent() << "<max_time>" << max_time << "</max_time>\n";
+	rv.indent() << "<central_baseband_freq>" << central_baseband_freq << "</central_baseband_freq>\n";
+	rv.indent() << "<baseband_freq_width>" << baseband_freq_width << "</baseband_freq_width>\n";
+	rv.indent() << "<central_detection_freq>" << central_detection_freq << "</central_detection_freq>\n";
+	rv.indent() << "<detection_freq_width>" << detection_freq_width << "</detection_freq_width>\n";
+	rv.indent() << "<central_period>" << central_period << "</central_period>\n";
+	rv.indent() << "<period_width>" << period_width << "</period_width>\n";
+	rv.indent() << "<fft_len_flags>" << fft_len_flags << "</fft_len_flags>\n";
+	rv.indent() << "<signal_type_flags>" << signal_type_flags << "</signal_type_flags>\n";
+	rv.indent() << "<ra>" << ra << "</ra>\n";
+	rv.indent() << "<dec>" << dec << "</dec>\n";
+	rv.indent() << "<angular_distance>" << angular_distance << "</angular_distance>\n";
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -11927,158 +11684,132 @@ std::string rfi_zone::print_xml(int full_subtables, int show_ids, int no_refs,co
 	    if (extract_xml_record(field,"id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> id;
+	        xml_parse_value(sub.c_str()+pos,id);
 	      }
 	    if (extract_xml_record(field,"min_receiver_s4id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> min_receiver_s4id;
+	        xml_parse_value(sub.c_str()+pos,min_receiver_s4id);
 	      }
 	    if (extract_xml_record(field,"max_receiver_s4id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_receiver_s4id;
+	        xml_parse_value(sub.c_str()+pos,max_receiver_s4id);
 	      }
 	    if (extract_xml_record(field,"min_splitter_config",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> min_splitter_config;
+	        xml_parse_value(sub.c_str()+pos,min_splitter_config);
 	      }
 	    if (extract_xml_record(field,"max_splitter_config",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_splitter_config;
+	        xml_parse_value(sub.c_str()+pos,max_splitter_config);
 	      }
 	    if (extract_xml_record(field,"min_analysis_config",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> min_analysis_config;
+	        xml_parse_value(sub.c_str()+pos,min_analysis_config);
 	      }
 	    if (extract_xml_record(field,"max_analysis_config",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_analysis_config;
+	        xml_parse_value(sub.c_str()+pos,max_analysis_config);
 	      }
 	    if (extract_xml_record(field,"min_tape_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> min_tape_id;
+	        xml_parse_value(sub.c_str()+pos,min_tape_id);
 	      }
 	    if (extract_xml_record(field,"max_tape_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_tape_id;
+	        xml_parse_value(sub.c_str()+pos,max_tape_id);
 	      }
 	    if (extract_xml_record(field,"min_workunit_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> min_workunit_id;
+	        xml_parse_value(sub.c_str()+pos,min_workunit_id);
 	      }
 	    if (extract_xml_record(field,"max_workunit_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_workunit_id;
+	        xml_parse_value(sub.c_str()+pos,max_workunit_id);
 	      }
 	    if (extract_xml_record(field,"min_result_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> min_result_id;
+	        xml_parse_value(sub.c_str()+pos,min_result_id);
 	      }
 	    if (extract_xml_record(field,"max_result_id",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_result_id;
+	        xml_parse_value(sub.c_str()+pos,max_result_id);
 	      }
 	    if (extract_xml_record(field,"min_time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> min_time;
+	        xml_parse_value(sub.c_str()+pos,min_time);
 	      }
 	    if (extract_xml_record(field,"max_time",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> max_time;
+	        xml_parse_value(sub.c_str()+pos,max_time);
 	      }
 	    if (extract_xml_record(field,"central_baseband_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> central_baseband_freq;
+	        xml_parse_value(sub.c_str()+pos,central_baseband_freq);
 	      }
 	    if (extract_xml_record(field,"baseband_freq_width",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> baseband_freq_width;
+	        xml_parse_value(sub.c_str()+pos,baseband_freq_width);
 	      }
 	    if (extract_xml_record(field,"central_detection_freq",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> central_detection_freq;
+	        xml_parse_value(sub.c_str()+pos,central_detection_freq);
 	      }
 	    if (extract_xml_record(field,"detection_freq_width",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> detection_freq_width;
+	        xml_parse_value(sub.c_str()+pos,detection_freq_width);
 	      }
 	    if (extract_xml_record(field,"central_period",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> central_period;
+	        xml_parse_value(sub.c_str()+pos,central_period);
 	      }
 	    if (extract_xml_record(field,"period_width",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> period_width;
+	        xml_parse_value(sub.c_str()+pos,period_width);
 	      }
 	    if (extract_xml_record(field,"fft_len_flags",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> fft_len_flags;
+	        xml_parse_value(sub.c_str()+pos,fft_len_flags);
 	      }
 	    if (extract_xml_record(field,"signal_type_flags",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> signal_type_flags;
+	        xml_parse_value(sub.c_str()+pos,signal_type_flags);
 	      }
 	    if (extract_xml_record(field,"ra",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> ra;
+	        xml_parse_value(sub.c_str()+pos,ra);
 	      }
 	    if (extract_xml_record(field,"dec",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> dec;
+	        xml_parse_value(sub.c_str()+pos,dec);
 	      }
 	    if (extract_xml_record(field,"angular_distance",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> angular_distance;
+	        xml_parse_value(sub.c_str()+pos,angular_distance);
 	      }
 	      }
 	      }
@@ -12286,25 +12017,30 @@ std::string bad_data::print(int full_subtables, int show_ids, int no_refs) const
 
 std::string bad_data::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const 
 {
-	std::ostringstream rv("");
+	xml_string_writer rv;
 
-	rv.precision(14);
-	rv << xml_indent() << '<' << tag << ">\n";
+	print_xml(rv,full_subtables,show_ids,no_refs,tag);
+	return rv.str();
+}
+
+
+void bad_data::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const 
+{
+	rv.indent() << '<' << tag << ">\n";
 	xml_indent(2);
 	{
 	  std::string enc_field=xml_encode_string(name,std::min(strlen(name),sizeof(name)));
-	  rv << xml_indent() << "<name>";
+	  rv.indent() << "<name>";
 	  rv << enc_field << "</name>\n";
 	}
-	rv << xml_indent() << "<beam>" << beam << "</beam>\n";
+	rv.indent() << "<beam>" << beam << "</beam>\n";
 	{
 	  std::string enc_field=xml_encode_string(reason,std::min(strlen(reason),sizeof(reason)));
-	  rv << xml_indent() << "<reason>";
+	  rv.indent() << "<reason>";
 	  rv << enc_field << "</reason>\n";
 	}
 	xml_indent(-2);
-	rv << xml_indent() << "</" << tag << ">\n";
-	return rv.str();
+	rv.indent() << "</" << tag << ">\n";
 }
 
 
@@ -12325,8 +12061,7 @@ std::string bad_data::print_xml(int full_subtables, int show_ids, int no_refs,co
 	    if (extract_xml_record(field,"beam",sub)) {
 	        pos=sub.find(">");
 	        do { pos++; } while(sub[pos]=='\n');
-	        std::istringstream in(sub.c_str()+pos);
-	        in >> beam;
+	        xml_parse_value(sub.c_str()+pos,beam);
 	      }
 	    if (extract_xml_record(field,"reason",sub)) {
 	        pos=sub.find(">");
@@ -37,6 +37,7 @@ class  coordinate_t  : public db_type<coordinate_t> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="coordinate_t") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="coordinate_t") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="coordinate_t");
@@ -58,6 +59,7 @@ class  chirp_parameter_t  : public db_type<chirp_parameter_t> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="chirp_parameter_t") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="chirp_parameter_t") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="chirp_parameter_t");
@@ -81,6 +83,7 @@ class  subband_description_t  : public db_type<subband_description_t> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="subband_description_t") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="subband_description_t") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="subband_description_t");
@@ -109,6 +112,7 @@ class  data_description_t  : public db_type<data_description_t> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="data_description_t") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="data_description_t") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="data_description_t");
@@ -144,6 +148,7 @@ class  receiver_config  : public db_table<receiver_config> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="receiver_config") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="receiver_config") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="receiver_config");
@@ -169,6 +174,7 @@ class  recorder_config  : public db_table<recorder_config> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="recorder_config") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="recorder_config") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="recorder_config");
@@ -198,6 +204,7 @@ class  splitter_config  : public db_table<splitter_config> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="splitter_config") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="splitter_config") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="splitter_config");
@@ -256,6 +263,7 @@ class  analysis_config  : public db_table<analysis_config> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="analysis_config") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="analysis_config") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="analysis_config");
@@ -304,6 +312,7 @@ class  science_config  : public db_table<science_config> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="science_config") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="science_config") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="science_config");
@@ -328,6 +337,7 @@ class  candidate_t  : public db_type<candidate_t> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="candidate_t") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="candidate_t") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="candidate_t");
@@ -379,6 +389,7 @@ class  meta_candidate  : public db_table<meta_candidate> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="meta_candidate") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="meta_candidate") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="meta_candidate");
@@ -423,6 +434,7 @@ class  multiplet  : public db_table<multiplet> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="multiplet") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="multiplet") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="multiplet");
@@ -456,6 +468,7 @@ class  star  : public db_table<star> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="star") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="star") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="star");
@@ -490,6 +503,7 @@ class  candidate_count  : public db_table<candidate_count> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="candidate_count") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="candidate_count") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="candidate_count");
@@ -517,6 +531,7 @@ class  tape  : public db_table<tape> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="tape") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="tape") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="tape");
@@ -542,6 +557,7 @@ class  settings  : public db_table<settings> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="settings") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="settings") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="settings");
@@ -571,6 +587,7 @@ class  workunit_grp  : public db_table<workunit_grp> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="workunit_grp") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="workunit_grp") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="workunit_grp");
@@ -595,6 +612,7 @@ class  workunit_header  : public db_table<workunit_header> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="workunit_header") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="workunit_header") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="workunit_header");
@@ -625,6 +643,7 @@ class  result  : public db_table<result> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="result") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="result") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="result");
@@ -661,6 +680,7 @@ class  triplet  : public db_table<triplet> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="triplet") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="triplet") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="triplet");
@@ -697,6 +717,7 @@ class  triplet_small  : public db_table<triplet_small> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="triplet_small") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="triplet_small") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="triplet_small");
@@ -738,6 +759,7 @@ class  gaussian  : public db_table<gaussian> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="gaussian") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="gaussian") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="gaussian");
@@ -778,6 +800,7 @@ class  gaussian_small  : public db_table<gaussian_small> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="gaussian_small") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="gaussian_small") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="gaussian_small");
@@ -819,6 +842,7 @@ class  pulse  : public db_table<pulse> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="pulse") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="pulse") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="pulse");
@@ -858,6 +882,7 @@ class  pulse_small  : public db_table<pulse_small> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="pulse_small") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="pulse_small") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="pulse_small");
@@ -884,6 +909,7 @@ class  sah_pointing  : public db_table<sah_pointing> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="sah_pointing") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="sah_pointing") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="sah_pointing");
@@ -916,6 +942,7 @@ class  sky_map  : public db_table<sky_map> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="sky_map") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="sky_map") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="sky_map");
@@ -937,6 +964,7 @@ class  hotpix  : public db_table<hotpix> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="hotpix") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="hotpix") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="hotpix");
@@ -972,6 +1000,7 @@ class  spike  : public db_table<spike> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="spike") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="spike") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="spike");
@@ -1007,6 +1036,7 @@ class  spike_small  : public db_table<spike_small> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="spike_small") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="spike_small") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="spike_small");
@@ -1043,6 +1073,7 @@ class  autocorr  : public db_table<autocorr> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="autocorr") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="autocorr") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="autocorr");
@@ -1079,6 +1110,7 @@ class  autocorr_small  : public db_table<autocorr_small> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="autocorr_small") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="autocorr_small") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="autocorr_small");
@@ -1108,6 +1140,7 @@ class  classic_versions  : public db_table<classic_versions> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="classic_versions") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="classic_versions") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="classic_versions");
@@ -1131,6 +1164,7 @@ class  classic_active_versions  : public db_table<classic_active_versions> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="classic_active_versions") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="classic_active_versions") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="classic_active_versions");
@@ -1152,6 +1186,7 @@ class  classic_active_versionids  : public db_table<classic_active_versionids> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="classic_active_versionids") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="classic_active_versionids") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="classic_active_versionids");
@@ -1197,6 +1232,7 @@ class  rfi_zone  : public db_table<rfi_zone> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="rfi_zone") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="rfi_zone") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="rfi_zone");
@@ -1219,6 +1255,7 @@ class  bad_data  : public db_table<bad_data> {
 	std::string select_format() const;
 	std::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;
 	std::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="bad_data") const;
+	void print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag="bad_data") const;
 	void parse(const SQL_ROW &s);
 	void parse(const std::string &s);
 	void parse_xml(const std::string &s,const char *tag="bad_data");
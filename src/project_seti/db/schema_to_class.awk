@@ -346,6 +346,7 @@ BEGIN		{
 		  print "\tstd::string select_format() const;" >headerfile
 		  print "\tstd::string print(int full_subtables=0, int show_ids=1, int no_refs=0) const;" >headerfile
 		  print "\tstd::string print_xml(int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag=\""table"\") const;" >headerfile
+		  print "\tvoid print_xml(xml_writer &rv, int full_subtables=1, int show_ids=0, int no_refs=0,const char *tag=\""table"\") const;" >headerfile
                   print "\tvoid parse(const SQL_ROW &s);" >headerfile
                   print "\tvoid parse(const std::string &s);" >headerfile
 		  print "\tvoid parse_xml(const std::string &s,const char *tag=\""table"\");" >headerfile
@@ -559,9 +560,12 @@ BEGIN		{
 		  print "\treturn rv.str();\n}\n\n" >sourcefile
 
 		  print "std::string "table"::print_xml(int full_subtables, int show_ids, int no_refs,const char *tag) const " >sourcefile
-		  print "{\n\tstd::ostringstream rv(\"\");\n" >sourcefile
-		  print "\trv.precision(14);" >sourcefile
-		  print "\trv << xml_indent() << '<' << tag << \">\\n\";" >sourcefile
+		  print "{\n\txml_string_writer rv;\n" >sourcefile
+		  print "\tprint_xml(rv,full_subtables,show_ids,no_refs,tag);" >sourcefile
+		  print "\treturn rv.str();\n}\n\n" >sourcefile
+		  print "void "table"::print_xml(xml_writer &rv, int full_subtables, int show_ids, int no_refs,const char *tag) const " >sourcefile
+		  print "{" >sourcefile
+		  print "\trv.indent() << '<' << tag << \">\\n\";" >sourcefile
 		  print "\txml_indent(2);" >sourcefile
 		  for (i=1;i<nfields;i++) {
 		    if (type[i]=="r") {
@@ -569,10 +573,10 @@ BEGIN		{
 		      print "\t  if (full_subtables) {" > sourcefile
 		      print "\t    rv << "fields[i]".print_xml(full_subtables,show_ids,no_refs,\""fields[i]"\");" > sourcefile
 		      print "\t} else {" > sourcefile
-		      print "\t    rv << xml_indent() << \"<"fields[i]"><id>\" << "fields[i]".id << \"</id></"fields[i]">\\n\";" > sourcefile
+		      print "\t    rv.indent() << \"<"fields[i]"><id>\" << "fields[i]".id << \"</id></"fields[i]">\\n\";" > sourcefile
 		      print "\t  }\n\t}" > sourcefile
 		    } else if (type[i] == "t") {
-		      print "\trv << "fields[i]".print_xml(full_subtables,show_ids,no_refs,\""fields[i]"\");" > sourcefile
+		      print "\t"fields[i]".print_xml(rv,full_subtables,show_ids,no_refs,\""fields[i]"\");" > sourcefile
 		    } else if (index(type[i],"v")==1) {
 		      n=split(type[i],a," ")
 		      stype=a[n]
@@ -585,7 +589,7 @@ BEGIN		{
                         }
 		      }
 		      print "\tif ("fields[i]".size()) {" >sourcefile
-		      print "\t  rv << xml_indent() << \"<"fields[i]"\";" >sourcefile
+		      print "\t  rv.indent() << \"<"fields[i]"\";" >sourcefile
 		      print "\t  {\n\t    std::string enc_string="fields[i]".print_xml();" >sourcefile
 		      if (!sis_deftype) {
 		        print "\t    rv << \" length=\" << enc_string.size() << \" encoding=\\\"\" << xml_encoding_names["fields[i]".encoding] << \"\\\">\" ;" >sourcefile  
@@ -598,12 +602,12 @@ BEGIN		{
 		      print "\trv << \"</"fields[i]">\\n\"; " >sourcefile
 		    } else if (type[i]=="s") {
 		      print "\t{\n\t  std::string enc_field=xml_encode_string("fields[i]",std::min(strlen("fields[i]"),sizeof("fields[i]")));" > sourcefile
-		      print "\t  rv << xml_indent() << \"<"fields[i]">\";" > sourcefile
+		      print "\t  rv.indent() << \"<"fields[i]">\";" > sourcefile
 		      print "\t  rv << enc_field << \"</"fields[i]">\\n\";" >sourcefile
 		      print "\t}" >> sourcefile
 		    } else if (type[i]=="b") {
 		      print "\tif ("fields[i]".size()) {\n\t  std::string enc_field=xml_encode_string("fields[i]","fields[i]".encoding);" > sourcefile
-		      print "\t  rv << xml_indent() << \"<"fields[i]" length=\" << enc_field.size() << \" encoding=\\\"\" << xml_encoding_names["fields[i]".encoding] << \"\\\">\"; "> sourcefile
+		      print "\t  rv.indent() << \"<"fields[i]" length=\" << enc_field.size() << \" encoding=\\\"\" << xml_encoding_names["fields[i]".encoding] << \"\\\">\"; "> sourcefile
 		      print "\t  rv << enc_field << \"</"fields[i]">\\n\";" >sourcefile
 		      print "\t}" >> sourcefile
                     } else {
@@ -611,12 +615,12 @@ BEGIN		{
 		      if ((i==1) && (!is_typedef)) {
 		        printf("if (show_ids) ") > sourcefile
 		      } 
-		      print "rv << xml_indent() << \"<"fields[i]">\" << "fields[i]" << \"</"fields[i]">\\n\";" > sourcefile
+		      print "rv.indent() << \"<"fields[i]">\" << "fields[i]" << \"</"fields[i]">\\n\";" > sourcefile
 		    }
 		  }
 		  print "\txml_indent(-2);" >sourcefile
-		  print "\trv << xml_indent() << \"</\" << tag << \">\\n\";" >sourcefile
-		  print "\treturn rv.str();\n}\n\n" >sourcefile
+		  print "\trv.indent() << \"</\" << tag << \">\\n\";" >sourcefile
+		  print "}\n\n" >sourcefile
 		  print "\tvoid "table"::parse_xml(const std::string &s,const char *tag) {" >sourcefile
 		  print "\t  std::string field,sub;" > sourcefile
 		  print "\t  if (extract_xml_record(s,tag,field)) {"  >sourcefile
@@ -651,9 +655,8 @@ BEGIN		{
 		        print "\t      do {" > sourcefile
 			print "\t        if (pos!=std::string::npos) {" >sourcefile
 			print "\t          do { pos++; } while ((sub[pos]=='\\n') || (sub[pos]==','));" >sourcefile
-		        print "\t          std::istringstream in(std::string(sub.c_str()+pos)); " >sourcefile
 			print "\t          "stype" tmp;" >sourcefile
-			print "\t          in >> tmp;" >sourcefile
+			print "\t          xml_parse_value(sub.c_str()+pos,tmp);" >sourcefile
 			print "\t          "fields[i]".push_back(tmp);" >sourcefile
                         print "\t        }" >sourcefile
 			print "\t      } while ((pos=sub.find(\",\",pos)) != std::string::npos); " >sourcefile
@@ -664,8 +667,7 @@ BEGIN		{
 		      if ((type[i] != "s") && (type[i] != "b")) {
 		        print "\t        pos=sub.find(\">\");" >sourcefile
 		        print "\t        do { pos++; } while(sub[pos]=='\\n');" >sourcefile
-		        print "\t        std::istringstream in(sub.c_str()+pos);" >sourcefile
-		        print "\t        in >> "fields[i]";" > sourcefile
+		        print "\t        xml_parse_value(sub.c_str()+pos,"fields[i]");" > sourcefile
 		      } else if (type[i] == "b") {
 		        print "\t        std::istringstream in(sub.c_str());" >sourcefile
 		        print "\t        in >> "fields[i]";" >sourcefile
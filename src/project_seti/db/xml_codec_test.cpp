@@ -0,0 +1,304 @@
+// Checks the buffer codecs in xml_util.cpp (base64_encode_buf(),
+// x_setiathome_encode_buf() and the decoders) against the string based
+// templates they replaced, then times both.
+//
+// - encoding must give exactly what the old templates gave.  The old
+//   encoders read past the end of a partial final group, so they are only
+//   compared on whole groups.
+// - decoding the encoded data, and random garbage with junk between the
+//   lines, must give what the old decoders gave.  The old x-setiathome
+//   decoder did not stop at nbytes, so its input is followed by "</data>"
+//   as it is in a workunit.
+// - every length up to 300 bytes must decode back to the input.
+//
+// Not built by default.  Build it from this directory with something like
+//   g++ -O2 -DCLIENT -I. -I.. -I../client -I<boinc>/lib \
+//       xml_codec_test.cpp xml_util.cpp <boinc>/lib/libboinc.a -o xml_codec_test
+//
+// Usage: xml_codec_test [megabytes]
+//   megabytes  size of the timed buffer (16 by default)
+// Exits with 0 if there were no mismatches.
+
+#include "sah_config.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <sys/time.h>
+
+#include "xml_util.h"
+
+static double now() {
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + tv.tv_usec*1e-6;
+}
+
+// The templates from xml_util.h before the buffer codecs
+template <typename T>
+std::string old_base64_encode(const T *tbin, size_t n_elements) {
+  size_t nbytes=n_elements*sizeof(T);
+  const unsigned char *bin=(const unsigned char *)(tbin);
+  int count=0, offset=0, nleft;
+  const char crlf[]= {0xa,0xd,0x0};
+  std::string rv("");
+  rv.reserve(nbytes*4/3+nbytes*2/57);
+  char c[5];
+  for (nleft = (int)nbytes; nleft > 0; nleft -= 3) {
+    int i;
+    c[0] = (bin[offset]>>2) & 0x3f ;     // 6
+    c[1] = (bin[offset]<<4) & 0x3f | ((bin[offset+1]>>4)&0xf); // 2+4
+    c[2] = ((bin[offset+1]<<2)&0x3f) | ((bin[offset+2]>>6)&0x3);// 4+2
+    c[3] = bin[offset+2]&0x3f;    // 6
+    for (i=0;i<((nleft>3)?4:(nleft+1));i++) c[i]=encode_arr[c[i]];
+    for (;i<4;i++) c[i]='=';
+    c[4]=0;
+    rv+=c;
+    offset += 3;
+    count += 4;
+    if (count == 76 ) {
+      count = 0;
+      rv+=crlf;
+    }
+  }
+  rv+=crlf;
+  return rv;
+}
+
+template <typename T>
+std::vector<T> old_base64_decode(const char *data, size_t nbytes) {
+  const char *p=data,*eol,*eol2,*eos;
+  const char cr=0xa,lf=0xd;
+  char in[4],c[3];
+  int i;
+  std::vector<unsigned char> rv;
+  rv.reserve(nbytes*3/4);
+  while (p<(data+nbytes)) {
+    while (*p && (p<(data+nbytes)) && !isencchar(*p)) {
+      p++;
+    }
+    if (!(*p) || (p>=(data+nbytes))) break;
+    eol=strchr(p,cr);
+    eol2=strchr(p,lf);
+    eos=p+strlen(p);
+    if (eol) {
+      eol=std::min(eol,eos);
+    } else {
+      eol=eos;
+    }
+    if (eol && eol2) {
+      eol=std::min(eol,eol2);
+    }
+    for (;p<(eol-1);p+=4) {
+      for ( i=0;i<4;i++) {
+        if ((p[i]>='A') && (p[i]<='Z')) {
+          in[i]=p[i]-'A';
+        } else if ((p[i]>='a') && (p[i]<='z')) {
+          in[i]=p[i]-'a'+26;
+        } else if ((p[i]>='0') && (p[i]<='9')) {
+          in[i]=p[i]-'0'+52;
+        } else {
+          switch (p[i]) {
+            case '+': in[i]=62;
+              break;
+            case '/': in[i]=63;
+              break;
+            default : in[i]=0;
+          }
+        }
+      }
+      c[0]=(in[0]<<2) | ((in[1] >> 4) & 0x3);
+      c[1]=(in[1]<<4) | ((in[2] >> 2) & 0xf);
+      c[2]=(in[2]<<6) | in[3];
+      for ( i=0;i<3;i++) rv.push_back(c[i]);
+    }
+  }
+  if (rv.empty()) return std::vector<T>();
+  return std::vector<T>((T *)(&(rv[0])),(T *)(&(rv[0]))+rv.size()/sizeof(T));
+}
+
+template <typename T>
+std::string old_x_setiathome_encode(const T *tbin, size_t n_elements) {
+  size_t nbytes=n_elements*sizeof(T);
+  const unsigned char *bin=(const unsigned char *)(tbin);
+  int count=0, offset=0, nleft;
+  const char cr=0xa;
+  std::string rv("");
+  rv.reserve(nbytes*4/3+nbytes*2/48);
+  rv+="\n";
+  char c[5];
+  for (nleft = (int)nbytes; nleft > 0; nleft -= 3) {
+    c[0] = bin[offset]&0x3f;     // 6
+    c[1] = (bin[offset]>>6) | (bin[offset+1]<<2)&0x3f; // 2+4
+    c[2] = ((bin[offset+1]>>4)&0xf) | (bin[offset+2]<<4)&0x3f;// 4+2
+    c[3] = bin[offset+2]>>2;    // 6
+    for (int i=0;i<4;i++) c[i]+=0x20;
+    c[4]=0;
+    rv+=c;
+    offset += 3;
+    count += 4;
+    if (count == 64) {
+      count = 0;
+      rv+=cr;
+    }
+  }
+  rv+=cr;
+  return rv;
+}
+
+template <typename T>
+std::vector<T> old_x_setiathome_decode(const char *data, size_t nbytes) {
+  const char *p=data,*eol,*eol2,*eos;
+  char in[4],c[3];
+  int i;
+  std::vector<unsigned char> rv;
+  rv.reserve(nbytes*3/4);
+  while (p<(data+nbytes)) {
+    while ((*p<0x20) || (*p>0x60)) {
+      p++;
+    }
+    eol=strchr(p,'\n');
+    eol2=strchr(p,'\r');
+    eos=p+strlen(p);
+    if (eol) {
+      eol=std::min(eol,eos);
+    } else {
+      eol=eos;
+    }
+    if (eol && eol2) {
+      eol=std::min(eol,eol2);
+    }
+    for (;p<(eol-1);p+=4) {
+      memcpy(in,p,4);
+      for ( i=0;i<4;i++) in[i]-=0x20;
+      c[0]=in[0]&0x3f | in[1]<<6;
+      c[1]=in[1]>>2 | in[2]<<4;
+      c[2]=in[2]>>4 | in[3]<<2;
+      for ( i=0;i<3;i++) rv.push_back(c[i]);
+    }
+  }
+  if (rv.empty()) return std::vector<T>();
+  return std::vector<T>((T *)(&(rv[0])),(T *)(&(rv[0]))+rv.size()/sizeof(T));
+}
+
+typedef std::vector<unsigned char> bytes;
+
+// true if a starts with the n bytes of b
+static bool starts_with(const bytes &a, const unsigned char *b, size_t n) {
+  return (a.size()>=n) && (n==0 || !memcmp(&(a[0]),b,n));
+}
+
+// random lines of characters from chars, 0 to 19 groups of 4 each,
+// with 0 to 2 characters from junk in front of each
+static std::string garbage(const char *chars, int nchars, const char *junk, int njunk) {
+  std::string s;
+  int l, j;
+  for (l=rand()%8;l>0;l--) {
+    for (j=rand()%3;j>0;j--) s+=junk[rand()%njunk];
+    for (j=4*(rand()%20);j>0;j--) s+=chars[rand()%nchars];
+    s+='\n';
+  }
+  return s;
+}
+
+static char xs_chars[0x41];
+
+int main(int argc, char **argv) {
+  size_t N=((argc>1)?atoi(argv[1]):16)*1024*1024;
+  int i, n, errors=0;
+
+  srand(1);
+  for (i=0;i<0x41;i++) xs_chars[i]=(char)(0x20+i);
+
+  // encoding, and decoding the encoded data
+  for (n=0;n<3000;n+=((n<400)?3:301)) {
+    bytes v(n+8,0);
+    for (i=0;i<n;i++) v[i]=(unsigned char)rand();
+    std::string b_old=old_base64_encode(&(v[0]),n);
+    std::string b_new=base64_encode(&(v[0]),n);
+    std::string x_old=old_x_setiathome_encode(&(v[0]),n);
+    std::string x_new=x_setiathome_encode(&(v[0]),n);
+    if (b_old != b_new) {
+      printf("FAILED  base64 encode of %d bytes\n",n);
+      errors++;
+    }
+    if (x_old != x_new) {
+      printf("FAILED  x_setiathome encode of %d bytes\n",n);
+      errors++;
+    }
+    if (old_base64_decode<unsigned char>(b_new.c_str(),b_new.size()) !=
+        base64_decode<unsigned char>(b_new.c_str(),b_new.size())) {
+      printf("FAILED  base64 decode of %d bytes\n",n);
+      errors++;
+    }
+    std::string x_data=x_new+"</data>\n";
+    bytes d_old=old_x_setiathome_decode<unsigned char>(x_data.c_str(),x_new.size());
+    bytes d_new=x_setiathome_decode<unsigned char>(x_data.c_str(),x_new.size());
+    if (!starts_with(d_new,&(v[0]),n) || !starts_with(d_old,d_new.empty()?NULL:&(d_new[0]),d_new.size())) {
+      printf("FAILED  x_setiathome decode of %d bytes\n",n);
+      errors++;
+    }
+  }
+
+  // every length round trips, including partial final groups
+  for (n=1;n<300;n++) {
+    bytes v(n,0);
+    for (i=0;i<n;i++) v[i]=(unsigned char)rand();
+    std::string b=base64_encode(&(v[0]),n);
+    std::string x=x_setiathome_encode(&(v[0]),n);
+    if (b.size()!=base64_encoded_size(n) || x.size()!=x_setiathome_encoded_size(n) ||
+        !starts_with(base64_decode<unsigned char>(b.c_str(),b.size()),&(v[0]),n) ||
+        !starts_with(x_setiathome_decode<unsigned char>(x.c_str(),x.size()),&(v[0]),n)) {
+      printf("FAILED  round trip of %d bytes\n",n);
+      errors++;
+    }
+  }
+
+  // garbage
+  for (n=0;n<2000;n++) {
+    std::string s=garbage(encode_arr,64,"\n\r <>\x01\xff",7);
+    if (old_base64_decode<unsigned char>(s.c_str(),s.size()) !=
+        base64_decode<unsigned char>(s.c_str(),s.size())) {
+      printf("FAILED  base64 decode of garbage %d\n",n);
+      errors++;
+    }
+    s=garbage(xs_chars,0x41,"\n\r\x01\xff",4);
+    std::string s_data=s+"</data>\n";
+    bytes d_old=old_x_setiathome_decode<unsigned char>(s_data.c_str(),s.size());
+    bytes d_new=x_setiathome_decode<unsigned char>(s.c_str(),s.size());
+    if (!starts_with(d_old,d_new.empty()?NULL:&(d_new[0]),d_new.size())) {
+      printf("FAILED  x_setiathome decode of garbage %d\n",n);
+      errors++;
+    }
+  }
+  printf("%s  %d mismatches\n",errors?"FAILED":"ok     ",errors);
+
+  // timings in MB of binary data per second.  The old decoders call
+  // strlen() on every line, so they are timed on the first 256KB only.
+  bytes v(N+8,0);
+  for (size_t j=0;j<N;j++) v[j]=(unsigned char)rand();
+  std::string s, part;
+  bytes r;
+  double t, t_old, t_new;
+  size_t n_old, n_part=std::min(N,(size_t)256*1024);
+
+  t=now(); s=old_base64_encode(&(v[0]),N); t_old=now()-t;
+  t=now(); s=base64_encode(&(v[0]),N); t_new=now()-t;
+  printf("base64 encode        %8.1f -> %8.1f MB/s\n",N/1e6/t_old,N/1e6/t_new);
+  part=base64_encode(&(v[0]),n_part);
+  t=now(); n_old=old_base64_decode<unsigned char>(part.c_str(),part.size()).size(); t_old=now()-t;
+  t=now(); r=base64_decode<unsigned char>(s.c_str(),s.size()); t_new=now()-t;
+  printf("base64 decode        %8.1f -> %8.1f MB/s\n",n_old/1e6/t_old,r.size()/1e6/t_new);
+  t=now(); s=old_x_setiathome_encode(&(v[0]),N); t_old=now()-t;
+  t=now(); s=x_setiathome_encode(&(v[0]),N); t_new=now()-t;
+  printf("x_setiathome encode  %8.1f -> %8.1f MB/s\n",N/1e6/t_old,N/1e6/t_new);
+  part=x_setiathome_encode(&(v[0]),n_part);
+  t=now(); n_old=old_x_setiathome_decode<unsigned char>((part+"</data>\n").c_str(),part.size()).size(); t_old=now()-t;
+  t=now(); r=x_setiathome_decode<unsigned char>(s.c_str(),s.size()); t_new=now()-t;
+  printf("x_setiathome decode  %8.1f -> %8.1f MB/s\n",n_old/1e6/t_old,r.size()/1e6/t_new);
+
+  printf("%s\n", errors ? "FAILED" : "OK");
+  return errors ? 1 : 0;
+}
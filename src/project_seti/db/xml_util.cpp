@@ -109,6 +109,62 @@ using std::min;
 
 int xml_indent_level=0;
 
+xml_writer &xml_writer::put(const char *s, size_t len) {
+  if (n+len > sizeof(buf)) {
+    if (n && write(buf,n)) failed=true;
+    n=0;
+    if (len > sizeof(buf)) {
+      if (write(s,len)) failed=true;
+      return *this;
+    }
+  }
+  memcpy(buf+n,s,len);
+  n+=len;
+  return *this;
+}
+
+xml_writer &xml_writer::indent() {
+  static char spaces[XML_MAX_INDENT];
+  int i=min(xml_indent_level,XML_MAX_INDENT);
+  if (i>0) {
+    if (spaces[0]!=' ') memset(spaces,' ',XML_MAX_INDENT);
+    put(spaces,i);
+  }
+  return *this;
+}
+
+int xml_writer::flush() {
+  if (n && write(buf,n)) failed=true;
+  n=0;
+  return failed?-1:0;
+}
+
+xml_writer &xml_writer::operator <<(int i) {
+  char tmp[32];
+  return put(tmp,sprintf(tmp,"%d",i));
+}
+
+xml_writer &xml_writer::operator <<(long i) {
+  char tmp[32];
+  return put(tmp,sprintf(tmp,"%ld",i));
+}
+
+xml_writer &xml_writer::operator <<(unsigned int i) {
+  char tmp[32];
+  return put(tmp,sprintf(tmp,"%u",i));
+}
+
+xml_writer &xml_writer::operator <<(unsigned long i) {
+  char tmp[32];
+  return put(tmp,sprintf(tmp,"%lu",i));
+}
+
+// ostream with precision(14) and no floatfield set is "%.14g"
+xml_writer &xml_writer::operator <<(double d) {
+  char tmp[64];
+  return put(tmp,sprintf(tmp,"%.14g",d));
+}
+
 std::string xml_indent(int i) {
   if (i) xml_indent_level+=i;
   xml_indent_level = (xml_indent_level>0) ? xml_indent_level : 0;
@@ -518,6 +574,182 @@ bool isencchar(char c) {
   return rv;
 }
 
+// Tables for the buffer codecs below.  b64_pair and xs_pair give the two
+// output characters for each 12 bit half of a 3 byte group; b64_val is the
+// 6 bit value of each base64 character (0 for anything else, as in the
+// original decoder).
+static char b64_pair[4096][2];
+static char xs_pair[4096][2];
+static unsigned char b64_val[256];
+
+static struct codec_tables_init {
+  codec_tables_init() {
+    int i;
+    for (i=0;i<4096;i++) {
+      b64_pair[i][0]=encode_arr[i>>6];
+      b64_pair[i][1]=encode_arr[i&0x3f];
+      xs_pair[i][0]=(i&0x3f)+0x20;
+      xs_pair[i][1]=(i>>6)+0x20;
+    }
+    memset(b64_val,0,sizeof(b64_val));
+    for (i=0;i<64;i++) b64_val[(unsigned char)encode_arr[i]]=i;
+  }
+} codec_tables;
+
+// Finds the end of the line starting at p, as the original decoders did
+// with strchr() and strlen(), but without looking past end.
+static const char *line_end(const char *p, const char *end) {
+  while ((p<end) && *p && (*p!='\n') && (*p!='\r')) p++;
+  return p;
+}
+
+size_t base64_encoded_size(size_t nbytes) {
+  size_t groups=(nbytes+2)/3;
+  return groups*4+(groups/19)*2+2;
+}
+
+char *base64_encode_body(const unsigned char *bin, size_t nbytes, char *out) {
+  size_t offset=0;
+  int count=0;
+  unsigned int w;
+
+  for (;offset+3<=nbytes;offset+=3) {
+    w=(bin[offset]<<16) | (bin[offset+1]<<8) | bin[offset+2];
+    memcpy(out,b64_pair[w>>12],2);
+    memcpy(out+2,b64_pair[w&0xfff],2);
+    out+=4;
+    if (++count == 19) {
+      count=0;
+      *out++=0xa;
+      *out++=0xd;
+    }
+  }
+  if (offset<nbytes) {
+    // pad with zero bits, then '='
+    w=bin[offset]<<16;
+    if (offset+1<nbytes) w|=bin[offset+1]<<8;
+    memcpy(out,b64_pair[w>>12],2);
+    memcpy(out+2,b64_pair[w&0xfff],2);
+    if (offset+1>=nbytes) out[2]='=';
+    out[3]='=';
+    out+=4;
+    if (++count == 19) {
+      *out++=0xa;
+      *out++=0xd;
+    }
+  }
+  return out;
+}
+
+char *base64_encode_buf(const unsigned char *bin, size_t nbytes, char *out) {
+  out=base64_encode_body(bin,nbytes,out);
+  *out++=0xa;
+  *out++=0xd;
+  return out;
+}
+
+size_t base64_decoded_max(size_t nbytes) {
+  return (nbytes/4+2)*3;
+}
+
+size_t base64_decode_buf(const char *data, size_t nbytes, unsigned char *out) {
+  const char *p=data, *end=data+nbytes, *eol;
+  unsigned char *start=out;
+  unsigned char in[4];
+
+  while (p<end) {
+    while (*p && (p<end) && !isencchar(*p)) p++;
+    if (!(*p) || (p>=end)) break;
+    eol=line_end(p,end);
+    for (;p<(eol-1);p+=4) {
+      in[0]=b64_val[(unsigned char)p[0]];
+      in[1]=b64_val[(unsigned char)p[1]];
+      in[2]=b64_val[(unsigned char)p[2]];
+      in[3]=b64_val[(unsigned char)p[3]];
+      out[0]=(in[0]<<2) | ((in[1] >> 4) & 0x3);
+      out[1]=(in[1]<<4) | ((in[2] >> 2) & 0xf);
+      out[2]=(in[2]<<6) | in[3];
+      out+=3;
+    }
+    // a stray character at the end of a line used to loop forever
+    if (p<eol) p=eol;
+  }
+  return out-start;
+}
+
+size_t x_setiathome_encoded_size(size_t nbytes) {
+  size_t groups=(nbytes+2)/3;
+  return 1+groups*4+groups/16+1;
+}
+
+char *x_setiathome_encode_body(const unsigned char *bin, size_t nbytes, char *out) {
+  size_t offset=0;
+  int count=0;
+  unsigned int w;
+
+  // whole lines: 48 bytes in, 64 characters and a newline out
+  for (;offset+48<=nbytes;offset+=48) {
+    const unsigned char *b=bin+offset;
+    for (int i=0;i<48;i+=3) {
+      w=b[i] | (b[i+1]<<8) | (b[i+2]<<16);
+      memcpy(out,xs_pair[w&0xfff],2);
+      memcpy(out+2,xs_pair[w>>12],2);
+      out+=4;
+    }
+    *out++='\n';
+  }
+  for (;offset<nbytes;offset+=3) {
+    // a final partial group is padded with zeros
+    w=bin[offset];
+    if (offset+1<nbytes) w|=bin[offset+1]<<8;
+    if (offset+2<nbytes) w|=bin[offset+2]<<16;
+    memcpy(out,xs_pair[w&0xfff],2);
+    memcpy(out+2,xs_pair[w>>12],2);
+    out+=4;
+    if (++count == 16) {
+      count=0;
+      *out++='\n';
+    }
+  }
+  return out;
+}
+
+char *x_setiathome_encode_buf(const unsigned char *bin, size_t nbytes, char *out) {
+  *out++='\n';
+  out=x_setiathome_encode_body(bin,nbytes,out);
+  *out++='\n';
+  return out;
+}
+
+size_t x_setiathome_decoded_max(size_t nbytes) {
+  return (nbytes/4+2)*3;
+}
+
+size_t x_setiathome_decode_buf(const char *data, size_t nbytes, unsigned char *out) {
+  const char *p=data, *end=data+nbytes, *eol;
+  unsigned char *start=out;
+  char in[4];
+
+  while (p<end) {
+    while ((p<end) && ((*p<0x20) || (*p>0x60))) p++;
+    if (p>=end) break;
+    eol=line_end(p,end);
+    for (;p<(eol-1);p+=4) {
+      in[0]=p[0]-0x20;
+      in[1]=p[1]-0x20;
+      in[2]=p[2]-0x20;
+      in[3]=p[3]-0x20;
+      out[0]=in[0]&0x3f | in[1]<<6;
+      out[1]=in[1]>>2 | in[2]<<4;
+      out[2]=in[2]>>4 | in[3]<<2;
+      out+=3;
+    }
+    // a stray character at the end of a line used to loop forever
+    if (p<eol) p=eol;
+  }
+  return out-start;
+}
+
 bool isencchar85(char c) {
   bool rv=((c>='A') && (c<='Z'));
   rv|=((c>='a') && (c<='z'));
@@ -645,11 +877,14 @@ bool isxmldelim(char c) {
 	  (c==0));
 }
 
-// return true if the tag appears in the line
-//
-bool xml_match_tag(const char* buf, const char* tag) {
-    char tmp_tag[8192]={'<',0};
-    if (strlen(buf)==0) return false;
+// Finds the first "<tag" in buf that is followed by a delimiter.  A
+// trailing '>' or other delimiter on tag is ignored.  Returns NULL if the
+// tag isn't there.
+static const char *find_tag(const char *buf, const char *tag) {
+    char tmp_tag[8192];
+    size_t len;
+    tmp_tag[0]='<';
+    tmp_tag[1]=0;
     if (tag[0] == '<') {
       strlcpy(tmp_tag,tag,8192);
     } else {
@@ -659,11 +894,19 @@ bool xml_match_tag(const char* buf, const char* tag) {
     do {
       *(p--)=0;
     } while (isxmldelim(*p));
+    len=(p+1)-tmp_tag;
     while ((buf=strstr(buf,tmp_tag))) {
-      if (isxmldelim(buf[strlen(tmp_tag)])) return true;
+      if (isxmldelim(buf[len])) return buf;
       buf++;
     }
-    return false;
+    return NULL;
+}
+
+// return true if the tag appears in the line
+//
+bool xml_match_tag(const char* buf, const char* tag) {
+    if (buf[0]==0) return false;
+    return (find_tag(buf,tag) != NULL);
 }
 
 bool xml_match_tag(const std::string &s, const char* tag) {
@@ -671,42 +914,31 @@ bool xml_match_tag(const std::string &s, const char* tag) {
 }
 
 size_t xml_find_tag(const char* buf, const char* tag) {
-    const char *buf0=buf;
-    char tmp_tag[8192]={'<',0};
-    if (tag[0] == '<') {
-      strlcpy(tmp_tag,tag,8192);
-    } else {
-      strlcat(tmp_tag,tag,8192);
-    }
-    char *p=tmp_tag+strlen(tmp_tag);
-    do {
-      *(p--)=0;
-    } while (isxmldelim(*p));
-    while ((buf=strstr(buf,tmp_tag))) {
-      if (isxmldelim(buf[strlen(tmp_tag)])) return buf-buf0;
-      buf++;
-    }
-    return strlen(buf0);
+    const char *p=find_tag(buf,tag);
+    return p?(p-buf):strlen(buf);
 }
 
 std::string::size_type xml_find_tag(const std::string &s, const char* tag) {
-  std::string::size_type p=xml_find_tag(s.c_str(),tag);
-  return (p!=strlen(s.c_str()))?p:(std::string::npos); 
+  const char *p=find_tag(s.c_str(),tag);
+  return p?(p-s.c_str()):(std::string::npos); 
 }
 
+// The end tag is searched for in place, rather than in a copy of the rest
+// of the field, since the generated parse_xml() functions call this once
+// for every column of a row.
 bool extract_xml_record(const std::string &field, const char *tag, std::string &record) {
     char end_tag[256];
     sprintf(end_tag,"/%s",tag);
-    std::string::size_type j,k;
+    const char *s=field.c_str(),*j,*k;
+    size_t n;
 
     // find the start_tag
-    j=xml_find_tag(field,tag);
-    if (j==std::string::npos) return false;
+    if ((j=find_tag(s,tag)) == NULL) return false;
     // find the end tag
-    k=xml_find_tag(std::string(field,j,field.length()-j),end_tag);
-    if (k==std::string::npos) return false;
+    if ((k=find_tag(j,end_tag)) == NULL) return false;
 
-    record=std::string(field,j,k+strlen(end_tag)+1);
+    n=(k-j)+strlen(end_tag)+1;
+    record.assign(j,std::min(n,field.size()-(j-s)));
     return true;
 }
 
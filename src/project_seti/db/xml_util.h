@@ -73,6 +73,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
 #include <cstring>
 #include <string>
 #include <sstream>
@@ -260,85 +261,37 @@ extern const char *encode_arr85;
 bool isencchar(char c);
 bool isencchar85(char c);
 
+// Buffer versions of the base64 and x-setiathome codecs (in xml_util.cpp).
+// The encoders write exactly *_encoded_size() characters and return the
+// end of the output; *_encode_body() leaves off the leading/trailing line
+// breaks, so whole lines (57 bytes base64, 48 bytes x-setiathome) can be
+// encoded a piece at a time.  The decoders need *_decoded_max() bytes of
+// output space and return the number of bytes decoded.
+size_t base64_encoded_size(size_t nbytes);
+char *base64_encode_body(const unsigned char *bin, size_t nbytes, char *out);
+char *base64_encode_buf(const unsigned char *bin, size_t nbytes, char *out);
+size_t base64_decoded_max(size_t nbytes);
+size_t base64_decode_buf(const char *data, size_t nbytes, unsigned char *out);
+size_t x_setiathome_encoded_size(size_t nbytes);
+char *x_setiathome_encode_body(const unsigned char *bin, size_t nbytes, char *out);
+char *x_setiathome_encode_buf(const unsigned char *bin, size_t nbytes, char *out);
+size_t x_setiathome_decoded_max(size_t nbytes);
+size_t x_setiathome_decode_buf(const char *data, size_t nbytes, unsigned char *out);
+
 template <typename T>
 std::string base64_encode(const T *tbin, size_t n_elements) {
   size_t nbytes=n_elements*sizeof(T);
-  const unsigned char *bin=(const unsigned char *)(tbin);
-  int count=0, offset=0, nleft;
-  const char crlf[]= {0xa,0xd,0x0};
-  std::string rv("");
-  rv.reserve(nbytes*4/3+nbytes*2/57);
-  char c[5];
-  for (nleft = (int)nbytes; nleft > 0; nleft -= 3) {
-    int i;
-    c[0] = (bin[offset]>>2) & 0x3f ;     // 6
-    c[1] = (bin[offset]<<4) & 0x3f | ((bin[offset+1]>>4)&0xf); // 2+4
-    c[2] = ((bin[offset+1]<<2)&0x3f) | ((bin[offset+2]>>6)&0x3);// 4+2
-    c[3] = bin[offset+2]&0x3f;    // 6
-    for (i=0;i<((nleft>3)?4:(nleft+1));i++) c[i]=encode_arr[c[i]];
-    for (;i<4;i++) c[i]='=';
-    c[4]=0;
-    rv+=c;
-    offset += 3;
-    count += 4;
-    if (count == 76 ) {
-      count = 0;
-      rv+=crlf;
-    }
-  }
-  rv+=crlf;
+  std::string rv(base64_encoded_size(nbytes),'\0');
+  base64_encode_buf((const unsigned char *)(tbin),nbytes,&(rv[0]));
   return rv;
 }
 
 template <typename T>
 std::vector<T> base64_decode(const char *data, size_t nbytes) {
-  const char *p=data,*eol,*eol2,*eos;
-  const char cr=0xa,lf=0xd;
-  char in[4],c[3];
-  int i;
-  std::vector<unsigned char> rv;
-  rv.reserve(nbytes*3/4);
-  while (p<(data+nbytes)) {
-    while (*p && (p<(data+nbytes)) && !isencchar(*p)) {
-      *p++;
-    }
-    if (!(*p) || (p>=(data+nbytes))) break;
-    eol=strchr(p,cr);
-    eol2=strchr(p,lf);
-    eos=p+strlen(p);
-    if (eol) {
-      eol=std::min(eol,eos);
-    } else {
-      eol=eos;
-    }
-    if (eol && eol2) {
-      eol=std::min(eol,eol2);
-    }
-    for (;p<(eol-1);p+=4) {
-      for ( i=0;i<4;i++) {
-        if ((p[i]>='A') && (p[i]<='Z')) {
-          in[i]=p[i]-'A';
-        } else if ((p[i]>='a') && (p[i]<='z')) {
-          in[i]=p[i]-'a'+26;
-        } else if ((p[i]>='0') && (p[i]<='9')) {
-          in[i]=p[i]-'0'+52;
-        } else {
-          switch (p[i]) {
-            case '+': in[i]=62;
-              break;
-            case '/': in[i]=63;
-              break;
-            default : in[i]=0;
-          }
-        }
-      }
-      c[0]=(in[0]<<2) | ((in[1] >> 4) & 0x3);
-      c[1]=(in[1]<<4) | ((in[2] >> 2) & 0xf);
-      c[2]=(in[2]<<6) | in[3];
-      for ( i=0;i<3;i++) rv.push_back(c[i]);
-    }
-  }
-  return std::vector<T>((T *)(&(rv[0])),(T *)(&(rv[0]))+rv.size()/sizeof(T));
+  std::vector<T> rv(base64_decoded_max(nbytes)/sizeof(T)+1);
+  size_t n=base64_decode_buf(data,nbytes,(unsigned char *)(&(rv[0])));
+  rv.resize(n/sizeof(T));
+  return rv;
 }
 
 template <typename T>
@@ -463,65 +416,17 @@ std::vector<T> base85_decode(const char *data, size_t nbytes) {
 template <typename T>
 std::string x_setiathome_encode(const T *tbin, size_t n_elements) {
   size_t nbytes=n_elements*sizeof(T);
-  const unsigned char *bin=(const unsigned char *)(tbin);
-  int count=0, offset=0, nleft;
-  const char cr=0xa;
-  std::string rv("");
-  rv.reserve(nbytes*4/3+nbytes*2/48);
-  rv+="\n";
-  char c[5];
-  for (nleft = (int)nbytes; nleft > 0; nleft -= 3) {
-    c[0] = bin[offset]&0x3f;     // 6
-    c[1] = (bin[offset]>>6) | (bin[offset+1]<<2)&0x3f; // 2+4
-    c[2] = ((bin[offset+1]>>4)&0xf) | (bin[offset+2]<<4)&0x3f;// 4+2
-    c[3] = bin[offset+2]>>2;    // 6
-    for (int i=0;i<4;i++) c[i]+=0x20;
-    c[4]=0;
-    rv+=c;
-    offset += 3;
-    count += 4;
-    if (count == 64) {
-      count = 0;
-      rv+=cr;
-    }
-  }
-  rv+=cr;
+  std::string rv(x_setiathome_encoded_size(nbytes),'\0');
+  x_setiathome_encode_buf((const unsigned char *)(tbin),nbytes,&(rv[0]));
   return rv;
 }
 
-
 template <typename T>
 std::vector<T> x_setiathome_decode(const char *data, size_t nbytes) {
-  const char *p=data,*eol,*eol2,*eos;
-  char in[4],c[3];
-  int i;
-  std::vector<unsigned char> rv;
-  rv.reserve(nbytes*3/4);
-  while (p<(data+nbytes)) {
-    while ((*p<0x20) || (*p>0x60)) {
-      *p++;
-    }
-    eol=strchr(p,'\n');
-    eol2=strchr(p,'\r');
-    eos=p+strlen(p);
-    if (eol) {
-      eol=std::min(eol,eos);
-    } else {
-      eol=eos;
-    }
-    if (eol && eol2) {
-      eol=std::min(eol,eol2);
-    }
-    for (;p<(eol-1);p+=4) {
-      memcpy(in,p,4);
-      for ( i=0;i<4;i++) in[i]-=0x20;
-      c[0]=in[0]&0x3f | in[1]<<6;
-      c[1]=in[1]>>2 | in[2]<<4;
-      c[2]=in[2]>>4 | in[3]<<2;
-      for ( i=0;i<3;i++) rv.push_back(c[i]);
-    }
-  }
-  return std::vector<T>((T *)(&(rv[0])),(T *)(&(rv[0]))+rv.size()/sizeof(T));
+  std::vector<T> rv(x_setiathome_decoded_max(nbytes)/sizeof(T)+1);
+  size_t n=x_setiathome_decode_buf(data,nbytes,(unsigned char *)(&(rv[0])));
+  rv.resize(n/sizeof(T));
+  return rv;
 }
 
 template <typename T>
@@ -931,10 +836,76 @@ std::string xml_encode_string(const T *input,
   }
 }
 
+// Output for the generated print_xml(xml_writer &,...) functions.  Text is
+// collected in a fixed buffer that is handed to write() when it fills up and
+// by flush(), so printing a row doesn't build any temporary strings.
+// Numbers come out as they would from an ostream with precision(14).
+class xml_writer {
+  public:
+    xml_writer() : n(0), failed(false) {};
+    virtual ~xml_writer() {};
+    xml_writer &put(const char *s, size_t len);
+    xml_writer &indent();
+    // returns -1 if any write() failed
+    int flush();
+
+    xml_writer &operator <<(const char *s) { return put(s,strlen(s)); };
+    xml_writer &operator <<(const std::string &s) { return put(s.data(),s.size()); };
+    xml_writer &operator <<(char c) { return put(&c,1); };
+    xml_writer &operator <<(int i);
+    xml_writer &operator <<(long i);
+    xml_writer &operator <<(unsigned int i);
+    xml_writer &operator <<(unsigned long i);
+    xml_writer &operator <<(double d);
+    xml_writer &operator <<(float f) { return *this << (double)f; };
+    // anything else goes through an ostream
+    template <typename T>
+    xml_writer &operator <<(const T &v) {
+      std::ostringstream o;
+      o.precision(14);
+      o << v;
+      return *this << o.str();
+    };
+
+  protected:
+    virtual int write(const char *p, size_t len)=0;
+
+  private:
+    char buf[4096];
+    size_t n;
+    bool failed;
+};
+
+// An xml_writer that appends to a string, for print_xml(...) itself.
+class xml_string_writer : public xml_writer {
+  public:
+    const std::string &str() { flush(); return s; };
+  protected:
+    int write(const char *p, size_t len) { s.append(p,len); return 0; };
+  private:
+    std::string s;
+};
+
 extern bool xml_match_tag(const char*, const char*);
 extern bool xml_match_tag(const std::string &, const char*);
 extern bool extract_xml_record(const std::string &field, const char *tag, std::string &record);
 
+// Reads a value from the text of an element for the generated parse_xml()
+// functions.  The common arithmetic types are converted directly rather
+// than through an istringstream, which costs a locale setup per field.
+template <typename T>
+inline void xml_parse_value(const char *s, T &value) {
+  std::istringstream in(s);
+  in >> value;
+}
+
+inline void xml_parse_value(const char *s, int &value) { value=(int)strtol(s,NULL,10); }
+inline void xml_parse_value(const char *s, long &value) { value=strtol(s,NULL,10); }
+inline void xml_parse_value(const char *s, unsigned int &value) { value=(unsigned int)strtoul(s,NULL,10); }
+inline void xml_parse_value(const char *s, unsigned long &value) { value=strtoul(s,NULL,10); }
+inline void xml_parse_value(const char *s, float &value) { value=(float)strtod(s,NULL); }
+inline void xml_parse_value(const char *s, double &value) { value=strtod(s,NULL); }
+
 #endif
 //
 // $Log: xml_util.h,v $
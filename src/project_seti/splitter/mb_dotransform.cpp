@@ -49,29 +49,14 @@ void output_samples(float *data, int i, int buf_pos) {
 }
 
 void splitter_bits_to_float(unsigned short *raw, float *data, int nsamples) {
-    unsigned int i, j;
-    unsigned short s;
-    static int first_time=1;
-    static float lut[65536][16];
-
+    // The tape data is in native 16 bit words, the real part in the low bit
+    // of each pair.
     assert(!(nsamples % 8));
-
-    if (first_time) {
-      for (i=0;i<65536;i++) {
-	s=(unsigned short)i;
-	for (j=0;j<8;j++) {
-	    lut[i][j*2]=(float)2*(s & 1)-1;
-	    s >>= 1;
-	    lut[i][j*2+1]=(float)2*(s & 1)-1;
-            s >>= 1;
-        }
-      }
-      first_time--;
-    }
-
-    for (i=0;i<(nsamples/8);i++) {
-      memcpy(data+16*i,lut[raw[i]],16*sizeof(float));
-    }
+#ifdef WORDS_BIGENDIAN
+    unpack_2bit_samples((const unsigned char *)raw, data, nsamples/4, 0, 1);
+#else
+    unpack_2bit_samples((const unsigned char *)raw, data, nsamples/4, 0, 0);
+#endif
 }
 
 
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <vector>
 #include <map>
+#include <pthread.h>
 #ifdef HAVE_ERRNO_H
 #include <errno.h>
 #endif
@@ -277,34 +278,105 @@ void write_wufile_blocks(int nbytes) {
   // doesn't do anything anymore.  What was done here is done in output_samples.
 }
 
-int filecopy(char *oldname,char *newname) {
-  FILE *oldfile,*newfile;
-  char buffer[16384];
-  int nread;
-  if ((oldfile=fopen(oldname,"rb")) && (newfile=fopen(newname,"wb"))) {
-      do {
-	nread=fread(buffer,1,16384,oldfile);
-	fwrite(buffer,1,nread,newfile);
-      } while (nread>0);
-      fclose(oldfile);
-      fclose(newfile);
-      return 0;
+// Each workunit file is written straight into its download directory.
+// The header made by make_wu_headers() is copied from wu_inbox into
+// <name>.tmp next to the final file, the encoded data is streamed after
+// it, and the file is renamed into place, so a partial workunit is never
+// visible.  The strips are independent, so they are written by several
+// threads.
+
+struct wu_output {
+  char oldname[256];
+  char newname[1024];
+  int failed;
+};
+
+static std::vector<wu_output> wu_outputs;
+static xml_encoding wu_encoding;
+static int next_wu_output;
+static pthread_mutex_t wu_output_lock=PTHREAD_MUTEX_INITIALIZER;
+
+// Writes what x_setiathome_encode() would return, 256 lines at a time,
+// without holding the whole encoded workunit in memory.
+static int write_x_setiathome(FILE *f, const unsigned char *bin, size_t nbytes) {
+  const size_t piece=48*256;
+  char line[65*256+8];
+  size_t offset, n;
+  char *end;
+
+  if (fwrite("\n",1,1,f) != 1) return 1;
+  for (offset=0; offset<nbytes; offset+=n) {
+    n=std::min(piece,nbytes-offset);
+    end=x_setiathome_encode_body(bin+offset,n,line);
+    if (fwrite(line,end-line,1,f) != 1) return 1;
+  }
+  return (fwrite("\n",1,1,f) != 1);
+}
+
+static int write_wu_file(int i) {
+  wu_output &out=wu_outputs[i];
+  std::vector<unsigned char> &data=bin_data[i];
+  char tmpname[1100], buffer[16384];
+  FILE *header, *tmpfile;
+  size_t nread;
+  int retval=0;
+
+  sprintf(tmpname,"%s.tmp",out.newname);
+  if (!(header=fopen(out.oldname,"rb"))) return 1;
+  if (!(tmpfile=fopen(tmpname,"wb"))) {
+    fclose(header);
+    return 1;
+  }
+  while ((nread=fread(buffer,1,sizeof(buffer),header)) > 0) {
+    if (fwrite(buffer,nread,1,tmpfile) != 1) retval=1;
+  }
+  fclose(header);
+
+  if (wu_encoding == _x_setiathome) {
+    fprintf(tmpfile,"<data length=%ld encoding=\"%s\">",
+         (long)x_setiathome_encoded_size(data.size()),xml_encoding_names[wu_encoding]);
+    if (write_x_setiathome(tmpfile,data.size()?&(data[0]):NULL,data.size())) retval=1;
+  } else if (wu_encoding == _binary) {
+    fprintf(tmpfile,"<data length=%ld encoding=\"%s\">",(long)data.size(),
+         xml_encoding_names[wu_encoding]);
+    if (data.size() && (fwrite(&(data[0]),data.size(),1,tmpfile) != 1)) retval=1;
   } else {
+    std::string tmpstr=xml_encode_string(data,wu_encoding);
+    fprintf(tmpfile,"<data length=%ld encoding=\"%s\">",(long)tmpstr.size(),
+         xml_encoding_names[wu_encoding]);
+    if (fwrite(tmpstr.c_str(),tmpstr.size(),1,tmpfile) != 1) retval=1;
+  }
+  fprintf(tmpfile,"</data>\n");
+  fprintf(tmpfile,"</workunit>\n");
+  if (fclose(tmpfile)) retval=1;
+
+  if (retval || rename(tmpname,out.newname)) {
+    unlink(tmpname);
     return 1;
   }
+  return 0;
 }
-      
 
+static void *wu_output_thread(void *) {
+  int i;
+  while (1) {
+    pthread_mutex_lock(&wu_output_lock);
+    i=next_wu_output++;
+    pthread_mutex_unlock(&wu_output_lock);
+    if (i>=NSTRIPS) break;
+    if (write_wu_file(i)) {
+      wu_outputs[i].failed=errno?errno:-1;
+    }
+  }
+  return NULL;
+}
 
 void rename_wu_files() {
-  int i, retval;
-  char oldname[256],newname[1024];
-  unsigned long sz;
+  int i, retval, nthreads;
   DB_WORKUNIT db_wu;
   const char *name[1];
   char *wudir="./wu_inbox";
-  xml_encoding encoding=(noencode?_binary:_x_setiathome);
-  FILE *tmpfile;
+  std::vector<pthread_t> threads;
 
   if (boinc_db.open(boinc_config.db_name,boinc_config.db_host,boinc_config.db_user,boinc_config.db_passwd)) {
     boinc_db.print_error("boinc_db.open");
@@ -312,40 +384,63 @@ void rename_wu_files() {
     exit(1);
   }
 
+  wu_encoding=(noencode?_binary:_x_setiathome);
+  wu_outputs.resize(NSTRIPS);
   for (i=0;i<NSTRIPS;i++) {
+    wu_output &out=wu_outputs[i];
     name[0]=wuheaders[i].name;
-    sprintf(oldname,"%s/%s",wudir,name[0]);
-
-    //sprintf(newname,"%s%s/%s",projectdir,WU_SUBDIR,name[0]);
-    retval = dir_hier_path(name[0],
-                           boinc_config.download_dir,
-                           boinc_config.uldl_dir_fanout,
-                           newname,
-			   true
-    );
-    if (retval) {
-        char buf[1024];
-        log_messages.printf(SCHED_MSG_LOG::MSG_CRITICAL,"[%s] dir_hier_path() failed: %d\n", name[0], retval);
-	exit(1);
-    } 
+    sprintf(out.oldname,"%s/%s",wudir,name[0]);
+    out.failed=0;
 
     struct stat sbuf;
-    if (!stat(oldname,&sbuf) && (tmpfile=fopen(oldname,"a"))) {
-       std::string tmpstr=xml_encode_string(bin_data[i],encoding);
-       fprintf(tmpfile,"<data length=%ld encoding=\"%s\">",tmpstr.size(),
-            xml_encoding_names[encoding]);
-       fwrite(tmpstr.c_str(),tmpstr.size(),1,tmpfile);
-       fprintf(tmpfile,"</data>\n");
-       fprintf(tmpfile,"</workunit>\n");
-       sz=bin_data[i].size();
-
-       fclose(tmpfile);
-    } else {
+    if (stat(out.oldname,&sbuf)) {
         log_messages.printf(SCHED_MSG_LOG::MSG_CRITICAL,"Header file no longer exists! splitter start script may be failing\n ");
 	exit(1);
-    }  
-    if (!nodb) {
-      if (!filecopy(oldname,newname)) {
+    }
+
+    if (nodb) {
+      // without a database the workunits are left in wu_inbox
+      strlcpy(out.newname,out.oldname,sizeof(out.newname));
+    } else {
+      //sprintf(newname,"%s%s/%s",projectdir,WU_SUBDIR,name[0]);
+      retval = dir_hier_path(name[0],
+                             boinc_config.download_dir,
+                             boinc_config.uldl_dir_fanout,
+                             out.newname,
+                             true
+      );
+      if (retval) {
+          log_messages.printf(SCHED_MSG_LOG::MSG_CRITICAL,"[%s] dir_hier_path() failed: %d\n", name[0], retval);
+          exit(1);
+      }
+    }
+  }
+
+  nthreads=(int)sysconf(_SC_NPROCESSORS_ONLN);
+  nthreads=std::max(1,std::min(nthreads,(int)NSTRIPS));
+  next_wu_output=0;
+  threads.resize(nthreads);
+  for (i=1;i<nthreads;i++) {
+    if (pthread_create(&threads[i],NULL,wu_output_thread,NULL)) {
+      nthreads=i;
+      break;
+    }
+  }
+  wu_output_thread(NULL);
+  for (i=1;i<nthreads;i++) {
+    pthread_join(threads[i],NULL);
+  }
+
+  for (i=0;i<NSTRIPS;i++) {
+    if (wu_outputs[i].failed) {
+      log_messages.printf(SCHED_MSG_LOG::MSG_CRITICAL,"[%s] writing %s failed, errno=%d\n",wuheaders[i].name,wu_outputs[i].newname,wu_outputs[i].failed);
+      exit(1);
+    }
+  }
+
+  if (!nodb) {
+    for (i=0;i<NSTRIPS;i++) {
+        name[0]=wuheaders[i].name;
         db_wu.clear();
         db_wu.opaque=wuheaders[i].id;
         strncpy(db_wu.name,name[0],sizeof(db_wu.name)-2);
@@ -391,12 +486,7 @@ void rename_wu_files() {
           log_messages.printf(SCHED_MSG_LOG::MSG_CRITICAL,"create work failed\n");
           exit(1);
         }
-        //unlink(oldname);   // we now *always* unlink
-      } else {
-	  log_messages.printf(SCHED_MSG_LOG::MSG_CRITICAL,"file copy failed\n");
-          exit(1);
-      }
-      unlink(oldname);
+      unlink(wu_outputs[i].oldname);
     }
   }
   boinc_db.close();
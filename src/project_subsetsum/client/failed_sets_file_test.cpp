@@ -0,0 +1,139 @@
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "stdint.h"
+
+#include "../common/big_uint.hpp"
+#include "../common/failed_sets_file.hpp"
+
+using namespace std;
+
+/**
+ *  Checks that read_failed_sets_file and decode_failed_sets accept what write_failed_sets_file
+ *  writes and reject damaged files (as a client could upload) without throwing or allocating
+ *  what the header claims.
+ *
+ *  Usage: ./sss_failed_sets_file_test [<directory for the test files>]
+ *  Exits with 0 if every check passed.
+ */
+
+uint32_t failures = 0;
+
+void check(bool passed, const string &what) {
+    cout << (passed ? "ok      " : "FAILED  ") << what << endl;
+    if (!passed) failures++;
+}
+
+string read_all(const string &path) {
+    ifstream in(path.c_str(), ios::in | ios::binary);
+    return string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+}
+
+void write_all(const string &path, const string &contents) {
+    ofstream out(path.c_str(), ios::out | ios::binary);
+    out.write(contents.data(), contents.size());
+}
+
+/**
+ *  Returns true if reading path fails cleanly (false, no exception).
+ */
+bool rejected(const string &path) {
+    uint32_t checksum;
+    uint64_t count;
+    string payload;
+    try {
+        if (!read_failed_sets_file(path, checksum, count, payload)) return true;
+        vector<big_uint256> failed_sets;
+        return !decode_failed_sets(payload, count, failed_sets);
+    } catch (...) {
+        return false;
+    }
+}
+
+int main(int argc, char **argv) {
+    string directory = (argc >= 2) ? string(argv[1]) + "/" : string("");
+    string path = directory + "failed_sets_test.bin";
+    string damaged_path = directory + "failed_sets_test_damaged.bin";
+
+    /**
+     *  Failed sets from small to more than 64 bits, so both the one byte and the long LEB128
+     *  forms are written.
+     */
+    vector<big_uint256> failed_sets;
+    big_uint256 failed_set;
+    failed_set.parse("3");
+    failed_sets.push_back(failed_set);
+    failed_set.parse("130");
+    failed_sets.push_back(failed_set);
+    failed_set.parse("18446744073709551617");
+    failed_sets.push_back(failed_set);
+    failed_set.parse("115792089237316195423570985008687907853269984665640564039457584007913129639935");
+    failed_sets.push_back(failed_set);
+
+    check(write_failed_sets_file(path, 12345, failed_sets), "write a failed sets file");
+
+    uint32_t checksum = 0;
+    uint64_t count = 0;
+    string payload;
+    vector<big_uint256> decoded;
+    check(read_failed_sets_file(path, checksum, count, payload), "read it back");
+    check(checksum == 12345 && count == failed_sets.size(), "checksum and count survive");
+    check(decode_failed_sets(payload, count, decoded) && decoded.size() == failed_sets.size(), "decode the payload");
+    bool same = decoded.size() == failed_sets.size();
+    for (uint32_t i = 0; same && i < decoded.size(); i++) same = decoded[i] == failed_sets[i];
+    check(same, "decoded failed sets are the ones written");
+
+    string file = read_all(path);
+
+    write_all(damaged_path, file.substr(0, file.size() - 1));
+    check(rejected(damaged_path), "payload truncated by one byte");
+
+    write_all(damaged_path, file.substr(0, 20));
+    check(rejected(damaged_path), "header truncated");
+
+    write_all(damaged_path, file + "x");
+    check(rejected(damaged_path), "trailing byte after the payload");
+
+    /**
+     *  A header claiming a huge payload on a short file: the size that made payload.resize()
+     *  throw std::length_error, and one that would only exhaust memory.
+     */
+    string oversized = file;
+    for (uint32_t i = 0; i < 8; i++) oversized[20 + i] = (char)(i == 7 ? 0x7f : 0xff);
+    write_all(damaged_path, oversized);
+    check(rejected(damaged_path), "payload size 0x7fffffffffffffff");
+
+    oversized = file;
+    for (uint32_t i = 0; i < 8; i++) oversized[20 + i] = (char)(i == 3 ? 0x01 : 0x00);
+    write_all(damaged_path, oversized);
+    check(rejected(damaged_path), "payload size 16 MB on a short file");
+
+    string short_file = file.substr(0, 29);
+    for (uint32_t i = 0; i < 8; i++) short_file[20 + i] = (char)(i == 7 ? 0x7f : 0xff);
+    write_all(damaged_path, short_file);
+    check(rejected(damaged_path), "29 byte file claiming a huge payload");
+
+    string too_many = file;
+    too_many[12] = (char)(failed_sets.size() + 1);
+    write_all(damaged_path, too_many);
+    check(rejected(damaged_path), "count larger than the payload holds");
+
+    string unterminated = file;
+    unterminated[unterminated.size() - 1] = (char)0x81;
+    write_all(damaged_path, unterminated);
+    check(rejected(damaged_path), "last varint unterminated");
+
+    write_all(damaged_path, "<checksum>1</checksum>\n<failed_subsets>1 2</failed_subsets>\n");
+    check(rejected(damaged_path), "XML output is not a binary file");
+
+    remove(path.c_str());
+    remove(damaged_path.c_str());
+
+    cout << (failures ? "FAILED" : "OK") << endl;
+    return failures ? 1 : 0;
+}
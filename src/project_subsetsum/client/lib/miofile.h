@@ -40,6 +40,9 @@
 //  init_file(): input comes from the FILE* that you specify
 //  init_buf(): input comes from the buffer you specify.
 //   This string is not modified.
+//  init_mmap_read(): input comes from the file you specify,
+//   mapped into memory (or read into it if it can't be mapped).
+//   The memory is released when the MIOFILE is destroyed.
 //
 // Why is this here?  Because on Windows (9x, maybe all)
 // you can't do fdopen() on a socket.
@@ -50,6 +53,10 @@ class MIOFILE {
     char* wbuf;
     int len;
 	const char* buf;
+    void* map_addr;
+    size_t map_len;
+    char* read_buf;
+    friend class XML_PARSER;
 public:
     MIOFILE();
     ~MIOFILE();
@@ -60,6 +67,7 @@ public:
     void init_file(FCGI_FILE *);
 #endif
     void init_buf_read(const char*);
+    int init_mmap_read(const char* path);
 	void init_buf_write(char*, int len);
     int printf(const char* format, ...);
     char* fgets(char*, int);
@@ -38,13 +38,17 @@
 #include "../common/generate_subsets.hpp"
 #include "../common/binary_output.hpp"
 #include "../common/n_choose_k.hpp"
+#include "../common/big_uint.hpp"
+#include "../common/failed_sets_file.hpp"
 
 using namespace std;
 
 string checkpoint_file = "sss_checkpoint.txt";
 string output_filename = "failed_sets.txt";
+string binary_output_filename = "failed_sets.bin";
+bool binary_output = false;
 
-vector<uint64_t> *failed_sets = new vector<uint64_t>();
+vector<big_uint256> *failed_sets = new vector<big_uint256>();
 
 uint32_t checksum = 0;
 
@@ -113,13 +117,16 @@ static inline bool test_subset(const uint32_t *subset, const uint32_t subset_siz
     return success;
 }
 
-void write_checkpoint(string filename, const uint64_t iteration, const uint64_t pass, const uint64_t fail, const vector<uint64_t> *failed_sets, const uint32_t checksum) {
+/**
+ *  Returns the number of bytes written (0 if the checkpoint couldn't be written).
+ */
+double write_checkpoint(string filename, const uint64_t iteration, const uint64_t pass, const uint64_t fail, const vector<big_uint256> *failed_sets, const uint32_t checksum) {
 #ifdef _BOINC_
     string output_path;
     int retval = boinc_resolve_filename_s(filename.c_str(), output_path);
     if (retval) {
         cerr << "APP: error writing checkpoint (resolving checkpoint file name)" << endl;
-        return;
+        return 0;
     }   
 
     ofstream checkpoint_file(output_path.c_str());
@@ -128,7 +135,7 @@ void write_checkpoint(string filename, const uint64_t iteration, const uint64_t
 #endif
     if (!checkpoint_file.is_open()) {
         cerr << "APP: error writing checkpoint (opening checkpoint file)" << endl;
-        return;
+        return 0;
     }   
 
     checkpoint_file << "iteration: " << iteration << endl;
@@ -142,10 +149,13 @@ void write_checkpoint(string filename, const uint64_t iteration, const uint64_t
     }
     checkpoint_file << endl;
 
+    double bytes = (double)checkpoint_file.tellp();
     checkpoint_file.close();
+    if (checkpoint_file.fail()) return 0;
+    return bytes;
 }
 
-bool read_checkpoint(string sites_filename, uint64_t &iteration, uint64_t &pass, uint64_t &fail, vector<uint64_t> *failed_sets, uint32_t &checksum) {
+bool read_checkpoint(string sites_filename, uint64_t &iteration, uint64_t &pass, uint64_t &fail, vector<big_uint256> *failed_sets, uint32_t &checksum) {
 #ifdef _BOINC_
     string input_path;
     int retval = boinc_resolve_filename_s(sites_filename.c_str(), input_path);
@@ -207,7 +217,7 @@ bool read_checkpoint(string sites_filename, uint64_t &iteration, uint64_t &pass,
         exit(1);
     }
 
-    uint64_t current;
+    big_uint256 current;
     for (uint32_t i = 0; i < failed_sets_size; i++) {
         sites_file >> current;
         failed_sets->push_back(current);
@@ -273,10 +283,23 @@ int main(int argc, char** argv) {
     if (retval) exit(retval);
 #endif
 
+    /**
+     *  --binary_output (anywhere on the command line) also writes the checksum and failed sets
+     *  to failed_sets.bin for the validator, see failed_sets_file.hpp.
+     */
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--binary_output")) {
+            binary_output = true;
+            for (int j = i; j < argc - 1; j++) argv[j] = argv[j + 1];
+            argc--;
+            i--;
+        }
+    }
+
     if (argc != 3 && argc != 5) {
         cerr << "ERROR, wrong command line arguments." << endl;
         cerr << "USAGE:" << endl;
-        cerr << "\t./subset_sum <M> <N> [<i> <count>]" << endl << endl;
+        cerr << "\t./subset_sum <M> <N> [<i> <count>] [--binary_output]" << endl << endl;
         cerr << "argumetns:" << endl;
         cerr << "\t<M>      :   The maximum value allowed in the sets." << endl;
         cerr << "\t<N>      :   The number of elements allowed in a set." << endl;
@@ -300,18 +323,43 @@ int main(int argc, char** argv) {
     uint64_t fail = 0;
 
     bool doing_slice = false;
-    uint64_t starting_subset = 0;
+    big_uint256 starting_subset;
     uint64_t subsets_to_calculate = 0;
 
-    n_choose_k_init();      //Initialize the n choose k table
+    /**
+     *  Initialize the n choose k table.  Subset indices are 256 bit so slices can be
+     *  handed out past 67 choose 34 (where n choose k stops fitting into a uint64_t).
+     */
+    if (!big_n_choose_k_init<8>(max_set_value)) {
+        cerr << "ERROR: " << max_set_value << " choose " << subset_size << " is too large for 256 bit subset indices." << endl;
+#ifdef _BOINC_
+        boinc_finish(1);
+#endif
+        exit(1);
+    }
+    big_uint256 expected_total;
+    if (subset_size <= max_set_value) expected_total = big_n_choose_k<8>(max_set_value - 1, subset_size - 1);
 
     if (argc == 5) {
         doing_slice = true;
-        starting_subset = parse_t<uint64_t>(argv[3]);
+        if (!starting_subset.parse(argv[3])) {
+            cerr << "ERROR: could not parse starting subset from argument '" << argv[3] << "'" << endl;
+#ifdef _BOINC_
+            boinc_finish(1);
+#endif
+            exit(1);
+        }
         subsets_to_calculate = parse_t<uint64_t>(argv[4]);
         cerr << "argv[1]:       " << argv[1]       << ", argv[2]:     " << argv[2]     << ", argv[3]:         " << argv[3]         << ", argv[4]:              " << argv[4] << endl;
 	} else {
-		subsets_to_calculate = n_choose_k(max_set_value - 1, subset_size - 1);
+        if (!expected_total.fits_uint64()) {
+            cerr << "ERROR: " << max_set_value << " choose " << subset_size << " has too many subsets to calculate without slicing." << endl;
+#ifdef _BOINC_
+            boinc_finish(1);
+#endif
+            exit(1);
+        }
+		subsets_to_calculate = expected_total.to_uint64();
         cerr << "argv[1]:       " << argv[1]       << ", argv[2]:     " << argv[2]     << endl;
 	}
 
@@ -419,10 +467,8 @@ int main(int argc, char** argv) {
 //    print_subset(subset, subset_size);
 //    *output_target << "\n");
 
-    uint64_t expected_total = n_choose_k(max_set_value - 1, subset_size - 1);
-
 #ifdef HTML_OUTPUT
-    max_digits = ceil(log10(expected_total));
+    max_digits = ceil(log10(expected_total.to_double()));
 #endif
 
 //    for (uint64_t i = 0; i < expected_total; i++) {
@@ -443,8 +489,8 @@ int main(int argc, char** argv) {
     *output_target << endl;
 
 
-    if (starting_subset + iteration > expected_total) {
-        cerr << "starting subset [" << starting_subset + iteration << "] > total subsets [" << expected_total << "]" << endl;
+    if (starting_subset + big_uint256(iteration) > expected_total) {
+        cerr << "starting subset [" << starting_subset + big_uint256(iteration) << "] > total subsets [" << expected_total << "]" << endl;
         cerr << "quitting." << endl;
 #ifdef _BOINC_
         boinc_finish(1);
@@ -452,7 +498,7 @@ int main(int argc, char** argv) {
         exit(1);
     }
 
-    if (doing_slice && starting_subset + subsets_to_calculate > expected_total) {
+    if (doing_slice && starting_subset + big_uint256(subsets_to_calculate) > expected_total) {
         cerr << "starting subset [" << starting_subset << "] + subsets to calculate [" << subsets_to_calculate << "] > total subsets [" << expected_total << "]" << endl;
         cerr << "quitting." << endl;
 #ifdef _BOINC_
@@ -462,7 +508,7 @@ int main(int argc, char** argv) {
     }
 
     if (started_from_checkpoint || doing_slice) {
-        generate_ith_subset(starting_subset + iteration, subset, subset_size, max_set_value);
+        generate_ith_subset(starting_subset + big_uint256(iteration), subset, subset_size, max_set_value);
 
     } else {
         for (uint32_t i = 0; i < subset_size - 1; i++) subset[i] = i + 1;
@@ -481,7 +527,7 @@ int main(int argc, char** argv) {
             pass++;
         } else {
             fail++;
-            failed_sets->push_back(starting_subset + iteration);
+            failed_sets->push_back(starting_subset + big_uint256(iteration));
         }
 
         generate_next_subset(subset, subset_size, max_set_value);
@@ -491,27 +537,44 @@ int main(int argc, char** argv) {
 
 #ifdef VERBOSE
 #ifndef FALSE_ONLY
-        print_subset_calculation(starting_subset + iteration, subset, subset_size, success);
+        print_subset_calculation(starting_subset + big_uint256(iteration), subset, subset_size, success);
 #endif
 #endif
 
 #ifdef ENABLE_CHECKPOINTING
-        /**
-         *  Need to checkpoint if we found a failed set, otherwise the output file might contain duplicates
-         */
         if (!success || (iteration % 10000) == 0) {
             double progress;
             if (doing_slice) {
                 progress = (double)iteration / (double)subsets_to_calculate;
             } else {
-                progress = (double)iteration / (double)expected_total;
+                progress = (double)iteration / expected_total.to_double();
            }
 #ifdef _BOINC_
             boinc_fraction_done(progress);
 #endif
 //            printf("\r%lf", progress);
 //
-            if (!success || (iteration % 60000000) == 0) {      //this works out to be a checkpoint every 10 seconds or so
+            /**
+             *  Let the BOINC client decide when it's time to checkpoint, it spaces them out further if
+             *  they are taking too long (e.g. with many failed sets to write).  Failed sets don't need a
+             *  checkpoint of their own: the checkpoint holds the failed sets up to its iteration, so
+             *  sets found after it are simply found again after a restart.
+             */
+#ifdef _BOINC_
+            bool checkpoint_now = boinc_time_to_checkpoint();
+#else
+            bool checkpoint_now = (iteration % 60000000) == 0;      //this works out to be a checkpoint every 10 seconds or so
+#endif
+
+#if defined(VERBOSE) && !defined(FALSE_ONLY)
+            /**
+             *  Except when every set is printed as it's tested: the output file is appended to after a
+             *  restart, so the sets since an older checkpoint would be printed twice.
+             */
+            if (!success) checkpoint_now = true;
+#endif
+
+            if (checkpoint_now) {
 //                cerr << "\n*****Checkpointing! *****" << endl;
 //                cerr << "CHECKSUM: " << checksum << endl;
 
@@ -524,9 +587,11 @@ int main(int argc, char** argv) {
 //                if (!success) cout << " fail: " << fail << ", failed_subsets.size(): " << failed_sets->size() << "\n";
 //                else cout << endl;
 
-                write_checkpoint(checkpoint_file, iteration, pass, fail, failed_sets, checksum);
 #ifdef _BOINC_
+                boinc_checkpoint_size( write_checkpoint(checkpoint_file, iteration, pass, fail, failed_sets, checksum) );
                 boinc_checkpoint_completed();
+#else
+                write_checkpoint(checkpoint_file, iteration, pass, fail, failed_sets, checksum);
 #endif
             }
         }
@@ -598,6 +663,16 @@ int main(int argc, char** argv) {
     *output_target << "</extra_info>" << endl;
     output_target->flush();
     output_target->close();
+
+    if (binary_output) {
+        string binary_output_path;
+        retval = boinc_resolve_filename_s(binary_output_filename.c_str(), binary_output_path);
+        if (retval || !write_failed_sets_file(binary_output_path, checksum, *failed_sets)) {
+            cerr << "APP: error writing binary output file for failed sets." << endl;
+            boinc_finish(1);
+            exit(1);
+        }
+    }
 #endif
 
     delete [] subset;
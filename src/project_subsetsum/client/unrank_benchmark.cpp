@@ -0,0 +1,114 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <sys/time.h>
+
+#include "stdint.h"
+
+#include "../common/generate_subsets.hpp"
+#include "../common/n_choose_k.hpp"
+#include "../common/big_uint.hpp"
+
+using namespace std;
+
+/**
+ *  Measures the cost of unranking the starting subset of a slice (what the client does once per
+ *  workunit) with uint64_t, 128 bit and 256 bit indices.  The starting indices are spread evenly
+ *  over max_set_value - 1 choose subset_size - 1, like the work generator's slices.
+ *
+ *  Usage: ./sss_unrank_benchmark [<M> <N> [<slices>]]
+ *  With no arguments a few runs on either side of 67 choose 34 are measured.
+ */
+
+double get_time() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + (tv.tv_usec / 1000000.0);
+}
+
+uint32_t checksum;      //keeps the unranking from being optimized away
+
+template <uint32_t WORDS>
+double time_big_unranking(const uint32_t max_set_value, const uint32_t subset_size, const uint32_t slices, uint32_t *subset) {
+    big_uint<WORDS> total = big_n_choose_k<WORDS>(max_set_value - 1, subset_size - 1);
+    big_uint<WORDS> step(total);
+    step.divide(slices);
+
+    double start = get_time();
+    big_uint<WORDS> index;
+    for (uint32_t i = 0; i < slices; i++) {
+        generate_ith_subset(index, subset, subset_size, max_set_value);
+        checksum += subset[0];
+        index += step;
+    }
+    return (get_time() - start) / slices;
+}
+
+double time_unranking(const uint32_t max_set_value, const uint32_t subset_size, const uint32_t slices, uint32_t *subset) {
+    uint64_t step = n_choose_k(max_set_value - 1, subset_size - 1) / slices;
+
+    double start = get_time();
+    uint64_t index = 0;
+    for (uint32_t i = 0; i < slices; i++) {
+        generate_ith_subset(index, subset, subset_size, max_set_value);
+        checksum += subset[0];
+        index += step;
+    }
+    return (get_time() - start) / slices;
+}
+
+void benchmark(const uint32_t max_set_value, const uint32_t subset_size, const uint32_t slices) {
+    uint32_t *subset = new uint32_t[subset_size];
+
+    cout << setw(4) << max_set_value << " choose " << setw(3) << subset_size << ":";
+
+    if (max_set_value <= 68) {      //the uint64_t table stops at 67 choose 34
+        cout << "  uint64 " << setw(8) << time_unranking(max_set_value, subset_size, slices, subset) * 1000000.0 << " us";
+    } else {
+        cout << "  uint64 " << setw(8) << "-" << "   ";
+    }
+
+    if (big_n_choose_k_init<4>(max_set_value)) {
+        cout << "  128 bit " << setw(8) << time_big_unranking<4>(max_set_value, subset_size, slices, subset) * 1000000.0 << " us";
+    } else {
+        cout << "  128 bit " << setw(8) << "-" << "   ";
+    }
+
+    if (big_n_choose_k_init<8>(max_set_value)) {
+        cout << "  256 bit " << setw(8) << time_big_unranking<8>(max_set_value, subset_size, slices, subset) * 1000000.0 << " us";
+    } else {
+        cout << "  256 bit " << setw(8) << "-" << "   ";
+    }
+    cout << "  per slice" << endl;
+
+    delete [] subset;
+}
+
+int main(int argc, char **argv) {
+    uint32_t slices = 100000;
+
+    n_choose_k_init();
+    cout << setprecision(3) << fixed;
+
+    if (argc >= 3) {
+        uint32_t max_set_value = atoi(argv[1]);
+        uint32_t subset_size = atoi(argv[2]);
+        if (argc >= 4) slices = atoi(argv[3]);
+
+        if (subset_size < 2 || subset_size > max_set_value || slices == 0) {
+            cerr << "USAGE: " << argv[0] << " [<M> <N> [<slices>]] with 2 <= N <= M" << endl;
+            exit(1);
+        }
+        benchmark(max_set_value, subset_size, slices);
+    } else {
+        benchmark(60, 34, slices);
+        benchmark(67, 34, slices);
+        benchmark(100, 50, slices);
+        benchmark(130, 65, slices);
+        benchmark(255, 129, slices);
+    }
+
+    cerr << "checksum: " << checksum << endl;
+    return 0;
+}
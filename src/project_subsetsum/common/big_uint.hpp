@@ -0,0 +1,179 @@
+#ifndef SSS_BIG_UINT_HPP
+#define SSS_BIG_UINT_HPP
+
+#include "stdint.h"
+
+#include <string>
+#include <iostream>
+
+/**
+ *  A fixed width unsigned integer made of WORDS 32 bit words (least significant word first).
+ *
+ *  This is used for subset indices once n choose k no longer fits into a uint64_t
+ *  (anything past 67 choose 34).  Everything is done in place without allocation so
+ *  it is cheap enough to use inside the ranking/unranking loops.  32 bit words are
+ *  used (and not __int128) so this works the same on the 32 bit ARM clients.
+ */
+template <uint32_t WORDS>
+class big_uint {
+    public:
+        uint32_t words[WORDS];
+
+        big_uint() {
+            for (uint32_t i = 0; i < WORDS; i++) words[i] = 0;
+        }
+
+        big_uint(const uint64_t value) {
+            words[0] = (uint32_t)value;
+            words[1] = (uint32_t)(value >> 32);
+            for (uint32_t i = 2; i < WORDS; i++) words[i] = 0;
+        }
+
+        /**
+         *  Adds other to this, returns the carry out of the most significant word
+         *  (i.e., true if the addition overflowed).
+         */
+        bool add(const big_uint<WORDS> &other) {
+            uint64_t carry = 0;
+            for (uint32_t i = 0; i < WORDS; i++) {
+                carry += (uint64_t)words[i] + other.words[i];
+                words[i] = (uint32_t)carry;
+                carry >>= 32;
+            }
+            return carry != 0;
+        }
+
+        /**
+         *  Subtracts other from this, returns true if it borrowed (i.e., other > this).
+         */
+        bool subtract(const big_uint<WORDS> &other) {
+            uint64_t borrow = 0;
+            for (uint32_t i = 0; i < WORDS; i++) {
+                uint64_t difference = (uint64_t)words[i] - other.words[i] - borrow;
+                words[i] = (uint32_t)difference;
+                borrow = (difference >> 32) & 1;
+            }
+            return borrow != 0;
+        }
+
+        /**
+         *  Multiplies this by a single word and adds a single word, returns true on overflow.
+         */
+        bool multiply_add(const uint32_t multiplier, const uint32_t addend) {
+            uint64_t carry = addend;
+            for (uint32_t i = 0; i < WORDS; i++) {
+                carry += (uint64_t)words[i] * multiplier;
+                words[i] = (uint32_t)carry;
+                carry >>= 32;
+            }
+            return carry != 0;
+        }
+
+        /**
+         *  Divides this by a single word in place and returns the remainder.
+         */
+        uint32_t divide(const uint32_t divisor) {
+            uint64_t remainder = 0;
+            for (int32_t i = WORDS - 1; i >= 0; i--) {
+                uint64_t current = (remainder << 32) | words[i];
+                words[i] = (uint32_t)(current / divisor);
+                remainder = current % divisor;
+            }
+            return (uint32_t)remainder;
+        }
+
+        bool is_zero() const {
+            for (uint32_t i = 0; i < WORDS; i++) {
+                if (words[i] != 0) return false;
+            }
+            return true;
+        }
+
+        bool fits_uint64() const {
+            for (uint32_t i = 2; i < WORDS; i++) {
+                if (words[i] != 0) return false;
+            }
+            return true;
+        }
+
+        uint64_t to_uint64() const {
+            return ((uint64_t)words[1] << 32) | words[0];
+        }
+
+        double to_double() const {
+            double result = 0;
+            for (int32_t i = WORDS - 1; i >= 0; i--) result = (result * 4294967296.0) + words[i];
+            return result;
+        }
+
+        /**
+         *  Returns -1, 0 or 1 if this is less than, equal to or greater than other.
+         */
+        int compare(const big_uint<WORDS> &other) const {
+            for (int32_t i = WORDS - 1; i >= 0; i--) {
+                if (words[i] != other.words[i]) return (words[i] < other.words[i]) ? -1 : 1;
+            }
+            return 0;
+        }
+
+        std::string to_string() const {
+            big_uint<WORDS> current(*this);
+            char digits[WORDS * 10 + 1];
+            int32_t position = WORDS * 10;
+
+            digits[position] = '\0';
+            do {
+                digits[--position] = '0' + current.divide(10);
+            } while (!current.is_zero());
+
+            return std::string(digits + position);
+        }
+
+        /**
+         *  Parses a decimal string, returns false if it has a non-digit character or overflows.
+         */
+        bool parse(const char *s) {
+            big_uint<WORDS> result;
+            if (*s == '\0') return false;
+
+            for (; *s != '\0'; s++) {
+                if (*s < '0' || *s > '9') return false;
+                if (result.multiply_add(10, *s - '0')) return false;
+            }
+
+            *this = result;
+            return true;
+        }
+
+        big_uint<WORDS>& operator+=(const big_uint<WORDS> &other) { add(other); return *this; }
+        big_uint<WORDS>& operator-=(const big_uint<WORDS> &other) { subtract(other); return *this; }
+
+        big_uint<WORDS> operator+(const big_uint<WORDS> &other) const { big_uint<WORDS> result(*this); result.add(other); return result; }
+        big_uint<WORDS> operator-(const big_uint<WORDS> &other) const { big_uint<WORDS> result(*this); result.subtract(other); return result; }
+
+        bool operator==(const big_uint<WORDS> &other) const { return compare(other) == 0; }
+        bool operator!=(const big_uint<WORDS> &other) const { return compare(other) != 0; }
+        bool operator< (const big_uint<WORDS> &other) const { return compare(other) <  0; }
+        bool operator<=(const big_uint<WORDS> &other) const { return compare(other) <= 0; }
+        bool operator> (const big_uint<WORDS> &other) const { return compare(other) >  0; }
+        bool operator>=(const big_uint<WORDS> &other) const { return compare(other) >= 0; }
+};
+
+typedef big_uint<4> big_uint128;
+typedef big_uint<8> big_uint256;
+
+template <uint32_t WORDS>
+std::ostream& operator<<(std::ostream &out, const big_uint<WORDS> &n) {
+    return out << n.to_string();
+}
+
+template <uint32_t WORDS>
+std::istream& operator>>(std::istream &in, big_uint<WORDS> &n) {
+    std::string s;
+    if (in >> s) {
+        if (!n.parse(s.c_str())) in.setstate(std::ios::failbit);
+    }
+    return in;
+}
+
+#endif
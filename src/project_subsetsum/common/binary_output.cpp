@@ -109,7 +109,7 @@ void print_bit_array_color(ofstream *output_target, const uint32_t *bit_array, u
     }
 }
 
-void print_subset_calculation(ofstream *output_target, const uint64_t iteration, uint32_t *subset, const uint32_t subset_size, const bool success) {
+void print_subset_calculation(ofstream *output_target, const big_uint256 &iteration, uint32_t *subset, const uint32_t subset_size, const bool success) {
 
     uint32_t M = subset[subset_size - 1];
     uint32_t max_subset_sum = 0;
@@ -153,10 +153,10 @@ void print_subset_calculation(ofstream *output_target, const uint64_t iteration,
 
 #ifdef HTML_OUTPUT
     double whitespaces;
-    if (iteration == 0) {
+    if (iteration.is_zero()) {
         whitespaces = (max_digits - 1);
     } else {
-        whitespaces = (max_digits - floor(log10(iteration))) - 1;
+        whitespaces = (max_digits - floor(log10(iteration.to_double()))) - 1;
     }
 
     for (int i = 0; i < whitespaces; i++) *output_target << "&nbsp;";
@@ -181,18 +181,16 @@ void print_subset_calculation(ofstream *output_target, const uint64_t iteration,
     *output_target << "  match " << setw(4) << min << " to " << setw(4) << max;
 #ifndef HTML_OUTPUT
 #ifdef ENABLE_COLOR
-    if (success)    *output_target << " = \e[32mpass\e[0m" << endl;
-    else            *output_target << " = \e[31mfail\e[0m" << endl;
+    if (success)    *output_target << " = \e[32mpass\e[0m\n";
+    else            *output_target << " = \e[31mfail\e[0m\n";
 #else
-    if (success)    *output_target << " = pass" << endl;
-    else            *output_target << " = fail" << endl;
+    if (success)    *output_target << " = pass\n";
+    else            *output_target << " = fail\n";
 #endif
 #else
-    if (success)    *output_target << " = <span class=\"courier_green\">pass</span><br>" << endl;
-    else            *output_target << " = <span class=\"courier_red\">fail</span><br>" << endl;
+    if (success)    *output_target << " = <span class=\"courier_green\">pass</span><br>\n";
+    else            *output_target << " = <span class=\"courier_red\">fail</span><br>\n";
 #endif
-
-    output_target->flush();
 }
 
 
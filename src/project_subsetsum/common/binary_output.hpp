@@ -5,6 +5,8 @@
 #include <iostream>
 #include <fstream>
 
+#include "../common/big_uint.hpp"
+
 using namespace std;
 
 void print_bits(ofstream *output_target, const uint32_t number);
@@ -12,6 +14,6 @@ void print_bit_array(ofstream *output_target, const uint32_t *bit_array, const u
 void print_subset(ofstream *output_target, const uint32_t *subset, const uint32_t subset_size);
 void print_bit_array_color(ofstream *output_target, const uint32_t *bit_array, unsigned long int max_sums_length, uint32_t min, uint32_t max);
 
-void print_subset_calculation(ofstream *output_target, const uint64_t iteration, uint32_t *subset, const uint32_t subset_size, const bool success);
+void print_subset_calculation(ofstream *output_target, const big_uint256 &iteration, uint32_t *subset, const uint32_t subset_size, const bool success);
 
 #endif
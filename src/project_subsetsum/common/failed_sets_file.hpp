@@ -0,0 +1,201 @@
+#ifndef SSS_FAILED_SETS_FILE_HPP
+#define SSS_FAILED_SETS_FILE_HPP
+
+#include "stdint.h"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+#include "../common/big_uint.hpp"
+
+/**
+ *  A compact binary copy of a result's checksum and failed sets, written by the client next to
+ *  failed_sets.txt (with --binary_output) so the validator doesn't need to parse the XML.
+ *
+ *  Layout (all integers little endian):
+ *      "SSSB"                  magic
+ *      uint32_t version        FAILED_SETS_FILE_VERSION
+ *      uint32_t checksum
+ *      uint64_t count          number of failed sets
+ *      uint64_t payload_size   bytes of payload that follow
+ *      payload                 the failed sets in increasing order, each stored as the
+ *                              difference from the previous one (the first from 0) in
+ *                              LEB128 (7 bits per byte, high bit set on all but the last byte)
+ *
+ *  The encoding is canonical, so two results have the same failed sets exactly when their
+ *  payloads are byte for byte identical.
+ *
+ *  When a result has this file it is what the validator compares and what the assimilator
+ *  inserts, failed_sets.txt is only used for results without it.
+ */
+#define FAILED_SETS_FILE_MAGIC "SSSB"
+#define FAILED_SETS_FILE_VERSION 1
+
+inline void encode_varint(uint64_t value, std::string &out) {
+    while (value >= 0x80) {
+        out += (char)((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out += (char)value;
+}
+
+template <uint32_t WORDS>
+void encode_varint(big_uint<WORDS> value, std::string &out) {
+    while (true) {
+        uint32_t low = value.divide(0x80);
+        if (value.is_zero()) {
+            out += (char)low;
+            return;
+        }
+        out += (char)(low | 0x80);
+    }
+}
+
+/**
+ *  Delta encodes the (increasing) failed sets into payload.  T is uint64_t or a big_uint,
+ *  both give the same bytes for values that fit into a uint64_t.
+ */
+template <class T>
+void encode_failed_sets(const std::vector<T> &failed_sets, std::string &payload) {
+    T previous = T();
+    for (uint32_t i = 0; i < failed_sets.size(); i++) {
+        encode_varint(failed_sets[i] - previous, payload);
+        previous = failed_sets[i];
+    }
+}
+
+inline void put_le(std::string &out, uint64_t value, uint32_t bytes) {
+    for (uint32_t i = 0; i < bytes; i++) out += (char)(value >> (8 * i));
+}
+
+inline uint64_t get_le(const unsigned char *in, uint32_t bytes) {
+    uint64_t value = 0;
+    for (uint32_t i = 0; i < bytes; i++) value |= (uint64_t)in[i] << (8 * i);
+    return value;
+}
+
+/**
+ *  Writes the binary failed sets file, returns false if it could not be written.
+ */
+template <class T>
+bool write_failed_sets_file(const std::string &path, const uint32_t checksum, const std::vector<T> &failed_sets) {
+    std::string payload;
+    encode_failed_sets(failed_sets, payload);
+
+    std::string header(FAILED_SETS_FILE_MAGIC);
+    put_le(header, FAILED_SETS_FILE_VERSION, 4);
+    put_le(header, checksum, 4);
+    put_le(header, failed_sets.size(), 8);
+    put_le(header, payload.size(), 8);
+
+    std::ofstream out(path.c_str(), std::ios::out | std::ios::binary);
+    out.write(header.data(), header.size());
+    out.write(payload.data(), payload.size());
+    out.close();
+    return !out.fail();
+}
+
+/**
+ *  Reads a binary failed sets file.  Returns false (leaving the arguments unspecified) if the
+ *  file can't be read or is not a complete binary failed sets file, e.g. when it is the XML output.
+ */
+inline bool read_failed_sets_file(const std::string &path, uint32_t &checksum, uint64_t &count, std::string &payload) {
+    std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+    if (!in.is_open()) return false;
+
+    unsigned char header[28];
+    if (!in.read((char*)header, sizeof(header))) return false;
+    if (std::string((char*)header, 4) != FAILED_SETS_FILE_MAGIC) return false;
+    if (get_le(header + 4, 4) != FAILED_SETS_FILE_VERSION) return false;
+
+    checksum = (uint32_t)get_le(header + 8, 4);
+    count = get_le(header + 12, 8);
+    uint64_t payload_size = get_le(header + 20, 8);
+
+    /**
+     *  The file comes from a client, so the header's sizes are checked against the bytes that
+     *  are really there before anything is allocated: the payload must be exactly the rest of
+     *  the file, and every failed set takes at least one byte of it.
+     */
+    std::streampos payload_start = in.tellg();
+    if (!in.seekg(0, std::ios::end)) return false;
+    std::streampos file_end = in.tellg();
+    if (payload_start < 0 || file_end < payload_start) return false;
+    if (payload_size != (uint64_t)(file_end - payload_start)) return false;
+    if (payload_size < count) return false;
+    if (!in.seekg(payload_start)) return false;
+
+    payload.resize(payload_size);
+    if (payload_size > 0 && !in.read(&payload[0], payload_size)) return false;
+    return in.peek() == EOF;
+}
+
+/**
+ *  Decodes a payload back into the failed sets.  Returns false unless it is exactly count
+ *  LEB128 values whose running sums (the failed sets) all fit into WORDS words.
+ */
+template <uint32_t WORDS>
+bool decode_failed_sets(const std::string &payload, const uint64_t count, std::vector< big_uint<WORDS> > &failed_sets) {
+    big_uint<WORDS> failed_set;
+    std::string::size_type position = 0;
+
+    for (uint64_t i = 0; i < count; i++) {
+        std::string::size_type end = position;
+        while (end < payload.size() && ((unsigned char)payload[end] & 0x80)) end++;
+        if (end == payload.size()) return false;
+
+        /**
+         *  The 7 bit groups are least significant first, so add them in from the last one.
+         */
+        big_uint<WORDS> delta;
+        for (std::string::size_type j = end + 1; j > position; j--) {
+            if (delta.multiply_add(0x80, (unsigned char)payload[j - 1] & 0x7f)) return false;
+        }
+        if (failed_set.add(delta)) return false;
+
+        failed_sets.push_back(failed_set);
+        position = end + 1;
+    }
+    return position == payload.size();
+}
+
+/**
+ *  Parses the failed sets out of the <failed_subsets> element of the XML output (failed_sets.txt)
+ *  at full width, the client writes them as decimal numbers of up to 256 bits.  Returns false if
+ *  the element is missing or holds anything but decimal numbers that fit into WORDS words.
+ */
+template <uint32_t WORDS>
+bool parse_failed_sets_xml(const std::string &xml, std::vector< big_uint<WORDS> > &failed_sets) {
+    std::string::size_type start = xml.find("<failed_subsets>");
+    if (start == std::string::npos) return false;
+    start += strlen("<failed_subsets>");
+
+    std::string::size_type end = xml.find("</failed_subsets>", start);
+    if (end == std::string::npos) return false;
+
+    std::istringstream in(xml.substr(start, end - start));
+    std::string token;
+    big_uint<WORDS> failed_set;
+    while (in >> token) {
+        if (!failed_set.parse(token.c_str())) return false;
+        failed_sets.push_back(failed_set);
+    }
+    return true;
+}
+
+/**
+ *  FNV-1a hash of a payload, so results with different failed sets are told apart without comparing them.
+ */
+inline uint64_t failed_sets_hash(const std::string &payload) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint32_t i = 0; i < payload.size(); i++) {
+        hash ^= (unsigned char)payload[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+#endif
@@ -55,5 +55,3 @@ void generate_next_subset(uint32_t *subset, uint32_t subset_size, uint32_t max_s
 //    print_subset(subset, subset_size);
 //    *output_target << "\n");
 }
-
-
@@ -3,9 +3,75 @@
 
 #include "stdint.h"
 #include "../common/n_choose_k.hpp"
+#include "../common/big_uint.hpp"
 
 void generate_ith_subset(uint64_t i, uint32_t *subset, uint32_t subset_size, uint32_t max_set_value);
 
 void generate_next_subset(uint32_t *subset, uint32_t subset_size, uint32_t max_set_value);
 
+/**
+ *  Big integer version of generate_ith_subset (unranking in the combinatorial number system),
+ *  for when max_set_value - 1 choose subset_size - 1 does not fit into a uint64_t.
+ *  big_n_choose_k_init<WORDS>(max_set_value) must have been called first.
+ *
+ *  This walks the same candidate values as the uint64_t version, so each call costs
+ *  at most max_set_value compares and subtractions of WORDS words.
+ */
+template <uint32_t WORDS>
+void generate_ith_subset(const big_uint<WORDS> &index, uint32_t *subset, uint32_t subset_size, uint32_t max_set_value) {
+    big_uint<WORDS> i(index);
+    uint32_t pos = 0;
+    uint32_t current_value = 1;
+
+    while (pos < subset_size - 1) {
+        const big_uint<WORDS> &nck = big_n_choose_k<WORDS>((max_set_value - 1) - current_value, (subset_size - 1) - (pos + 1));
+
+        if (i < nck) {
+            subset[pos] = current_value;
+            pos++;
+        } else {
+            i.subtract(nck);
+        }
+        current_value++;
+    }
+
+    subset[subset_size - 1] = max_set_value;
+}
+
+/**
+ *  Moves subset (currently the current_index-th subset) forward to the target_index-th subset,
+ *  for walking a sorted list of indices.  Gaps of up to max_set_value are stepped with
+ *  generate_next_subset, larger ones are unranked directly with generate_ith_subset.
+ */
+template <uint32_t WORDS>
+void generate_ith_subset_from(const big_uint<WORDS> &current_index, const big_uint<WORDS> &target_index, uint32_t *subset, uint32_t subset_size, uint32_t max_set_value) {
+    if (target_index < current_index || target_index - current_index > big_uint<WORDS>(max_set_value)) {
+        generate_ith_subset(target_index, subset, subset_size, max_set_value);
+        return;
+    }
+
+    for (uint64_t steps = (target_index - current_index).to_uint64(); steps > 0; steps--) {
+        generate_next_subset(subset, subset_size, max_set_value);
+    }
+}
+
+/**
+ *  The inverse of generate_ith_subset (ranking), returns i such that
+ *  generate_ith_subset(i, subset, subset_size, max_set_value) generates subset.
+ */
+template <uint32_t WORDS>
+big_uint<WORDS> subset_rank(const uint32_t *subset, uint32_t subset_size, uint32_t max_set_value) {
+    big_uint<WORDS> rank;
+    uint32_t current_value = 1;
+
+    for (uint32_t pos = 0; pos < subset_size - 1; pos++) {
+        for (; current_value < subset[pos]; current_value++) {
+            rank.add(big_n_choose_k<WORDS>((max_set_value - 1) - current_value, (subset_size - 1) - (pos + 1)));
+        }
+        current_value++;
+    }
+
+    return rank;
+}
+
 #endif
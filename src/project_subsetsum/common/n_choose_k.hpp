@@ -2,6 +2,9 @@
 #define SSS_N_CHOOSE_K_HPP
 
 #include <stdint.h>
+#include <cstdlib>
+
+#include "../common/big_uint.hpp"
 
 void n_choose_k_init();
 
@@ -11,4 +14,62 @@ uint64_t n_choose_k_new(uint32_t n, uint32_t k);
  *  This only works up 68 choose 34.  After that we need to use a big number library
  */
 uint64_t n_choose_k(uint32_t n, uint32_t k);
+
+/**
+ *  Pascal's triangle of fixed width big integers, for the sets past 67 choose 34.
+ *  A 128 bit table covers n up to 130, a 256 bit table covers n up to 260.
+ *
+ *  The table is stored as one contiguous (max_n + 1) x (max_n + 1) block so
+ *  the lookups in the unranking loop are just an index calculation.
+ */
+template <uint32_t WORDS>
+struct big_n_choose_k_table {
+    static big_uint<WORDS> *values;
+    static uint32_t max_n;
+};
+
+template <uint32_t WORDS> big_uint<WORDS>* big_n_choose_k_table<WORDS>::values = NULL;
+template <uint32_t WORDS> uint32_t big_n_choose_k_table<WORDS>::max_n = 0;
+
+/**
+ *  Fills in the table up to max_n choose max_n.  Returns false if any of the
+ *  values do not fit into WORDS words (in which case the table is not usable).
+ */
+template <uint32_t WORDS>
+bool big_n_choose_k_init(const uint32_t max_n) {
+    if (big_n_choose_k_table<WORDS>::values != NULL && big_n_choose_k_table<WORDS>::max_n >= max_n) return true;
+
+    uint32_t row_length = max_n + 1;
+    big_uint<WORDS> *values = new big_uint<WORDS>[row_length * row_length];
+    bool overflow = false;
+
+    for (uint32_t n = 0; n <= max_n; n++) {
+        big_uint<WORDS> *row = values + (n * row_length);
+        row[0] = big_uint<WORDS>(1);
+
+        for (uint32_t k = 1; k <= n; k++) {
+            row[k] = values[((n - 1) * row_length) + k - 1];
+            if (row[k].add(values[((n - 1) * row_length) + k])) overflow = true;
+        }
+    }
+
+    if (overflow) {
+        delete [] values;
+        return false;
+    }
+
+    delete [] big_n_choose_k_table<WORDS>::values;
+    big_n_choose_k_table<WORDS>::values = values;
+    big_n_choose_k_table<WORDS>::max_n = max_n;
+    return true;
+}
+
+/**
+ *  big_n_choose_k_init must have been called with max_n >= n first.
+ */
+template <uint32_t WORDS>
+static inline const big_uint<WORDS>& big_n_choose_k(const uint32_t n, const uint32_t k) {
+    return big_n_choose_k_table<WORDS>::values[(n * (big_n_choose_k_table<WORDS>::max_n + 1)) + k];
+}
+
 #endif
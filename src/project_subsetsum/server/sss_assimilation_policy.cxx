@@ -20,6 +20,8 @@
 #include <vector>
 #include <cstdlib>
 #include <string>
+#include <map>
+#include <sstream>
 
 #include "config.h"
 #include "util.h"
@@ -36,36 +38,47 @@
 #include "undvc_common/file_io.hxx"
 #include "undvc_common/parse_xml.hxx"
 
-#include <boost/algorithm/string.hpp>
+#include "../common/big_uint.hpp"
+#include "../common/failed_sets_file.hpp"
 
 using namespace std;
 
-//returns 0 on sucess
-int assimilate_handler(WORKUNIT& wu, vector<RESULT>& /*results*/, RESULT& canonical_result) {
-    int retval;
-    vector<OUTPUT_FILE_INFO> files;
-    
-    MYSQL *conn = boinc_db.mysql;
+#define FAILED_SETS_PER_INSERT 10000
+    //rows per multi-row INSERT into sss_results, keeps each statement well under max_allowed_packet
 
-    //Parse the max_value, subset_size and starting_subset values from the workunit name
-    uint32_t max_value, subset_size;
-    uint64_t starting_subset;
+/**
+ *  Failed sets and starting subsets are indices of up to 256 bits (78 decimal digits), too wide
+ *  for a BIGINT or a DECIMAL, so they are stored as their decimal strings (without leading zeros):
+ *
+ *      ALTER TABLE sss_results MODIFY failed_set VARCHAR(80) NOT NULL;
+ *      ALTER TABLE sss_errors MODIFY starting_subset VARCHAR(80) NOT NULL;
+ *
+ *  Ordering them numerically is ORDER BY CHAR_LENGTH(failed_set), failed_set.
+ */
 
-    vector<std::string> split_string;
-    boost::split(split_string, wu.name, boost::is_any_of("_"));
+/**
+ *  The sss_runs id for each (max_value, subset_size), so it only has to be looked up
+ *  once per run instead of once per result.
+ */
+map< pair<uint32_t, uint32_t>, uint32_t > run_ids;
 
-    max_value       = atol( split_string[2].c_str() );
-    subset_size     = atol( split_string[3].c_str() );
-    starting_subset = atol( split_string[4].c_str() );
+/**
+ *  Runs a query that returns no rows, exits if it fails (which rolls back any open transaction).
+ */
+void run_query(MYSQL *conn, const string &query, const char *what) {
+    mysql_query(conn, query.c_str());
 
-    log_messages.printf(MSG_NORMAL, "parsed max_value: %u, subset_size: %u, and starting_subset %lu\n", max_value, subset_size, starting_subset);
+    if (mysql_errno(conn) != 0) {
+        log_messages.printf(MSG_CRITICAL, "ERROR: could not %s with query: '%s'. Error: %d -- '%s'. Thrown on %s:%d\n", what, query.c_str(), mysql_errno(conn), mysql_error(conn), __FILE__, __LINE__);
+        exit(1);
+    }
+}
 
-    uint32_t id;        //get the run id from the max_value and subset size
+uint32_t get_run_id(MYSQL *conn, uint32_t max_value, uint32_t subset_size) {
+    map< pair<uint32_t, uint32_t>, uint32_t >::iterator it = run_ids.find(make_pair(max_value, subset_size));
+    if (it != run_ids.end()) return it->second;
 
     ostringstream query;
-
-    query.str("");
-    query.clear();
     query << "SELECT id FROM sss_runs WHERE max_value = " << max_value << " AND subset_size = " << subset_size << endl;
 
     log_messages.printf(MSG_NORMAL, "%s\n", query.str().c_str());
@@ -86,38 +99,88 @@ int assimilate_handler(WORKUNIT& wu, vector<RESULT>& /*results*/, RESULT& canoni
         exit(1);
     }
 
-    id = atoi(row[0]);
+    uint32_t id = atoi(row[0]);
     mysql_free_result(result);
 
+    run_ids[make_pair(max_value, subset_size)] = id;
+    return id;
+}
+
+void start_transaction() {
+    int retval = boinc_db.start_transaction();
+    if (retval) {
+        log_messages.printf(MSG_CRITICAL, "start_transaction() failed: %s\n", boincerror(retval));
+        exit(1);
+    }
+}
+
+void commit_transaction() {
+    int retval = boinc_db.commit_transaction();
+    if (retval) {
+        log_messages.printf(MSG_CRITICAL, "commit_transaction() failed: %s\n", boincerror(retval));
+        exit(1);
+    }
+}
+
+//returns 0 on sucess
+int assimilate_handler(WORKUNIT& wu, vector<RESULT>& /*results*/, RESULT& canonical_result) {
+    int retval;
+    vector<OUTPUT_FILE_INFO> files;
+    
+    MYSQL *conn = boinc_db.mysql;
+
+    /**
+     *  Parse the max_value, subset_size and starting_subset values from the end of the workunit name
+     *  (<app name>_<max_value>_<subset_size>_<starting_subset>).  The starting subset is kept as
+     *  a string as it can be past 64 bits.
+     */
+    uint32_t max_value, subset_size;
+    string starting_subset;
+
+    string name(wu.name);
+    size_t subset_pos = name.rfind('_');
+    size_t size_pos = (subset_pos == string::npos || subset_pos == 0) ? string::npos : name.rfind('_', subset_pos - 1);
+    size_t max_pos = (size_pos == string::npos || size_pos == 0) ? string::npos : name.rfind('_', size_pos - 1);
+
+    if (max_pos == string::npos || subset_pos + 1 == name.size() || name.find_first_not_of("0123456789", subset_pos + 1) != string::npos) {
+        log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] assimilate_handler: malformed workunit name '%s'\n", canonical_result.id, canonical_result.name, wu.name);
+        exit(1);
+    }
+
+    max_value       = atol( name.c_str() + max_pos + 1 );
+    subset_size     = atol( name.c_str() + size_pos + 1 );
+    starting_subset = name.substr(subset_pos + 1);
+
+    log_messages.printf(MSG_NORMAL, "parsed max_value: %u, subset_size: %u, and starting_subset %s\n", max_value, subset_size, starting_subset.c_str());
+
+    uint32_t id = get_run_id(conn, max_value, subset_size);        //get the run id from the max_value and subset size
+
+    ostringstream query;
+
 //    cout << "id = " << id << endl;
 
     if (wu.error_mask > 0) {
         log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] assimilate_handler: WORKUNIT ERRORED OUT\n", canonical_result.id, canonical_result.name);
 
+        start_transaction();
+
         query.str("");
         query.clear();
         query << "INSERT INTO sss_errors SET "
             << "id = " << id << ", "
-            << "starting_subset = " << starting_subset;
+            << "starting_subset = '" << starting_subset << "'";
 
         log_messages.printf(MSG_NORMAL, "%s\n", query.str().c_str());
-        mysql_query(conn, query.str().c_str());
-
-        if (mysql_errno(conn) != 0) {
-            log_messages.printf(MSG_CRITICAL, "ERROR: could not insert into sss_errors with query: '%s'. Error: %d -- '%s'. Thrown on %s:%d\n", query.str().c_str(), mysql_errno(conn), mysql_error(conn), __FILE__, __LINE__);
-            exit(1);
-        }
+        run_query(conn, query.str(), "insert into sss_errors");
 
         query.str("");
         query.clear();
         query << "UPDATE sss_runs SET errors = errors + 1 WHERE id = " << id;
 
         log_messages.printf(MSG_NORMAL, "%s\n", query.str().c_str());
-        mysql_query(conn, query.str().c_str());
-        if (mysql_errno(conn) != 0) {
-            log_messages.printf(MSG_CRITICAL, "ERROR: could not update sss_runs with query: '%s'. Error: %d -- '%s'. Thrown on %s:%d\n", query.str().c_str(), mysql_errno(conn), mysql_error(conn), __FILE__, __LINE__);
-            exit(1);
-        }
+        run_query(conn, query.str(), "update sss_runs");
+
+        commit_transaction();
 
     } else if (wu.canonical_resultid == 0) {
         log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] assimilate_handler: error mask not set and canonical result id == 0, should never happen\n", canonical_result.id, canonical_result.name);
@@ -131,55 +194,77 @@ int assimilate_handler(WORKUNIT& wu, vector<RESULT>& /*results*/, RESULT& canoni
             return retval;
         }
 
-        if (files.size() > 1) {
-            log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] had more than one output file: %u\n", canonical_result.id, canonical_result.name, files.size());
+        if (files.size() > 2) {
+            log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] had more than two output files: %u\n", canonical_result.id, canonical_result.name, files.size());
             for (uint32_t i = 0; i < files.size(); i++) {
                 log_messages.printf(MSG_CRITICAL, "    %s\n", files[i].name.c_str());
             }
             exit(1);
         }
 
-        OUTPUT_FILE_INFO& fi = files[0];
-
-        string file_contents;
-        try {
-            file_contents = get_file_as_string(fi.path);
-        } catch (int err) {
-            log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] assimilate_handler: could not open file for result\n", canonical_result.id, canonical_result.name);
-            log_messages.printf(MSG_CRITICAL, "     file path: %s\n", fi.path.c_str());
-            return ERR_FOPEN;
+        /**
+         *  Insert the failed sets from the file the validator compared: the binary failed sets
+         *  file if the client wrote one, otherwise failed_sets.txt (the first file in the output
+         *  template).  Otherwise a host could send a binary file matching its quorum partner
+         *  along with any failed_sets.txt it liked.
+         */
+        vector<big_uint256> failed_sets;
+        bool read_binary = false;
+
+        for (uint32_t i = 0; i < files.size() && !read_binary; i++) {
+            uint32_t checksum;
+            uint64_t failed_set_count;
+            string payload;
+
+            if (read_failed_sets_file(files[i].path, checksum, failed_set_count, payload)) {
+                if (!decode_failed_sets(payload, failed_set_count, failed_sets)) {
+                    log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] assimilate_handler: malformed failed sets in binary file: %s\n", canonical_result.id, canonical_result.name, files[i].path.c_str());
+                    exit(1);
+                }
+                read_binary = true;
+            }
         }
 
-        uint32_t checksum;
-        vector<uint64_t> failed_sets;
+        if (!read_binary) {
+            OUTPUT_FILE_INFO& fi = files[0];
 
-        try {
-            checksum = parse_xml<uint32_t>(file_contents, "checksum");
-            parse_xml_vector<uint64_t>(file_contents, "failed_subsets", failed_sets);
-        } catch (string err_msg) {
-            log_messages.printf(MSG_CRITICAL, "Error parsing file contents:\n%s\n\n", file_contents.c_str());
-            log_messages.printf(MSG_CRITICAL, "Threw exception:\n%s\n", err_msg.c_str());
-            exit(1);
+            string file_contents;
+            try {
+                file_contents = get_file_as_string(fi.path);
+            } catch (int err) {
+                log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] assimilate_handler: could not open file for result\n", canonical_result.id, canonical_result.name);
+                log_messages.printf(MSG_CRITICAL, "     file path: %s\n", fi.path.c_str());
+                return ERR_FOPEN;
+            }
+
+            if (!parse_failed_sets_xml(file_contents, failed_sets)) {
+                log_messages.printf(MSG_CRITICAL, "Error parsing file contents:\n%s\n\n", file_contents.c_str());
+                log_messages.printf(MSG_CRITICAL, "could not parse failed_subsets as 256 bit indices\n");
+                exit(1);
+            }
         }
 
         /**
-         *  Insert each failed subset into the database so they can be used to generate a webpage of which
-         *  ones failed and why later.
+         *  Insert the failed subsets into the database so they can be used to generate a webpage of which
+         *  ones failed and why later.  They go in FAILED_SETS_PER_INSERT rows at a time, in the same
+         *  transaction as the sss_runs update so a run's counts always match its rows.
          */
-        for (uint64_t i = 0; i < failed_sets.size(); i++) {
-            query.str("");
-            query.clear();
-            query << "INSERT INTO sss_results SET "
-                << "id = " << id << ", "
-                << "failed_set = " << failed_sets[i];
+        start_transaction();
 
-            log_messages.printf(MSG_NORMAL, "%s\n", query.str().c_str());
-            mysql_query(conn, query.str().c_str());
+        for (uint64_t i = 0; i < failed_sets.size(); i += FAILED_SETS_PER_INSERT) {
+            uint64_t end = i + FAILED_SETS_PER_INSERT;
+            if (end > failed_sets.size()) end = failed_sets.size();
 
-            if (mysql_errno(conn) != 0) {
-                log_messages.printf(MSG_CRITICAL, "ERROR: could not insert into sss_results with query: '%s'. Error: %d -- '%s'. Thrown on %s:%d\n", query.str().c_str(), mysql_errno(conn), mysql_error(conn), __FILE__, __LINE__);
-                exit(1);
+            query.str("");
+            query.clear();
+            query << "INSERT INTO sss_results (id, failed_set) VALUES ";
+            for (uint64_t j = i; j < end; j++) {
+                if (j > i) query << ",";
+                query << "(" << id << ",'" << failed_sets[j] << "')";
             }
+
+            log_messages.printf(MSG_NORMAL, "INSERT INTO sss_results %llu rows for run %u\n", (unsigned long long)(end - i), id);
+            run_query(conn, query.str(), "insert into sss_results");
         }
 
         /**
@@ -190,11 +275,9 @@ int assimilate_handler(WORKUNIT& wu, vector<RESULT>& /*results*/, RESULT& canoni
         query << "UPDATE sss_runs SET completed = completed + 1, failed_set_count = failed_set_count + " << failed_sets.size() << " WHERE id = " << id;
 
         log_messages.printf(MSG_NORMAL, "%s\n", query.str().c_str());
-        mysql_query(conn, query.str().c_str());
-        if (mysql_errno(conn) != 0) {
-            log_messages.printf(MSG_CRITICAL, "ERROR: could not update sss_runs with query: '%s'. Error: %d -- '%s'. Thrown on %s:%d\n", query.str().c_str(), mysql_errno(conn), mysql_error(conn), __FILE__, __LINE__);
-            exit(1);
-        }
+        run_query(conn, query.str(), "update sss_runs");
+
+        commit_transaction();
     }
 
     //Don't need to do anything, when the result is validated it gets inserted into the database directly
@@ -33,17 +33,27 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cstring>
 
 #include "undvc_common/parse_xml.hxx"
 #include "undvc_common/file_io.hxx"
 
+#include "../common/big_uint.hpp"
+#include "../common/failed_sets_file.hpp"
+
 using std::string;
 using std::vector;
 using std::ifstream;
 
+/**
+ *  The failed sets are kept in the delta encoded form of failed_sets_file.hpp (whichever
+ *  output file they came from), so comparing two results is a hash compare and a memcmp.
+ */
 struct SSS_RESULT {
     uint32_t checksum;
-    vector<uint64_t> failed_sets;
+    uint64_t failed_set_count;
+    uint64_t failed_sets_hash;
+    string failed_sets;
 };
 
 int init_result(RESULT& result, void*& data) {
@@ -56,21 +66,49 @@ int init_result(RESULT& result, void*& data) {
         return retval;
     }
 
-    if (files.size() > 1) {
-        log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] had more than one output file: %u\n", result.id, result.name, files.size());
+    if (files.size() > 2) {
+        log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] had more than two output files: %u\n", result.id, result.name, files.size());
         for (uint32_t i = 0; i < files.size(); i++) {
             log_messages.printf(MSG_CRITICAL, "    %s\n", files[i].path.c_str());
         }
         exit(1);
     }
 
-    OUTPUT_FILE_INFO& fi = files[0];
-    if (fi.no_validate) {
-        log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] had file set to no validate: %s\n", result.id, result.name, fi.path.c_str());
-        exit(1);
-        //continue;
+    for (uint32_t i = 0; i < files.size(); i++) {
+        if (files[i].no_validate) {
+            log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] had file set to no validate: %s\n", result.id, result.name, files[i].path.c_str());
+            exit(1);
+            //continue;
+        }
     }
 
+    SSS_RESULT* sss_result = new SSS_RESULT;
+
+    /**
+     *  Use the binary failed sets file if the client wrote one (--binary_output), otherwise
+     *  parse the XML output file.  The assimilator picks the file the same way, so the failed
+     *  sets that get inserted are always the ones that were validated.  The payload is decoded
+     *  here so a malformed one fails validation instead of the assimilator.
+     */
+    for (uint32_t i = 0; i < files.size(); i++) {
+        if (read_failed_sets_file(files[i].path, sss_result->checksum, sss_result->failed_set_count, sss_result->failed_sets)) {
+            vector<big_uint256> failed_sets;
+            if (!decode_failed_sets(sss_result->failed_sets, sss_result->failed_set_count, failed_sets)) {
+                log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] get_data_from_result: malformed failed sets in binary file: %s\n", result.id, result.name, files[i].path.c_str());
+                delete sss_result;
+                return ERR_XML_PARSE;
+            }
+
+            sss_result->failed_sets_hash = failed_sets_hash(sss_result->failed_sets);
+            data = (void*) sss_result;
+            return 0;
+        }
+    }
+
+    /**
+     *  failed_sets.txt is the first file in the output template, the binary file (if any) second.
+     */
+    OUTPUT_FILE_INFO& fi = files[0];
     string fc;
 
     try {
@@ -78,25 +116,31 @@ int init_result(RESULT& result, void*& data) {
     } catch (int err) {
         log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] get_data_from_result: could not open file for result\n", result.id, result.name);
         log_messages.printf(MSG_CRITICAL, "     file path: %s\n", fi.path.c_str());
+        delete sss_result;
         return ERR_FOPEN;
     }
 
 //    cout << "Parsing: " << endl << fc << endl;
 
-    SSS_RESULT* sss_result = new SSS_RESULT;
     try {
         sss_result->checksum = parse_xml<uint32_t>(fc, "checksum");
 
 //        cout << "checksum: " << sss_result->checksum << endl;
 
-        parse_xml_vector<uint64_t>(fc, "failed_subsets", sss_result->failed_sets);
+        vector<big_uint256> failed_sets;
+        if (!parse_failed_sets_xml(fc, failed_sets)) throw string("could not parse failed_subsets as 256 bit indices");
+
+//        cout << "failed subsets size: " << failed_sets.size() << endl;
 
-//        cout << "failed subsets size: " << sss_result->failed_sets.size() << endl;
+        sss_result->failed_set_count = failed_sets.size();
+        encode_failed_sets(failed_sets, sss_result->failed_sets);
+        sss_result->failed_sets_hash = failed_sets_hash(sss_result->failed_sets);
     } catch (string error_message) {
         log_messages.printf(MSG_CRITICAL, "sss_validation_policy get_data_from_result([RESULT#%d %s]) failed with error: %s\n", result.id, result.name, error_message.c_str());
         log_messages.printf(MSG_CRITICAL, "XML:\n%s\n", fc.c_str());
 //        result.outcome = RESULT_OUTCOME_VALIDATE_ERROR;
 //        result.validate_state = VALIDATE_STATE_INVALID;
+        delete sss_result;
         return ERR_XML_PARSE;
 //        exit(1);
 //        throw 0;
@@ -116,25 +160,19 @@ int compare_results(
 
     if (f1->checksum == f2->checksum) {
         
-        if (f1->failed_sets.size() == f2->failed_sets.size()) {
-            bool all_match = true;
-            for (unsigned int i = 0; i < f1->failed_sets.size(); i++) {
-                if (f1->failed_sets[i] != f2->failed_sets[i]) {
-                    log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] and [RESULT#%d %s] failed sets[%d] did not match %llu vs %llu\n", r1.id, r1.name, r2.id, r2.name, i, f1->failed_sets[i], f2->failed_sets[i]);
-                    all_match = false;
-                    break;
-                }
-            }
-
-            if (all_match) {
+        if (f1->failed_set_count == f2->failed_set_count) {
+            if (f1->failed_sets_hash == f2->failed_sets_hash
+                    && f1->failed_sets.size() == f2->failed_sets.size()
+                    && memcmp(f1->failed_sets.data(), f2->failed_sets.data(), f1->failed_sets.size()) == 0) {
                 match = true;
             } else {
                 match = false;
+                log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] and [RESULT#%d %s] failed sets did not match (hashes %llu vs %llu)\n", r1.id, r1.name, r2.id, r2.name, (unsigned long long)f1->failed_sets_hash, (unsigned long long)f2->failed_sets_hash);
                 exit(1);
             }
         } else {
             match = false;
-            log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] and [RESULT#%d %s] failed sets had different sizes %u vs %u\n", r1.id, r1.name, r2.id, r2.name, f1->failed_sets.size(), f2->failed_sets.size());
+            log_messages.printf(MSG_CRITICAL, "[RESULT#%d %s] and [RESULT#%d %s] failed sets had different sizes %llu vs %llu\n", r1.id, r1.name, r2.id, r2.name, (unsigned long long)f1->failed_set_count, (unsigned long long)f2->failed_set_count);
             exit(1);
         }
     } else {
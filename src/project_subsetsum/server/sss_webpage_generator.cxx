@@ -61,6 +61,9 @@ DB_APP app;
 int start_time;
 int seqno;
 
+int page_size = 0;                  //failed sets per page, 0 puts them all on one page
+char page_buffer[1 << 20];          //output buffer for the page being written
+
 double max_digits;                  //extern
 double max_set_digits;              //extern
 
@@ -71,12 +74,102 @@ uint32_t *new_sums;             //extern
 
 using namespace std;
 
+/**
+ *  The first page of a run keeps the set_<M>c<N>.html name, later pages are set_<M>c<N>_<page>.html
+ */
+string page_name(uint32_t max_set_value, uint32_t subset_size, uint32_t page) {
+    ostringstream name;
+    name << "set_" << max_set_value << "c" << subset_size;
+    if (page > 1) name << "_" << page;
+    name << ".html";
+    return name.str();
+}
+
+/**
+ *  Opens a page of a run's webpage (with a large output buffer, as there is a line
+ *  per failed set) and writes the HTML header.
+ */
+ofstream* open_page(uint32_t max_set_value, uint32_t subset_size, uint32_t page) {
+    string webpage_name = "/projects/subset_sum/download/" + page_name(max_set_value, subset_size, page);
+
+    ofstream *output_target = new ofstream();
+    output_target->rdbuf()->pubsetbuf(page_buffer, sizeof(page_buffer));
+    output_target->open(webpage_name.c_str());
+
+    if (!output_target->is_open()) {
+        log_messages.printf(MSG_CRITICAL, "ERROR: could not open webpage '%s'. Thrown on %s:%d\n", webpage_name.c_str(), __FILE__, __LINE__);
+        exit(1);
+    }
+
+    log_messages.printf(MSG_DEBUG, "writing to file: '%s'\n", webpage_name.c_str());
+
+    /**
+     * Make the HTML header
+     */
+    *output_target << "<!DOCTYPE html PUBLIC \"-//w3c//dtd html 4.0 transitional//en\">\n";
+    *output_target << "<html>\n";
+    *output_target << "<head>\n";
+    *output_target << "  <meta http-equiv=\"Content-Type\"\n";
+    *output_target << " content=\"text/html; charset=iso-8859-1\">\n";
+    *output_target << "  <meta name=\"GENERATOR\"\n";
+    *output_target << " content=\"Mozilla/4.76 [en] (X11; U; Linux 2.4.2-2 i686) [Netscape]\">\n";
+    *output_target << "  <title>" << max_set_value << " choose " << subset_size << "</title>\n";
+    *output_target << "\n";
+    *output_target << "<style type=\"text/css\">\n";
+    *output_target << "    .courier_green {\n";
+    *output_target << "        color: #008000;\n";
+    *output_target << "    }   \n";
+    *output_target << "</style>\n";
+    *output_target << "<style type=\"text/css\">\n";
+    *output_target << "    .courier_red {\n";
+    *output_target << "        color: #FF0000;\n";
+    *output_target << "    }   \n";
+    *output_target << "</style>\n";
+    *output_target << "\n";
+    *output_target << "</head><body>\n";
+    *output_target << "<h1>" << max_set_value << " choose " << subset_size << "</h1>\n";
+    *output_target << "<hr width=\"100%%\">\n";
+    *output_target << "\n";
+    if (page > 1) {
+        *output_target << "page " << page << ", <a href=\"" << page_name(max_set_value, subset_size, page - 1) << "\">previous page</a><br>\n";
+    }
+    *output_target << "<br>\n";
+    *output_target << "<tt>\n";
+
+    *output_target << "max_set_value: " << max_set_value << ", subset_size: " << subset_size << "<br>\n";
+
+    return output_target;
+}
+
+/**
+ *  Writes the HTML footer (with a link to the next page if there is one) and closes the page.
+ */
+void close_page(ofstream *output_target, uint32_t max_set_value, uint32_t subset_size, uint32_t page, bool has_next_page) {
+    *output_target << "</tt>\n";
+    *output_target << "<br>\n\n";
+    if (has_next_page) {
+        *output_target << "<a href=\"" << page_name(max_set_value, subset_size, page + 1) << "\">next page</a><br>\n";
+    }
+    *output_target << "<hr width=\"100%%\">\n";
+    *output_target << "Copyright &copy; Travis Desell, Tom O'Neil and the University of North Dakota, 2012\n";
+    *output_target << "</body>\n";
+    *output_target << "</html>\n";
+
+    output_target->close();
+    if (output_target->fail()) {
+        log_messages.printf(MSG_CRITICAL, "ERROR: could not write page %u of %u choose %u. Thrown on %s:%d\n", page, max_set_value, subset_size, __FILE__, __LINE__);
+        exit(1);
+    }
+    delete output_target;
+}
+
 void main_loop(MYSQL *conn) {
     /**
      *  Get max_set_value and subset_size from sss_progress table
      */
     uint32_t id, max_set_value, subset_size;
-    uint64_t slices, failed_set_count, failed_set;
+    uint64_t slices, failed_set_count;
+    big_uint256 failed_set;
 
     while (1) {
         check_stop_daemons();
@@ -109,13 +202,17 @@ void main_loop(MYSQL *conn) {
             slices = atol(row[3]);
             failed_set_count = atol(row[4]);
 
+            /**
+             *  The failed sets are streamed from the server instead of stored (there can be millions of them),
+             *  so the connection can't be used for anything else until they have all been fetched.
+             */
             query.str("");
             query.clear();
-            query << "SELECT failed_set FROM sss_results WHERE id = " << id << " ORDER BY failed_set";
+            query << "SELECT failed_set FROM sss_results WHERE id = " << id << " ORDER BY CHAR_LENGTH(failed_set), failed_set";      //failed_set is a decimal string, see sss_assimilation_policy.cxx
 
             log_messages.printf(MSG_NORMAL, "%s\n", query.str().c_str());
             mysql_query(conn, query.str().c_str());
-            MYSQL_RES *failed_sets_result = mysql_store_result(conn);
+            MYSQL_RES *failed_sets_result = mysql_use_result(conn);
 
             if (mysql_errno(conn) != 0) {
                 log_messages.printf(MSG_CRITICAL, "ERROR: getting failed sets: '%s'. Error: %d -- '%s'. Thrown on %s:%d\n", query.str().c_str(), mysql_errno(conn), mysql_error(conn), __FILE__, __LINE__);
@@ -128,6 +225,7 @@ void main_loop(MYSQL *conn) {
              */
             uint32_t *max_set = new uint32_t[subset_size];
             for (uint32_t i = 0; i < subset_size; i++) max_set[subset_size - i - 1] = max_set_value - i;
+            max_sums_length = 0;
             for (uint32_t i = 0; i < subset_size; i++) max_sums_length += max_set[i];
 
             //    sums_length /= 2;
@@ -136,89 +234,70 @@ void main_loop(MYSQL *conn) {
 
             delete [] max_set;
 
-            uint64_t expected_total = n_choose_k(max_set_value - 1, subset_size - 1);
-            max_digits = ceil(log10(expected_total));
+            /**
+             *  Runs past 67 choose 34 have indices wider than 64 bits, so everything is done with
+             *  256 bit indices like the work generator and the client.
+             */
+            if (!big_n_choose_k_init<8>(max_set_value)) {
+                log_messages.printf(MSG_CRITICAL, "ERROR: %u choose %u does not fit into 256 bits. Thrown on %s:%d\n", max_set_value - 1, subset_size - 1, __FILE__, __LINE__);
+                exit(1);
+            }
+
+            big_uint256 expected_total = big_n_choose_k<8>(max_set_value - 1, subset_size - 1);
+            max_digits = ceil(log10(expected_total.to_double()));
 
             sums = new uint32_t[max_sums_length];
             new_sums = new uint32_t[max_sums_length];
             uint32_t *subset = new uint32_t[subset_size];
 
+            uint32_t page = 1;
+            ofstream *output_target = open_page(max_set_value, subset_size, page);
 
             /**
-             *  Open the webpage to write to
-             */
-            ostringstream webpage_name;
-            webpage_name << "/projects/subset_sum/download/set_" << max_set_value << "c" << subset_size << ".html";
-            ofstream *output_target = new ofstream(webpage_name.str().c_str());
-
-            log_messages.printf(MSG_DEBUG, "writing to file: '%s'\n", webpage_name.str().c_str());
-
-            /**
-             * Make the HTML header
+             *  The failed sets come back sorted, so each subset is found by stepping
+             *  forward from the previous one rather than unranking it from scratch.
              */
-            *output_target << "<!DOCTYPE html PUBLIC \"-//w3c//dtd html 4.0 transitional//en\">" << endl;
-            *output_target << "<html>" << endl;
-            *output_target << "<head>" << endl;
-            *output_target << "  <meta http-equiv=\"Content-Type\"" << endl;
-            *output_target << " content=\"text/html; charset=iso-8859-1\">" << endl;
-            *output_target << "  <meta name=\"GENERATOR\"" << endl;
-            *output_target << " content=\"Mozilla/4.76 [en] (X11; U; Linux 2.4.2-2 i686) [Netscape]\">" << endl;
-            *output_target << "  <title>" << max_set_value << " choose " << subset_size << "</title>" << endl;
-            *output_target << "" << endl;
-            *output_target << "<style type=\"text/css\">" << endl;
-            *output_target << "    .courier_green {" << endl;
-            *output_target << "        color: #008000;" << endl;
-            *output_target << "    }   " << endl;
-            *output_target << "</style>" << endl;
-            *output_target << "<style type=\"text/css\">" << endl;
-            *output_target << "    .courier_red {" << endl;
-            *output_target << "        color: #FF0000;" << endl;
-            *output_target << "    }   " << endl;
-            *output_target << "</style>" << endl;
-            *output_target << "" << endl;
-            *output_target << "</head><body>" << endl;
-            *output_target << "<h1>" << max_set_value << " choose " << subset_size << "</h1>" << endl;
-            *output_target << "<hr width=\"100%%\">" << endl;
-            *output_target << "" << endl;
-            *output_target << "<br>" << endl;
-            *output_target << "<tt>" << endl;
-
-            *output_target << "max_set_value: " << max_set_value << ", subset_size: " << subset_size << "<br>" << endl;
-
             MYSQL_ROW failed_sets_row;
             uint64_t fail = 0;
+            big_uint256 current_set;
+            generate_ith_subset(current_set, subset, subset_size, max_set_value);
+
             while ((failed_sets_row = mysql_fetch_row(failed_sets_result)) != NULL) {
-                failed_set = atol(failed_sets_row[0]);
+                if (!failed_set.parse(failed_sets_row[0])) {
+                    log_messages.printf(MSG_CRITICAL, "ERROR: malformed failed set '%s' for run %u. Thrown on %s:%d\n", failed_sets_row[0], id, __FILE__, __LINE__);
+                    exit(1);
+                }
+
+                if (page_size > 0 && fail > 0 && fail % page_size == 0) {
+                    close_page(output_target, max_set_value, subset_size, page, true);
+                    page++;
+                    output_target = open_page(max_set_value, subset_size, page);
+                }
 
                 /**
                  *  Write the line for that failed set to the html file.
                  */
-                generate_ith_subset(failed_set, subset, subset_size, max_set_value);
+                generate_ith_subset_from(current_set, failed_set, subset, subset_size, max_set_value);
+                current_set = failed_set;
                 print_subset_calculation(output_target, failed_set, subset, subset_size, false);
                 fail++;
             }
-            uint64_t pass = expected_total - fail;
+            big_uint256 pass = expected_total - big_uint256(fail);
 
             if (mysql_errno(conn) != 0) {
                 log_messages.printf(MSG_CRITICAL, "ERROR: getting failed_sets from sss_results row: '%s'. Error: %d -- '%s'. Thrown on %s:%d\n", query.str().c_str(), mysql_errno(conn), mysql_error(conn), __FILE__, __LINE__);
                 exit(1);
             }   
 
-            delete subset;
-            delete sums;
-            delete new_sums;
+            delete [] subset;
+            delete [] sums;
+            delete [] new_sums;
             mysql_free_result(failed_sets_result);
 
-            *output_target << expected_total << " total sets, " << pass << " sets passed, " << fail << " sets failed, " << ((double)pass/ ((double)pass + (double)fail)) << " success rate." << endl;
-            *output_target << "</tt>" << endl;
-            *output_target << "<br>" << endl << endl;
-            *output_target << "<hr width=\"100%%\">" << endl;
-            *output_target << "Copyright &copy; Travis Desell, Tom O'Neil and the University of North Dakota, 2012" << endl;
-            *output_target << "</body>" << endl;
-            *output_target << "</html>" << endl;
+            *output_target << expected_total << " total sets, " << pass << " sets passed, " << fail << " sets failed, " << (pass.to_double() / expected_total.to_double()) << " success rate.\n";
+            close_page(output_target, max_set_value, subset_size, page, false);
 
-            output_target->flush();
-            output_target->close();
+            log_messages.printf(MSG_DEBUG, "wrote %llu failed sets on %u pages\n", (unsigned long long)fail, page);
 
 //            if (fail > 0) {
 //                cerr << "[url=http://volunteer.cs.und.edu/subset_sum/download/set_" << max_set_value << "c" << subset_size << ".html]" << max_set_value << " choose " << subset_size << "[/url] -- " << fail << " failures" << endl;
@@ -259,6 +338,7 @@ void usage(char *name) {
         "Usage: %s [OPTION]...\n\n"
         "Options:\n"
         "  --app X                      Application name (default: example_app)\n"
+        "  --page_size N                Failed sets per page, 0 for a single page (default: 0)\n"
         "  [ -d X ]                     Sets debug level to X.\n"
         "  [ -h | --help ]              Shows this help text.\n"
         "  [ -v | --version ]           Shows version information.\n",
@@ -283,6 +363,8 @@ int main(int argc, char** argv) {
             if (dl == 4) g_print_queries = true;
         } else if (!strcmp(argv[i], "--app")) {
             app_name = argv[++i];
+        } else if (!strcmp(argv[i], "--page_size")) {
+            page_size = atoi(argv[++i]);
         } else if (is_arg(argv[i], "h") || is_arg(argv[i], "help")) {
             usage(argv[0]);
             exit(0);
@@ -20,12 +20,14 @@
 // (you may need to change some or all of these):
 //
 // - Runs as a daemon, and creates an unbounded supply of work.
-//   It attempts to maintain a "cushion" of 100 unsent job instances.
-//   (your app may not work this way; e.g. you might create work in batches)
-// - Creates work for the application "example_app".
-// - Creates a new input file for each job;
-//   the file (and the workunit names) contain a timestamp
-//   and sequence number, so they're unique.
+//   It attempts to maintain a "cushion" of unsent job instances (--cushion),
+//   creating only as many slices of the current (M, N) run as are needed
+//   to top it up.  Where it got to is kept in sss_progress.current_set,
+//   so large runs are generated as they are consumed rather than all at once.
+// - Jobs are created in transactions of --batch jobs, each of which also
+//   advances sss_progress, so a restart never duplicates or skips slices.
+// - Creates work for the application "subset_sum".
+//   Jobs take their parameters from the command line and have no input files.
 
 #include <unistd.h>
 #include <cstdlib>
@@ -49,9 +51,12 @@
 #include "mysql.h"
 
 #include "../common/n_choose_k.hpp"
+#include "../common/big_uint.hpp"
 
 #define CUSHION 100
     // maintain at least this many unsent results
+#define BATCH_SIZE 100
+    // create at most this many jobs per transaction
 #define REPLICATION_FACTOR  1
 
 const char* app_name = "subset_sum";
@@ -60,6 +65,9 @@ const char* out_template_file = "subset_sum_out.xml";
 
 char* in_template;
 DB_APP app;
+int cushion = CUSHION;
+int batch_size = BATCH_SIZE;
+bool binary_output = false;
 int start_time;
 int seqno;
 
@@ -70,30 +78,19 @@ using namespace std;
 
 // create one new job
 //
-int make_job(uint32_t max_set_value, uint32_t set_size, uint64_t starting_set, uint64_t sets_to_evaluate) {
+int make_job(uint32_t max_set_value, uint32_t set_size, const big_uint256 &starting_set, uint64_t sets_to_evaluate) {
     DB_WORKUNIT wu;
 
     char name[256], path[256];
     char command_line[512];
     char additional_xml[512];
     const char* infiles[0];
-    int retval;
 
-    // make a unique name (for the job and its input file)
+    // make a unique name for the job
     //
-    sprintf(name, "%s_%u_%u_%lu", app_name, max_set_value, set_size, starting_set);
+    sprintf(name, "%s_%u_%u_%s", app_name, max_set_value, set_size, starting_set.to_string().c_str());
 //    fprintf(stdout, "name: '%s'\n", name);
 
-    // Create the input file.
-    // Put it at the right place in the download dir hierarchy
-    //
-    retval = config.download_path(name, path);
-    if (retval) return retval;
-    FILE* f = fopen(path, "w");
-    if (!f) return ERR_FOPEN;
-    fprintf(f, "This is the input file for job %s", name);
-    fclose(f);
-
     double fpops_per_set = set_size * log(max_set_value) * 1e2;         //TODO: figure out an estimate of how many fpops per set calculation
     double fpops_est = fpops_per_set * SETS_PER_WORKUNIT;
 
@@ -120,7 +117,7 @@ int make_job(uint32_t max_set_value, uint32_t set_size, uint64_t starting_set, u
     //
     sprintf(path, "templates/%s", out_template_file);
 
-    sprintf(command_line, " %u %u %lu %lu", max_set_value, set_size, starting_set, sets_to_evaluate);
+    sprintf(command_line, " %u %u %s %lu%s", max_set_value, set_size, starting_set.to_string().c_str(), sets_to_evaluate, binary_output ? " --binary_output" : "");
 //    fprintf(stdout, "command line: '%s'\n", command_line);
 
 //    uint64_t total_sets = n_choose_k(max_set_value - 1, set_size - 1);
@@ -142,72 +139,148 @@ int make_job(uint32_t max_set_value, uint32_t set_size, uint64_t starting_set, u
     return 1;
 }
 
-void make_jobs(uint32_t max_set_value, uint32_t set_size) {
-    int unsent_results;
-    int retval;
+/**
+ *  Runs a query that returns no rows, exits if it fails.
+ */
+void run_query(const string &query, const char *what) {
+    log_messages.printf(MSG_NORMAL, "%s\n", query.c_str());
+    mysql_query(boinc_db.mysql, query.c_str());
 
-    check_stop_daemons();   //This checks to see if there is a stop in place, if there is it will exit the work generator.
+    if (mysql_errno(boinc_db.mysql) != 0) {
+        log_messages.printf(MSG_CRITICAL, "ERROR: could not %s with query: '%s'. Error: %d -- '%s'. Thrown on %s:%d\n", what, query.c_str(), mysql_errno(boinc_db.mysql), mysql_error(boinc_db.mysql), __FILE__, __LINE__);
+        exit(1);
+    }
+}
 
-	//Aaron Comment: retval tells us if the count_unsent_results
-	//function is working properly. If it is, then it's value
-	//should be 0. Anything creater than 0 and the program exits.
-    retval = count_unsent_results(unsent_results, 0);
-    if (retval) {
-        log_messages.printf(MSG_CRITICAL,
-            "count_unsent_jobs() failed: %s\n", boincerror(retval)
-        );
-        exit(retval);
+/**
+ *  Moves on to the next (M, N) run.
+ *
+ *  If the set is odd, and the set size is > the (max_set_value - 1) / 2 or
+ *  if the set is even and the set size is > max_set_value / 2, increase the max value
+ *  and update the set size, ex:
+ *  max_set_value = 32, set sizes should be 16, 17, 18
+ *  max_set_value = 33, set sizes should be 16, 17, 18
+ *  max_set_value = 34, set sizes should be 17, 18, 19
+ *  etc.
+ */
+void next_run(uint32_t &max_set_value, uint32_t &subset_size) {
+    subset_size++;
+
+    if (max_set_value % 2 == 0) { //even
+        if (subset_size > (max_set_value / 2) + 2) {
+            subset_size -= 3;
+            max_set_value++;
+        }
+    } else { //odd
+        if (subset_size > ((max_set_value - 1) / 2) + 2) {
+            subset_size -= 2;
+            max_set_value++;
+        }
     }
+}
 
-    //divide up the sets into mostly equal sized workunits
+/**
+ *  Creates up to max_jobs slices, continuing from current_set in the current run
+ *  and moving on to the next run when this one is finished.
+ *
+ *  Every batch of jobs is created in one transaction together with the sss_progress
+ *  update (and the sss_runs row when a run is started), so the cursor in the database
+ *  always matches the jobs that exist.
+ */
+void make_jobs(uint32_t &max_set_value, uint32_t &subset_size, big_uint256 &current_set, int max_jobs) {
+    int retval;
+    int total_generated = 0;
+    const big_uint256 sets_per_workunit(SETS_PER_WORKUNIT);
 
-    uint64_t total_sets = n_choose_k(max_set_value - 1, set_size - 1);
-    uint64_t current_set = 0;
-    uint64_t total_generated = 0;
+    while (total_generated < max_jobs) {
+        check_stop_daemons();   //This checks to see if there is a stop in place, if there is it will exit the work generator.
 
-    while (current_set < total_sets) {
-        if ((total_sets - current_set) > SETS_PER_WORKUNIT) {
-            make_job(max_set_value, set_size, current_set, SETS_PER_WORKUNIT);
-        } else {
-            make_job(max_set_value, set_size, current_set, total_sets - current_set);
+        //divide up the sets into mostly equal sized workunits
+        //the set indices are 256 bit, so this works past 67 choose 34 (up to 260 choose 130)
+        if (!big_n_choose_k_init<8>(max_set_value)) {
+            log_messages.printf(MSG_CRITICAL, "ERROR: %u choose %u does not fit into 256 bit subset indices. Thrown on %s:%d\n", max_set_value, subset_size, __FILE__, __LINE__);
+            exit(1);
         }
-        current_set += SETS_PER_WORKUNIT;
+        big_uint256 total_sets = big_n_choose_k<8>(max_set_value - 1, subset_size - 1);
 
-        total_generated++;
-    }
+        retval = boinc_db.start_transaction();
+        if (retval) {
+            log_messages.printf(MSG_CRITICAL, "start_transaction() failed: %s\n", boincerror(retval));
+            exit(retval);
+        }
 
-    /**
-     *  Update create an entry in sss_runs table for this M and N
-     */
-    ostringstream query;
-    query << "INSERT INTO sss_runs SET "
-          << "max_value =  " << max_set_value << ", "
-          << "subset_size = " << set_size << ", "
-          << "slices = " << total_generated << ", "
-          << "completed = 0, errors = 0";
+        ostringstream query;
+        if (current_set.is_zero()) {
+            /**
+             *  Create the entry in sss_runs table for this M and N when its first
+             *  slice is made, with the number of slices it will have when done.
+             */
+            big_uint256 slices(total_sets);
+            if (slices.divide(SETS_PER_WORKUNIT) != 0) slices += big_uint256(1);
+
+            query << "INSERT INTO sss_runs SET "
+                  << "max_value =  " << max_set_value << ", "
+                  << "subset_size = " << subset_size << ", "
+                  << "slices = " << slices << ", "
+                  << "completed = 0, errors = 0";
+            run_query(query.str(), "insert into sss_runs");
+        }
 
-    log_messages.printf(MSG_NORMAL, "%s\n", query.str().c_str());
-    mysql_query(boinc_db.mysql, query.str().c_str()); 
+        int batch_generated = 0;
+        while (batch_generated < batch_size && total_generated < max_jobs && current_set < total_sets) {
+            big_uint256 remaining = total_sets - current_set;
 
-    if (mysql_errno(boinc_db.mysql) != 0) {
-        log_messages.printf(MSG_CRITICAL, "ERROR: could not insert into sss_runs with query: '%s'. Error: %d -- '%s'. Thrown on %s:%d\n", query.str().c_str(), mysql_errno(boinc_db.mysql), mysql_error(boinc_db.mysql), __FILE__, __LINE__);
-        exit(1);
-    }
+            if (remaining > sets_per_workunit) {
+                retval = make_job(max_set_value, subset_size, current_set, SETS_PER_WORKUNIT);
+            } else {
+                retval = make_job(max_set_value, subset_size, current_set, remaining.to_uint64());
+            }
+            if (retval) {
+                // exiting drops the connection, which rolls back this batch
+                log_messages.printf(MSG_CRITICAL, "make_job() failed: %s\n", boincerror(retval));
+                exit(retval);
+            }
+            current_set += sets_per_workunit;
+
+            batch_generated++;
+            total_generated++;
+        }
 
+        if (!(current_set < total_sets)) {
+            log_messages.printf(MSG_NORMAL, "all slices of %u choose %u generated\n", max_set_value, subset_size);
+            next_run(max_set_value, subset_size);
+            current_set = big_uint256();
+        }
+
+        query.str("");
+        query.clear();
+        query << "UPDATE sss_progress SET "
+            << "current_max_value = " << max_set_value << ", "
+            << "current_subset_size = " << subset_size << ", "
+            << "current_set = '" << current_set << "'";
+        run_query(query.str(), "update sss_progress");
 
-    log_messages.printf(MSG_DEBUG, "workunits generated: %lu\n", total_generated);
+        retval = boinc_db.commit_transaction();
+        if (retval) {
+            log_messages.printf(MSG_CRITICAL, "commit_transaction() failed: %s\n", boincerror(retval));
+            exit(retval);
+        }
+    }
+
+    log_messages.printf(MSG_DEBUG, "workunits generated: %d\n", total_generated);
 }
 
 void main_loop() {
     int retval;
 
     /**
-     *  Get max_set_value and subset_size from sss_progress table
+     *  Get max_set_value, subset_size and the next slice from sss_progress table
      */
     uint32_t max_set_value, subset_size;
+    big_uint256 current_set;
 
     ostringstream query;
-    query << "SELECT current_max_value, current_subset_size FROM sss_progress";
+    query << "SELECT current_max_value, current_subset_size, current_set FROM sss_progress";
 
     log_messages.printf(MSG_NORMAL, "%s\n", query.str().c_str());
     mysql_query(boinc_db.mysql, query.str().c_str());
@@ -229,6 +302,10 @@ void main_loop() {
 
     max_set_value = atoi(row[0]);
     subset_size = atoi(row[1]);
+    if (row[2] != NULL && !current_set.parse(row[2])) {
+        log_messages.printf(MSG_CRITICAL, "ERROR: sss_progress.current_set '%s' is not a set index. Thrown on %s:%d\n", row[2], __FILE__, __LINE__);
+        exit(1);
+    }
     mysql_free_result(result);
 
     while (1) {
@@ -242,49 +319,12 @@ void main_loop() {
             exit(retval);
         }   
 
-        if (n > CUSHION) {
+        if (n >= cushion) {
             sleep(30);
         } else {
-            log_messages.printf(MSG_DEBUG, "%d results are available, with a cushion of %d\n", n, CUSHION);
-
-            make_jobs(max_set_value, subset_size);
-
-            subset_size++;
-
-            //If the set is odd, and the set size is > the (max_set_value - 1) / 2 or
-            //if the set is even and the set size is > max_set_value / 2, increase the max value
-            //and update the set size, ex:
-            //max_set_value = 32, set sizes should be 16, 17, 18
-            //max_set_value = 33, set sizes should be 16, 17, 18
-            //max_set_value = 34, set sizes should be 17, 18, 19
-            //etc.
-            if (max_set_value % 2 == 0) { //even
-                if (subset_size > (max_set_value / 2) + 2) {
-                    subset_size -= 3;
-                    max_set_value++;
-                }
-            } else { //odd
-                if (subset_size > ((max_set_value - 1) / 2) + 2) {
-                    subset_size -= 2;
-                    max_set_value++;
-                }
-            }
-
-            //Now actually update the database
-            query.str("");
-            query.clear();
-            query << "UPDATE sss_progress SET "
-                << "current_max_value = " << max_set_value << ", "
-                << "current_subset_size = " << subset_size;
-
-            log_messages.printf(MSG_NORMAL, "%s\n", query.str().c_str());
-            mysql_query(boinc_db.mysql, query.str().c_str()); 
-
-            if (mysql_errno(boinc_db.mysql) != 0) {
-                log_messages.printf(MSG_CRITICAL, "ERROR: could not update sss_progress with query: '%s'. Error: %d -- '%s'. Thrown on %s:%d\n", query.str().c_str(), mysql_errno(boinc_db.mysql), mysql_error(boinc_db.mysql), __FILE__, __LINE__);
-                exit(1);
-            }   
+            log_messages.printf(MSG_DEBUG, "%d results are available, with a cushion of %d\n", n, cushion);
 
+            make_jobs(max_set_value, subset_size, current_set, (cushion - n + REPLICATION_FACTOR - 1) / REPLICATION_FACTOR);
 
             // Now sleep for a few seconds to let the transitioner
             // create instances for the jobs we just created.
@@ -310,6 +350,10 @@ void usage(char *name) {
         "  --app X                      Application name (default: example_app)\n"
         "  --in_template_file           Input template (default: example_app_in)\n"
         "  --out_template_file          Output template (default: example_app_out)\n"
+        "  --cushion N                  Keep N unsent results (default: 100)\n"
+        "  --batch N                    Create at most N jobs per transaction (default: 100)\n"
+        "  --binary_output              Have clients also write failed_sets.bin for the validator\n"
+        "                               (the output template must list it after failed_sets.txt)\n"
         "  [ -d X ]                     Sets debug level to X.\n"
         "  [ -h | --help ]              Shows this help text.\n"
         "  [ -v | --version ]           Shows version information.\n",
@@ -338,6 +382,13 @@ int main(int argc, char** argv) {
             in_template_file = argv[++i];
         } else if (!strcmp(argv[i], "--out_template_file")) {
             out_template_file = argv[++i];
+        } else if (!strcmp(argv[i], "--cushion")) {
+            cushion = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--batch")) {
+            batch_size = atoi(argv[++i]);
+            if (batch_size < 1) batch_size = 1;
+        } else if (!strcmp(argv[i], "--binary_output")) {
+            binary_output = true;
         } else if (is_arg(argv[i], "h") || is_arg(argv[i], "help")) {
             usage(argv[0]);
             exit(0);
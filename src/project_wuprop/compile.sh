@@ -8,4 +8,10 @@ ar -rc libboinc.a *.o
 cd ..
 echo "* Compiling data collector"
 g++ -I lib/ -I /usr/include/openssl data_collect.cpp pugixml.cpp -pthread lib/libboinc.a -o data_collect
+echo "* Compiling fake GUI RPC server (test stand-in for the BOINC client)"
+g++ fake_gui_rpc.cpp -o fake_gui_rpc
+echo "* Compiling fake BOINC client (test harness for the runtime in lib/)"
+g++ -I lib/ fake_boinc_client.cpp -pthread lib/libboinc.a -o fake_boinc_client
+echo "* Compiling XML parser benchmark (stdio vs mapped parsing in lib/)"
+g++ -O2 -I lib/ xml_parser_bench.cpp -pthread lib/libboinc.a -o xml_parser_bench
 echo "* Done!"
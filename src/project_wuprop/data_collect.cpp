@@ -62,6 +62,8 @@ map<string, double> dict_ecart_releve;
 map<string, double> dict_prochain_releve;
 map<string, string> dict_dir;
 map<string, long> dict_run;
+map<string, unsigned long> dict_hash;
+map<string, int> dict_vu;	// derniere fois que le resultat figurait dans la liste du client
 list<string> list_active_project;
 int nb_cycle=0;
 int port=31416;
@@ -70,13 +72,18 @@ int end;
 int start_compute;
 int last_new_wu=0;
 pugi::xml_document doc_state;	//state
+// Index de client_state.xml et des resultats, reconstruits a chaque chargement
+map<string, pugi::xml_node> index_projet;
+map<string, pugi::xml_node> index_workunit;
+map<string, pugi::xml_node> index_app;
+map<string, pugi::xml_node> index_app_version;
+map<string, RESULT*> index_results;
 map<string,string>::iterator it;
 map<string,int>::iterator it_int;
 map<string,long>::iterator it_long;
 map<string,double>::iterator it_double;
 list<string>::iterator it_liste;
 MFILE out;
-MFILE cache;
 list<string> liste;
 string wu_name;
 bool chargement_state;
@@ -212,99 +219,324 @@ int frequence()
 }
 #endif
 
-int do_cache()
+// Cache binaire: un instantane (toutes les entrees) et un journal des
+// modifications ajoutees depuis cet instantane.
+// Chaque enregistrement: operation, dictionnaire, date de mise a jour,
+// puis cle et valeur precedees de leur longueur.
+// A chaque checkpoint on n'ajoute au journal que les entrees modifiees;
+// l'instantane est reecrit quand le journal devient plus gros que lui,
+// et les entrees des resultats absents du client depuis CACHE_EXPIRATION sont alors oubliees.
+#define CACHE_MAGIC "WPC1"
+#define CACHE_VERSION 1
+#define CACHE_EXPIRATION (60*86400)
+#define CACHE_VU_PRECISION 86400	// dict_vu n'est rafraichi qu'une fois par jour, pour ne pas grossir le journal
+#define CACHE_SET 1
+#define CACHE_ERASE 2
+
+enum
 {
-	int retval = cache.open(cache_path, "wb");
-	if (retval) return 1;
-	for ( it=dict_delai.begin() ; it != dict_delai.end(); it++)
-	{
-		cache.printf("Delai\t%s\t%s\n", (*it).first.c_str(), (*it).second.c_str());
-	}
-	for ( it=dict_check.begin() ; it != dict_check.end(); it++)
-	{
-		cache.printf("Check\t%s\t%s\n", (*it).first.c_str(), (*it).second.c_str());
-	}
-	for ( it=dict_conso.begin() ; it != dict_conso.end(); it++)
-	{
-		cache.printf("Conso\t%s\t%s\n", (*it).first.c_str(), (*it).second.c_str());
-	}
-	for ( it_double=dict_file.begin() ; it_double !=dict_file.end(); it_double++)
-	{
-		cache.printf("File\t%s\t%f\n", (*it_double).first.c_str(), (*it_double).second);
-	}
-	for ( it=dict_upload.begin() ; it != dict_upload.end(); it++)
-	{
-		cache.printf("Upload\t%s\t%s\n", (*it).first.c_str(), (*it).second.c_str());
-	}
-	for ( it=dict_download.begin() ; it != dict_download.end(); it++)
-	{
-		cache.printf( "Download\t%s\t%s\n", (*it).first.c_str(), (*it).second.c_str());
-	}
-	for ( it=dict_occupation.begin() ; it !=dict_occupation.end(); it++)
-	{
-		cache.printf( "Occupation\t%s\t%s\n", (*it).first.c_str(), (*it).second.c_str());
-	}
-	for ( it=dict_result.begin() ; it !=dict_result.end(); it++)
-	{
-		cache.printf( "Result\t%s\t%s\n", (*it).first.c_str(), (*it).second.c_str());
-	}
-	for ( it=dict_duree.begin() ; it !=dict_duree.end(); it++)
-	{
-		cache.printf( "Duree\t%s\t%s\n", (*it).first.c_str(), (*it).second.c_str());
-	}
-	for ( it_int=dict_nb_file_result.begin() ; it_int !=dict_nb_file_result.end(); it_int++)
-	{
-		cache.printf( "Nb_file_result\t%s\t%d\n", (*it_int).first.c_str(), (*it_int).second);
-	}
-	for ( it_double=dict_size_file_result.begin() ; it_double !=dict_size_file_result.end(); it_double++)
-	{
-		cache.printf( "Size_file_result\t%s\t%f\n", (*it_double).first.c_str(), (*it_double).second);
-	}
-	for ( it=dict_dir.begin() ; it !=dict_dir.end(); it++)
-	{
-		cache.printf( "Dir\t%s\t%s\n", (*it).first.c_str(), (*it).second.c_str());
-	}
-	for ( it=dict_dl_app.begin() ; it!=dict_dl_app.end(); it++)
+	DICT_DELAI, DICT_CHECK, DICT_CONSO, DICT_FILE, DICT_UPLOAD, DICT_DOWNLOAD,
+	DICT_OCCUPATION, DICT_RESULT, DICT_DUREE, DICT_NB_FILE_RESULT, DICT_SIZE_FILE_RESULT,
+	DICT_DIR, DICT_DL_APP, DICT_PROJECT, DICT_ECART_RELEVE, DICT_PROCHAIN_RELEVE,
+	DICT_NEW_WU, DICT_APP, DICT_PLATFORM, DICT_ACTIVE_PROJECT, DICT_RUN, DICT_DIVERS,
+	DICT_VU, NB_DICT
+};
+
+struct ENTREE_CACHE
+{
+	string valeur;
+	int maj;
+};
+
+// contenu du cache tel qu'il est ecrit sur disque
+map<string, ENTREE_CACHE> cache_ecrit[NB_DICT];
+double taille_instantane=0;
+double taille_journal=0;
+bool instantane_existe=false;
+
+void valeur_cache(const string& valeur, string& octets)
+{
+	octets=valeur;
+}
+
+void valeur_cache(double valeur, string& octets)
+{
+	octets.assign((const char*)&valeur, sizeof(valeur));
+}
+
+void valeur_cache(long valeur, string& octets)
+{
+	long long l=valeur;
+	octets.assign((const char*)&l, sizeof(l));
+}
+
+void valeur_cache(int valeur, string& octets)
+{
+	valeur_cache((long)valeur, octets);
+}
+
+void lecture_cache(const string& octets, string& valeur)
+{
+	valeur=octets;
+}
+
+void lecture_cache(const string& octets, double& valeur)
+{
+	if (octets.size()==sizeof(valeur)) memcpy(&valeur, octets.data(), sizeof(valeur));
+}
+
+void lecture_cache(const string& octets, long& valeur)
+{
+	long long l=0;
+	if (octets.size()==sizeof(l)) memcpy(&l, octets.data(), sizeof(l));
+	valeur=(long)l;
+}
+
+void lecture_cache(const string& octets, int& valeur)
+{
+	long l;
+	lecture_cache(octets, l);
+	valeur=(int)l;
+}
+
+void ecriture_entier(string& tampon, unsigned int n)
+{
+	tampon.append((const char*)&n, sizeof(n));
+}
+
+void ecriture_enregistrement(string& tampon, int operation, int dict, int maj, const string& cle, const string& valeur)
+{
+	tampon+=(char)operation;
+	tampon+=(char)dict;
+	ecriture_entier(tampon, (unsigned int)maj);
+	ecriture_entier(tampon, (unsigned int)cle.size());
+	tampon+=cle;
+	ecriture_entier(tampon, (unsigned int)valeur.size());
+	tampon+=valeur;
+}
+
+// Ajoute au journal les differences entre le dictionnaire et ce qui est deja ecrit.
+// Les deux maps sont triees: un seul parcours en parallele.
+template <class T>
+void delta_dict(int id, map<string, T>& dict, string& journal, int maintenant)
+{
+	map<string, ENTREE_CACHE>& ecrit=cache_ecrit[id];
+	typename map<string, T>::iterator it_dict=dict.begin();
+	map<string, ENTREE_CACHE>::iterator it_ecrit=ecrit.begin();
+	string octets;
+	while (it_dict!=dict.end() || it_ecrit!=ecrit.end())
 	{
-		cache.printf( "Dl_app\t%s\t%s\n", (*it).first.c_str(), (*it).second.c_str());
+		if (it_ecrit==ecrit.end() || (it_dict!=dict.end() && (*it_dict).first<(*it_ecrit).first))
+		{ //nouvelle cle
+			ENTREE_CACHE entree;
+			valeur_cache((*it_dict).second, entree.valeur);
+			entree.maj=maintenant;
+			ecriture_enregistrement(journal, CACHE_SET, id, maintenant, (*it_dict).first, entree.valeur);
+			ecrit.insert(it_ecrit, make_pair((*it_dict).first, entree));
+			it_dict++;
+		}
+		else if (it_dict==dict.end() || (*it_ecrit).first<(*it_dict).first)
+		{ //cle supprimee
+			ecriture_enregistrement(journal, CACHE_ERASE, id, maintenant, (*it_ecrit).first, "");
+			ecrit.erase(it_ecrit++);
+		}
+		else
+		{
+			valeur_cache((*it_dict).second, octets);
+			if (octets!=(*it_ecrit).second.valeur)
+			{
+				(*it_ecrit).second.valeur=octets;
+				(*it_ecrit).second.maj=maintenant;
+				ecriture_enregistrement(journal, CACHE_SET, id, maintenant, (*it_dict).first, octets);
+			}
+			it_dict++;
+			it_ecrit++;
+		}
 	}
-	for ( it=dict_project.begin() ; it!=dict_project.end(); it++)
+}
+
+// le resultat est toujours dans la liste du client (actif, en attente ou en upload)
+void vu_resultat(const string& nom_resultat, int maintenant)
+{
+	map<string, int>::iterator it_vu=dict_vu.find(nom_resultat);
+	if (it_vu==dict_vu.end() || (*it_vu).second<maintenant-CACHE_VU_PRECISION) dict_vu[nom_resultat]=maintenant;
+}
+
+// un resultat inconnu de dict_vu (cache d'une version precedente) est considere vu maintenant
+bool resultat_expire(const string& nom_resultat, int maintenant, int limite)
+{
+	map<string, int>::iterator it_vu=dict_vu.find(nom_resultat);
+	if (it_vu==dict_vu.end())
 	{
-		cache.printf( "Project\t%s\t%s\n", (*it).first.c_str(), (*it).second.c_str());
+		dict_vu[nom_resultat]=maintenant;
+		return false;
 	}
-	for ( it_double=dict_ecart_releve.begin() ; it_double !=dict_ecart_releve.end(); it_double++)
+	return (*it_vu).second<limite;
+}
+
+// nom du resultat a partir de la cle d'un dictionnaire
+string cle_resultat(const string& cle)
+{
+	return cle;
+}
+
+string cle_run(const string& cle)
+{ //resultat;machine;projet;...
+	return cle.substr(0, cle.find(";"));
+}
+
+string cle_size_file_result(const string& cle)
+{ //resultat_numero
+	return cle.substr(0, cle.rfind("_"));
+}
+
+// Oublie les entrees des resultats que le client n'a plus listes depuis limite.
+// La date de derniere modification ne suffit pas: un resultat longtemps en file
+// ne change pas, mais ses entrees doivent rester.
+template <class T>
+void expiration_dict(int id, map<string, T>& dict, string (*nom_resultat)(const string&), int maintenant, int limite)
+{
+	map<string, ENTREE_CACHE>& ecrit=cache_ecrit[id];
+	for (map<string, ENTREE_CACHE>::iterator it_ecrit=ecrit.begin(); it_ecrit!=ecrit.end(); )
 	{
-		cache.printf( "Ecart_releve\t%s\t%f\n", (*it_double).first.c_str(), (*it_double).second);
+		if (resultat_expire(nom_resultat((*it_ecrit).first), maintenant, limite))
+		{
+			dict.erase((*it_ecrit).first);
+			ecrit.erase(it_ecrit++);
+		}
+		else it_ecrit++;
 	}
-	for ( it_double=dict_prochain_releve.begin() ; it_double !=dict_prochain_releve.end(); it_double++)
+}
+
+template <class T>
+void restauration_dict(map<string, T>& dict, int operation, const string& cle, const string& octets)
+{
+	if (operation==CACHE_ERASE)
 	{
-		cache.printf( "Prochain_releve\t%s\t%f\n", (*it_double).first.c_str(), (*it_double).second);
+		dict.erase(cle);
 	}
-	for ( it_int=dict_new_wu.begin() ; it_int !=dict_new_wu.end(); it_int++)
+	else
 	{
-		cache.printf( "New wu\t%s\t%d\n", (*it_int).first.c_str(), (*it_int).second);
+		lecture_cache(octets, dict[cle]);
 	}
-	cache.printf("Last_new_wu\t%d\n", last_new_wu);
-	for ( it=dict_app.begin() ; it!=dict_app.end(); it++)
+}
+
+// list_active_project et last_new_wu sont ecrits comme des dictionnaires
+void dicts_divers(map<string, int>& active_project, map<string, int>& divers)
+{
+	for (it_liste=list_active_project.begin(); it_liste!=list_active_project.end(); it_liste++)
 	{
-		cache.printf( "App\t%s\t%s\n", (*it).first.c_str(), (*it).second.c_str());
+		active_project[*it_liste]=0;
 	}
-	for ( it=dict_platform.begin() ; it!=dict_platform.end(); it++)
+	divers["Last_new_wu"]=last_new_wu;
+}
+
+void delta_cache(string& journal, int maintenant)
+{
+	map<string, int> active_project;
+	map<string, int> divers;
+	dicts_divers(active_project, divers);
+	delta_dict(DICT_DELAI, dict_delai, journal, maintenant);
+	delta_dict(DICT_CHECK, dict_check, journal, maintenant);
+	delta_dict(DICT_CONSO, dict_conso, journal, maintenant);
+	delta_dict(DICT_FILE, dict_file, journal, maintenant);
+	delta_dict(DICT_UPLOAD, dict_upload, journal, maintenant);
+	delta_dict(DICT_DOWNLOAD, dict_download, journal, maintenant);
+	delta_dict(DICT_OCCUPATION, dict_occupation, journal, maintenant);
+	delta_dict(DICT_RESULT, dict_result, journal, maintenant);
+	delta_dict(DICT_DUREE, dict_duree, journal, maintenant);
+	delta_dict(DICT_NB_FILE_RESULT, dict_nb_file_result, journal, maintenant);
+	delta_dict(DICT_SIZE_FILE_RESULT, dict_size_file_result, journal, maintenant);
+	delta_dict(DICT_DIR, dict_dir, journal, maintenant);
+	delta_dict(DICT_DL_APP, dict_dl_app, journal, maintenant);
+	delta_dict(DICT_PROJECT, dict_project, journal, maintenant);
+	delta_dict(DICT_ECART_RELEVE, dict_ecart_releve, journal, maintenant);
+	delta_dict(DICT_PROCHAIN_RELEVE, dict_prochain_releve, journal, maintenant);
+	delta_dict(DICT_NEW_WU, dict_new_wu, journal, maintenant);
+	delta_dict(DICT_APP, dict_app, journal, maintenant);
+	delta_dict(DICT_PLATFORM, dict_platform, journal, maintenant);
+	delta_dict(DICT_ACTIVE_PROJECT, active_project, journal, maintenant);
+	delta_dict(DICT_RUN, dict_run, journal, maintenant);
+	delta_dict(DICT_DIVERS, divers, journal, maintenant);
+	delta_dict(DICT_VU, dict_vu, journal, maintenant);
+}
+
+// seuls les dictionnaires par resultat expirent (dict_file est purge par check_file);
+// dict_vu en dernier, apres avoir servi aux autres
+void expiration_cache(int maintenant, int limite)
+{
+	expiration_dict(DICT_DELAI, dict_delai, cle_resultat, maintenant, limite);
+	expiration_dict(DICT_CHECK, dict_check, cle_resultat, maintenant, limite);
+	expiration_dict(DICT_CONSO, dict_conso, cle_resultat, maintenant, limite);
+	expiration_dict(DICT_UPLOAD, dict_upload, cle_resultat, maintenant, limite);
+	expiration_dict(DICT_DOWNLOAD, dict_download, cle_resultat, maintenant, limite);
+	expiration_dict(DICT_OCCUPATION, dict_occupation, cle_resultat, maintenant, limite);
+	expiration_dict(DICT_RESULT, dict_result, cle_resultat, maintenant, limite);
+	expiration_dict(DICT_DUREE, dict_duree, cle_resultat, maintenant, limite);
+	expiration_dict(DICT_NB_FILE_RESULT, dict_nb_file_result, cle_resultat, maintenant, limite);
+	expiration_dict(DICT_SIZE_FILE_RESULT, dict_size_file_result, cle_size_file_result, maintenant, limite);
+	expiration_dict(DICT_DIR, dict_dir, cle_resultat, maintenant, limite);
+	expiration_dict(DICT_ECART_RELEVE, dict_ecart_releve, cle_resultat, maintenant, limite);
+	expiration_dict(DICT_PROCHAIN_RELEVE, dict_prochain_releve, cle_resultat, maintenant, limite);
+	expiration_dict(DICT_RUN, dict_run, cle_run, maintenant, limite);
+	expiration_dict(DICT_VU, dict_vu, cle_resultat, maintenant, limite);
+}
+
+int ecriture_fichier(const char* path, const char* mode, const string& tampon)
+{
+	FILE* f=boinc_fopen(path, mode);
+	if (!f) return 1;
+	size_t n=fwrite(tampon.data(), 1, tampon.size(), f);
+	if (fclose(f) || n!=tampon.size()) return 1;
+	return 0;
+}
+
+int ecriture_instantane()
+{
+	string tampon;
+	string tmp_path=string(cache_path)+".tmp";
+	string journal_path=string(cache_path)+".log";
+	// cache_ecrit est deja a jour: tant que l'instantane n'est pas ecrit,
+	// le prochain cycle doit reecrire un instantane complet
+	instantane_existe=false;
+	int maintenant=time(NULL);
+	expiration_cache(maintenant, maintenant-CACHE_EXPIRATION);
+	tampon.append(CACHE_MAGIC, 4);
+	ecriture_entier(tampon, CACHE_VERSION);
+	for (int id=0; id<NB_DICT; id++)
 	{
-		cache.printf( "Platform\t%s\t%s\n", (*it).first.c_str(), (*it).second.c_str());
+		map<string, ENTREE_CACHE>::iterator it_ecrit;
+		for (it_ecrit=cache_ecrit[id].begin(); it_ecrit!=cache_ecrit[id].end(); it_ecrit++)
+		{
+			ecriture_enregistrement(tampon, CACHE_SET, id, (*it_ecrit).second.maj, (*it_ecrit).first, (*it_ecrit).second.valeur);
+		}
 	}
-	for ( it_liste=list_active_project.begin() ; it_liste!=list_active_project.end(); it_liste++)
+	if (ecriture_fichier(tmp_path.c_str(), "wb", tampon)) return 1;
+	if (boinc_rename(tmp_path.c_str(), cache_path)) return 1;
+	boinc_delete_file(journal_path.c_str());
+	instantane_existe=true;
+	taille_instantane=tampon.size();
+	taille_journal=0;
+	return 0;
+}
+
+int do_cache()
+{
+	string journal;
+	string journal_path=string(cache_path)+".log";
+	delta_cache(journal, time(NULL));
+	if (!instantane_existe || taille_journal+journal.size()>taille_instantane)
 	{
-		cache.printf( "Active_project\t%s\n", (*it_liste).c_str());
+		return ecriture_instantane();
 	}
-  	for ( it_long=dict_run.begin() ; it_long !=dict_run.end(); it_long++)
-	{
-		cache.printf( "Run\t%s\t%d\n", (*it_long).first.c_str(), (*it_long).second);
+	if (journal.empty()) return 0;
+	if (ecriture_fichier(journal_path.c_str(), "ab", journal))
+	{ //le delta est perdu mais deja dans cache_ecrit: instantane complet au prochain cycle
+		instantane_existe=false;
+		return 1;
 	}
-	cache.flush();
-	cache.close();
+	taille_journal+=journal.size();
 	return 0;
-	
 }
 
 int do_checkpoint() 
@@ -325,7 +557,8 @@ int do_checkpoint()
 	return 0;
 }
 
-void restore_cache()
+// ancien format texte du cache
+void restore_cache_texte()
 {
 	char *param1, *param2, *param3;
 	char data[100000+1];
@@ -371,6 +604,122 @@ void restore_cache()
 	}
 }
 
+int lecture_fichier(const char* path, string& tampon)
+{
+	FILE* f=boinc_fopen(path, "rb");
+	if (!f) return 1;
+	fseek(f, 0, SEEK_END);
+	long taille=ftell(f);
+	fseek(f, 0, SEEK_SET);
+	tampon.resize(taille>0?taille:0);
+	size_t n=taille>0?fread(&tampon[0], 1, taille, f):0;
+	fclose(f);
+	tampon.resize(n);
+	return 0;
+}
+
+unsigned int lecture_entier(const string& tampon, size_t pos)
+{
+	unsigned int n;
+	memcpy(&n, tampon.data()+pos, sizeof(n));
+	return n;
+}
+
+// Relit les enregistrements d'un instantane ou du journal.
+// Retourne false si le dernier enregistrement est tronque (arret pendant l'ecriture).
+bool lecture_enregistrements(const string& tampon, size_t pos)
+{
+	while (pos<tampon.size())
+	{
+		if (tampon.size()-pos<10) return false;
+		int operation=(unsigned char)tampon[pos];
+		int id=(unsigned char)tampon[pos+1];
+		int maj=(int)lecture_entier(tampon, pos+2);
+		size_t lg_cle=lecture_entier(tampon, pos+6);
+		pos+=10;
+		if (tampon.size()-pos<lg_cle || tampon.size()-pos-lg_cle<4) return false;
+		string cle=tampon.substr(pos, lg_cle);
+		pos+=lg_cle;
+		size_t lg_valeur=lecture_entier(tampon, pos);
+		pos+=4;
+		if (tampon.size()-pos<lg_valeur) return false;
+		string valeur=tampon.substr(pos, lg_valeur);
+		pos+=lg_valeur;
+		if (id>=NB_DICT) continue;
+		if (operation==CACHE_ERASE)
+		{
+			cache_ecrit[id].erase(cle);
+		}
+		else
+		{
+			cache_ecrit[id][cle].valeur=valeur;
+			cache_ecrit[id][cle].maj=maj;
+		}
+		switch (id)
+		{
+			case DICT_DELAI: restauration_dict(dict_delai, operation, cle, valeur); break;
+			case DICT_CHECK: restauration_dict(dict_check, operation, cle, valeur); break;
+			case DICT_CONSO: restauration_dict(dict_conso, operation, cle, valeur); break;
+			case DICT_FILE: restauration_dict(dict_file, operation, cle, valeur); break;
+			case DICT_UPLOAD: restauration_dict(dict_upload, operation, cle, valeur); break;
+			case DICT_DOWNLOAD: restauration_dict(dict_download, operation, cle, valeur); break;
+			case DICT_OCCUPATION: restauration_dict(dict_occupation, operation, cle, valeur); break;
+			case DICT_RESULT: restauration_dict(dict_result, operation, cle, valeur); break;
+			case DICT_DUREE: restauration_dict(dict_duree, operation, cle, valeur); break;
+			case DICT_NB_FILE_RESULT: restauration_dict(dict_nb_file_result, operation, cle, valeur); break;
+			case DICT_SIZE_FILE_RESULT: restauration_dict(dict_size_file_result, operation, cle, valeur); break;
+			case DICT_DIR: restauration_dict(dict_dir, operation, cle, valeur); break;
+			case DICT_DL_APP: restauration_dict(dict_dl_app, operation, cle, valeur); break;
+			case DICT_PROJECT: restauration_dict(dict_project, operation, cle, valeur); break;
+			case DICT_ECART_RELEVE: restauration_dict(dict_ecart_releve, operation, cle, valeur); break;
+			case DICT_PROCHAIN_RELEVE: restauration_dict(dict_prochain_releve, operation, cle, valeur); break;
+			case DICT_NEW_WU: restauration_dict(dict_new_wu, operation, cle, valeur); break;
+			case DICT_APP: restauration_dict(dict_app, operation, cle, valeur); break;
+			case DICT_PLATFORM: restauration_dict(dict_platform, operation, cle, valeur); break;
+			case DICT_RUN: restauration_dict(dict_run, operation, cle, valeur); break;
+			case DICT_VU: restauration_dict(dict_vu, operation, cle, valeur); break;
+		}
+	}
+	return true;
+}
+
+void restore_cache()
+{
+	string tampon;
+	string journal_path=string(cache_path)+".log";
+	if (lecture_fichier(cache_path, tampon)) return;
+	if (tampon.size()<8 || tampon.compare(0, 4, CACHE_MAGIC)!=0)
+	{
+		state=boinc_fopen(cache_path, "r");
+		if (state)
+		{
+			restore_cache_texte();
+			fclose(state);
+		}
+		return;
+	}
+	if (lecture_entier(tampon, 4)!=CACHE_VERSION)
+	{
+		fprintf(stderr, "%s Version du cache inconnue, cache ignore\n",boinc_msg_prefix(buf, sizeof(buf)));
+		return;
+	}
+	instantane_existe=lecture_enregistrements(tampon, 8);
+	taille_instantane=tampon.size();
+	if (lecture_fichier(journal_path.c_str(), tampon)==0)
+	{
+		// journal tronque: on reecrit l'instantane au prochain checkpoint
+		if (!lecture_enregistrements(tampon, 0)) instantane_existe=false;
+		taille_journal=tampon.size();
+	}
+	map<string, ENTREE_CACHE>::iterator it_ecrit;
+	for (it_ecrit=cache_ecrit[DICT_ACTIVE_PROJECT].begin(); it_ecrit!=cache_ecrit[DICT_ACTIVE_PROJECT].end(); it_ecrit++)
+	{
+		list_active_project.push_back((*it_ecrit).first);
+	}
+	it_ecrit=cache_ecrit[DICT_DIVERS].find("Last_new_wu");
+	if (it_ecrit!=cache_ecrit[DICT_DIVERS].end()) lecture_cache((*it_ecrit).second.valeur, last_new_wu);
+}
+
 void restore_checkpoint()
 {
 	char entete[1000+1];
@@ -384,10 +733,28 @@ void restore_checkpoint()
 	
 }
 
-int reception_cc_status()
+// Connexion RPC unique vers le client BOINC, gardee ouverte entre les requetes.
+// En cas d'echec d'une requete (client redemarre, socket fermee...),
+// on se reconnecte et on reessaie une fois.
+#define RPC_CC_STATUS 0
+#define RPC_HOST_INFO 1
+#define RPC_ACTIVE_RESULTS 2
+#define RPC_RESULTS 3
+#define RPC_STATE 4
+
+RPC_CLIENT rpc;
+bool rpc_connecte=false;
+
+void deconnexion_rpc()
+{
+	rpc.close();
+	rpc_connecte=false;
+}
+
+int connexion_rpc()
 {
-	RPC_CLIENT rpc;
 	int retval;
+	if (rpc_connecte) return 0;
 	if ((dernier_chargement>0) && (time(NULL)<dernier_chargement+31))
 	{
 		boinc_sleep(31-time(NULL)+dernier_chargement);
@@ -395,83 +762,106 @@ int reception_cc_status()
 	}
 	retval = rpc.init("127.0.0.1", port);
 	if (retval) {
-		fprintf(stderr, "%s can't connect to localhost",boinc_msg_prefix(buf, sizeof(buf)));
+		fprintf(stderr, "%s can't connect to localhost\n",boinc_msg_prefix(buf, sizeof(buf)));
+		deconnexion_rpc();
 		return -1;
 	}
-	retval = rpc.get_cc_status(cs);
-	return retval;
+	rpc_connecte=true;
+	return 0;
 }
 
-int reception_host_info()
+int requete_rpc(int requete)
 {
-	RPC_CLIENT rpc;
-	int retval;
-	if ((dernier_chargement>0) && (time(NULL)<dernier_chargement+31))
+	int retval=-1;
+	for (int essai=0; essai<2; essai++)
 	{
-		boinc_sleep(31-time(NULL)+dernier_chargement);
-		fprintf(stderr, "%s Mise en veille (derniere requete date de moins de 30 secondes\n",boinc_msg_prefix(buf, sizeof(buf)));
-	}
-	retval = rpc.init("127.0.0.1", port);
-	if (retval) {
-		fprintf(stderr, "%s can't connect to localhost",boinc_msg_prefix(buf, sizeof(buf)));
-		return -1;
+		retval=connexion_rpc();
+		if (retval) return retval;
+		switch (requete)
+		{
+			case RPC_CC_STATUS: retval = rpc.get_cc_status(cs); break;
+			case RPC_HOST_INFO: retval = rpc.get_host_info(hi); break;
+			case RPC_ACTIVE_RESULTS: retval = rpc.get_results(results,true); break;
+			case RPC_RESULTS: retval = rpc.get_results(results_all,false); break;
+			case RPC_STATE: retval = rpc.get_state(gstate); break;
+		}
+		if (retval==0) return 0;
+		fprintf(stderr, "%s Erreur requete RPC %d (%d), reconnexion\n",boinc_msg_prefix(buf, sizeof(buf)), requete, retval);
+		deconnexion_rpc();
 	}
-	retval = rpc.get_host_info(hi);
 	return retval;
 }
 
+int reception_cc_status()
+{
+	return requete_rpc(RPC_CC_STATUS);
+}
+
+int reception_host_info()
+{
+	return requete_rpc(RPC_HOST_INFO);
+}
+
 int reception_active_result()
 {
-	RPC_CLIENT rpc;
-	int retval;
-	if ((dernier_chargement>0) && (time(NULL)<dernier_chargement+31))
-	{
-		boinc_sleep(31-time(NULL)+dernier_chargement);
-		fprintf(stderr, "%s Mise en veille (derniere requete date de moins de 30 secondes\n",boinc_msg_prefix(buf, sizeof(buf)));
-	}
-	retval = rpc.init("127.0.0.1", port);
-	if (retval) {
-		fprintf(stderr, "%s can't connect to localhost",boinc_msg_prefix(buf, sizeof(buf)));
-		return -1;
-	}
-	retval = rpc.get_results(results,true);
-	return retval;
+	return requete_rpc(RPC_ACTIVE_RESULTS);
 }
 
-int reception_result()
+int reception_state()
 {
-	RPC_CLIENT rpc;
-	int retval;
-	if ((dernier_chargement>0) && (time(NULL)<dernier_chargement+31))
+	return requete_rpc(RPC_STATE);
+}
+
+// Empreinte de l'etat d'un resultat, pour ne retraiter que les resultats qui ont change
+unsigned long hash_result(RESULT* result)
+{
+	unsigned long hash=2166136261UL;
+	int champs[6];
+	champs[0]=result->state;
+	champs[1]=result->active_task;
+	champs[2]=result->active_task_state;
+	champs[3]=result->suspended_via_gui;
+	champs[4]=result->project_suspended_via_gui;
+	champs[5]=result->version_num;
+	for (const char* c=result->name; *c; c++) hash=(hash^(unsigned char)*c)*16777619UL;
+	for (int i=0; i<6; i++) hash=(hash^(unsigned long)champs[i])*16777619UL;
+	return hash;
+}
+
+// Resultat en cours de calcul: releve a chaque cycle
+bool en_calcul(RESULT* result)
+{
+	return result->state==2 && !result->suspended_via_gui && !result->project_suspended_via_gui && result->active_task && result->active_task_state==1;
+}
+
+void indexation(map<string, pugi::xml_node>& index, const char* noeud, const char* cle)
+{
+	index.clear();
+	pugi::xml_node client_state=doc_state.child("client_state");
+	for (pugi::xml_node n = client_state.child(noeud); n; n = n.next_sibling(noeud))
 	{
-		boinc_sleep(31-time(NULL)+dernier_chargement);
-		fprintf(stderr, "%s Mise en veille (derniere requete date de moins de 30 secondes\n",boinc_msg_prefix(buf, sizeof(buf)));
-	}
-	retval = rpc.init("127.0.0.1", port);
-	if (retval) {
-		fprintf(stderr, "%s can't connect to localhost\n",boinc_msg_prefix(buf, sizeof(buf)));
-		return -1;
+		index.insert(make_pair(string(n.child_value(cle)), n));
 	}
-	retval = rpc.get_results(results_all,false);
-	return retval;
 }
 
-int reception_state()
+void indexation_client_state()
 {
-	RPC_CLIENT rpc;
-	int retval;
-	if ((dernier_chargement>0) && (time(NULL)<dernier_chargement+31))
+	indexation(index_projet, "project", "master_url");
+	indexation(index_workunit, "workunit", "name");
+	indexation(index_app, "app", "name");
+	index_app_version.clear();
+	pugi::xml_node client_state=doc_state.child("client_state");
+	for (pugi::xml_node n = client_state.child("app_version"); n; n = n.next_sibling("app_version"))
 	{
-		boinc_sleep(31-time(NULL)+dernier_chargement);
-		fprintf(stderr, "%s Mise en veille (derniere requete date de moins de 30 secondes\n",boinc_msg_prefix(buf, sizeof(buf)));
+		index_app_version.insert(make_pair(string(n.child_value("app_name"))+"_"+n.child_value("version_num"), n));
 	}
-	retval = rpc.init("127.0.0.1", port);
-	if (retval) {
-		fprintf(stderr, "%s can't connect to localhost",boinc_msg_prefix(buf, sizeof(buf)));
-		return -1;
-	}
-	retval = rpc.get_state(gstate);
-	return retval;
+}
+
+pugi::xml_node recherche_index(map<string, pugi::xml_node>& index, const string& cle)
+{
+	map<string, pugi::xml_node>::iterator it_index=index.find(cle);
+	if (it_index==index.end()) return pugi::xml_node();
+	return (*it_index).second;
 }
 
 bool chargement_client_state()
@@ -482,6 +872,7 @@ bool chargement_client_state()
 		pugi::xml_parse_result xml_parse_result = doc_state.load_file((path_state+"/client_state.xml").c_str());
 		if (xml_parse_result)
 		{
+			indexation_client_state();
 			chargement_state=true;
 			format_state="file";
 			return true;
@@ -510,7 +901,7 @@ void recherche_nom_projet()
 {
 	if (format_state=="file")
 	{
-		project_name=doc_state.select_single_node(("/client_state/project[master_url='"+project_url+"']").c_str()).node().child_value("project_name");
+		project_name=recherche_index(index_projet, project_url).child_value("project_name");
 	}
 	else
 	{
@@ -530,7 +921,7 @@ void recherche_hostid_projet()
 {
 	if (format_state=="file")
 	{
-		hostid_projet=doc_state.select_single_node(("/client_state/project[master_url='"+project_url+"']").c_str()).node().child_value("hostid");
+		hostid_projet=recherche_index(index_projet, project_url).child_value("hostid");
 	}
 	else
 	{
@@ -554,7 +945,7 @@ void recherche_nom_application()
 {
 	if (format_state=="file")
 	{
-		app_name=doc_state.select_single_node(("/client_state/workunit[name='"+wu_name+"']").c_str()).node().child_value("app_name");
+		app_name=recherche_index(index_workunit, wu_name).child_value("app_name");
 	}
 	else
 	{
@@ -574,7 +965,7 @@ void recherche_nom_courant_application()
 {
 	if (format_state=="file")
 	{
-		user_friendly_name=doc_state.select_single_node(("/client_state/app[name='"+app_name+"']").c_str()).node().child_value("user_friendly_name");
+		user_friendly_name=recherche_index(index_app, app_name).child_value("user_friendly_name");
 	}
 	else
 	{
@@ -604,7 +995,7 @@ void recherche_plateforme()
 	if (format_state=="file")
 	{
 		pugi::xml_node app_version;
-		app_version = doc_state.select_single_node(("/client_state/app_version[app_name='"+app_name+"' and version_num='"+str_version_num+"']").c_str()).node();
+		app_version = recherche_index(index_app_version, app_name+"_"+str_version_num);
 		if (dict_dl_app.find(app_name)==dict_dl_app.end())
 		{
 			taille=0;
@@ -643,12 +1034,127 @@ void recherche_plateforme()
 	}
 }
 
+// Resultat termine et recense: complete sa duree, son upload et son download
+void statistiques_terminee(RESULT* result)
+{
+	string result_name=result->name;
+	if (!result->ready_to_report || result->state!=5) return;
+	if (dict_result.find(result_name)==dict_result.end()) return;
+	project_url=result->project_url;
+	final_cpu_time=result->final_cpu_time;
+	strs.str("");
+	strs << (int)final_cpu_time;
+	str_final_cpu_time=strs.str();
+	plan_class=result->plan_class;
+	if (dict_duree.find(result_name)==dict_duree.end())
+	{
+		if ((plan_class!="") && (nb_gpu==1))
+		{
+			final_elapsed_time=result->final_elapsed_time;
+			strs.str("");
+			strs << (int)final_elapsed_time;
+			str_final_elapsed_time=strs.str();
+			dict_duree[result_name]=dict_result[result_name]+";"+str_final_cpu_time+";"+gpu+";"+str_final_elapsed_time;
+		}
+		else
+		{
+			dict_duree[result_name]=dict_result[result_name]+";"+str_final_cpu_time;
+		}
+	}
+	if (dict_tmp_upload.find(result_name)!=dict_tmp_upload.end())
+	{
+		dict_upload[result_name]=dict_result[result_name]+";"+dict_tmp_upload[result_name]+";"+str_final_cpu_time;
+		dict_tmp_upload.erase(result_name);
+	}
+	if (dict_download.find(result_name)!=dict_download.end())
+	{
+		if (dict_download[result_name]!="inconnu")
+		{
+			if (dict_download[result_name].substr(dict_download[result_name].length()-1,1)==";")
+			{	
+				dict_download[result_name]=dict_download[result_name]+plan_class+";"+str_final_cpu_time;
+			}
+		}
+	}
+}
+
+// WU recue depuis le dernier passage et pas encore vue active: comptee par projet et application
+void statistiques_new_wu(RESULT* result)
+{
+	received_time=result->received_time;
+	name=result->name;
+	wu_name=result->wu_name;
+	if (received_time<=last_new_wu) return;
+	if (dict_delai.find(name)!=dict_delai.end()) return;
+	project_url=result->project_url;
+	if (dict_project.find(project_url)==dict_project.end())
+	{
+		recherche_nom_projet();
+		if (project_name=="")
+		{
+			fprintf(stderr,"%s Erreur assignation project_name (recherche new_wu)\n",boinc_msg_prefix(buf, sizeof(buf)));
+			return;
+		}
+		dict_project[project_url]=project_name;
+	}
+	else
+	{
+		project_name=dict_project[project_url];
+	}
+	recherche_nom_application();
+	if (app_name=="")
+	{
+		fprintf(stderr,"%s Erreur assignation app_name (recherche new_wu)\n",boinc_msg_prefix(buf, sizeof(buf)));
+		return;
+	}
+	if (dict_app.find(app_name)==dict_app.end())
+	{
+		recherche_nom_courant_application();
+		if (user_friendly_name=="")
+		{
+			fprintf(stderr,"%s Erreur assignation user_friendly_name (recherche new_wu)\n",boinc_msg_prefix(buf, sizeof(buf)));
+			return;
+		}
+		dict_app[app_name]=user_friendly_name;
+	}
+	else
+	{
+		user_friendly_name=dict_app[app_name];
+	}
+	dict_new_wu[project_name+";"+user_friendly_name]++;
+}
+
+// Passe unique sur tous les resultats, a chaque reception: index par nom,
+// date de derniere vue, statistiques des resultats termines et, en fin de
+// tache (new_wu), comptage des nouvelles WU.
+void indexation_results(bool new_wu)
+{
+	int maintenant=time(NULL);
+	index_results.clear();
+	for (int i=0;i<results_all.results.size();i++)
+	{
+		index_results.insert(make_pair(string(results_all.results[i]->name), results_all.results[i]));
+		vu_resultat(results_all.results[i]->name, maintenant);
+		statistiques_terminee(results_all.results[i]);
+		if (new_wu) statistiques_new_wu(results_all.results[i]);
+	}
+}
+
+int reception_result(bool new_wu=false)
+{
+	index_results.clear();
+	int retval=requete_rpc(RPC_RESULTS);
+	if (retval==0) indexation_results(new_wu);
+	return retval;
+}
+
 void recherche_new_wu()
 {
 	int retval;
 	
 	chargement_state=false;
-	retval=reception_result();
+	bool new_wu=chargement_client_state();
+	retval=reception_result(new_wu);
 	if (retval!=0)
 	{
 		fprintf(stderr,"%s Erreur reception result (new WU)\n",boinc_msg_prefix(buf, sizeof(buf)));
@@ -657,64 +1163,6 @@ void recherche_new_wu()
 	else
 	{
 		dernier_chargement=0;
-		if (chargement_client_state()==true)
-		{
-			for (int i=0;i<results_all.results.size();i++)
-			{
-				received_time=results_all.results[i]->received_time;
-				name=results_all.results[i]->name;
-				wu_name=results_all.results[i]->wu_name;
-				if (received_time> last_new_wu)
-				{
-					if (dict_delai.find(name)==dict_delai.end())
-					{
-						project_url=results_all.results[i]->project_url;
-						if (dict_project.find(project_url)==dict_project.end())
-						{
-							recherche_nom_projet();
-							if (project_name=="")
-							{
-								fprintf(stderr,"%s Erreur assignation project_name (recherche new_wu)\n",boinc_msg_prefix(buf, sizeof(buf)));
-								continue;
-							}
-							dict_project[project_url]=project_name;
-						}
-						else
-						{
-							project_name=dict_project[project_url];
-						}
-						recherche_nom_application();
-						if (app_name=="")
-						{
-							fprintf(stderr,"%s Erreur assignation app_name (recherche new_wu)\n",boinc_msg_prefix(buf, sizeof(buf)));
-							continue;
-						}
-						if (dict_app.find(app_name)==dict_app.end())
-						{
-							recherche_nom_courant_application();
-							if (user_friendly_name=="")
-							{
-								fprintf(stderr,"%s Erreur assignation user_friendly_name (recherche new_wu)\n",boinc_msg_prefix(buf, sizeof(buf)));
-								continue;
-							}
-							dict_app[app_name]=user_friendly_name;
-						}
-						else
-						{
-							user_friendly_name=dict_app[app_name];
-						}
-						if (dict_new_wu.find(project_name+";"+user_friendly_name)==dict_new_wu.end())
-						{
-							dict_new_wu[project_name+";"+user_friendly_name]=1;
-						}
-						else
-						{
-							dict_new_wu[project_name+";"+user_friendly_name]=dict_new_wu[project_name+";"+user_friendly_name]+1;
-						}
-					}
-				}
-			}
-		}
 	}
 	last_new_wu=time(NULL);
 	for ( it_int=dict_new_wu.begin() ; it_int !=dict_new_wu.end(); it_int++)
@@ -743,59 +1191,14 @@ int wu_terminee(string result_name)
 	}
 	if (chargement_state==true)
 	{
-		int indice=-1;			
-		for (int i=0;i<results_all.results.size();i++)
+		map<string, RESULT*>::iterator it_result=index_results.find(result_name);
+		if (it_result!=index_results.end())
 		{
-			if (strcmp(results_all.results[i]->name,result_name.c_str())==0)
+			RESULT* result=(*it_result).second;
+			if (result->ready_to_report==true)
 			{
-				indice=i;
-				break;
-			}
-		}			
-		if (indice>0)
-		{
-			if (results_all.results[indice]->ready_to_report==true)
-			{
-				if (results_all.results[indice]->state==5)
-				{
-					project_url=results_all.results[indice]->project_url;
-					final_cpu_time=results_all.results[indice]->final_cpu_time;
-					strs.str("");
-					strs << (int)final_cpu_time;
-					str_final_cpu_time=strs.str();
-					plan_class=results_all.results[indice]->plan_class;
-					if (dict_duree.find(result_name)==dict_duree.end())
-					{
-						if ((plan_class!="") && (nb_gpu==1))
-						{
-							final_elapsed_time=results_all.results[indice]->final_elapsed_time;
-							strs.str("");
-							strs << (int)final_elapsed_time;
-							str_final_elapsed_time=strs.str();
-							dict_duree[result_name]=dict_result[result_name]+";"+str_final_cpu_time+";"+gpu+";"+str_final_elapsed_time;
-						}
-						else
-						{
-							dict_duree[result_name]=dict_result[result_name]+";"+str_final_cpu_time;
-						}											
-					}
-					if (dict_tmp_upload.find(result_name)!=dict_tmp_upload.end())
-					{
-						dict_upload[result_name]=dict_result[result_name]+";"+dict_tmp_upload[result_name]+";"+str_final_cpu_time;
-						dict_tmp_upload.erase(result_name);
-					}
-					if (dict_download.find(result_name)!=dict_download.end())
-					{
-						if (dict_download[result_name]!="inconnu")
-						{
-							if (dict_download[result_name].substr(dict_download[result_name].length()-1,1)==";")
-							{	
-								dict_download[result_name]=dict_download[result_name]+plan_class+";"+str_final_cpu_time;
-							}
-						}
-					}
-				}
-				else
+				// duree, upload et download ont ete completes par la passe d'indexation
+				if (result->state!=5)
 				{
 					fprintf(stderr, "%s Erreur wu_terminee (wu en erreur)\n",boinc_msg_prefix(buf, sizeof(buf)));
 					return 0;
@@ -1046,12 +1449,7 @@ int main(int argc, char** argv)
 		perror("open");
 		exit(1);
 	}
-	state=boinc_fopen(cache_path, "r");
-	if (state)
-	{
-		restore_cache();
-		fclose(state);
-	}
+	restore_cache();
 	if (last_new_wu==0) last_new_wu=start_compute;
 	
 	out.printf("%s method 3;%d\n",boinc_msg_prefix(buf, sizeof(buf)),frequence());
@@ -1194,10 +1592,17 @@ int main(int argc, char** argv)
 			else
 			{
 				dernier_chargement=0;
+				int maintenant=time(NULL);
 				for (int i=0;i<results.results.size();i++)
 				{
 					name=results.results[i]->name;
 					project_url=results.results[i]->project_url;
+					vu_resultat(name, maintenant);
+					unsigned long hash=hash_result(results.results[i]);
+					if (!en_calcul(results.results[i]) && dict_hash.find(name)!=dict_hash.end() && dict_hash[name]==hash && dict_result.find(name)!=dict_result.end())
+					{ //resultat inchange depuis le dernier cycle, et toujours recense
+						continue;
+					}
 					if (dict_result.find(name)==dict_result.end())
 					{ //resultat non recence
 						if (chargement_client_state()==true)
@@ -1233,7 +1638,7 @@ int main(int argc, char** argv)
 							if (format_state=="file")
 							{
 								pugi::xml_node workunit;
-								workunit = doc_state.select_single_node(("/client_state/workunit[name='"+wu_name+"']").c_str()).node();
+								workunit = recherche_index(index_workunit, wu_name);
 								taille=0.0;
 								bool erreur_taille=false;
 								for (pugi::xml_node file_ref = workunit.child("file_ref"); file_ref; file_ref = file_ref.next_sibling("file_ref"))
@@ -1295,14 +1700,7 @@ int main(int argc, char** argv)
 								str_received_time=strs.str();
 								if (received_time>last_new_wu)
 								{
-									if (dict_new_wu.find(project_name+";"+user_friendly_name)==dict_new_wu.end())
-									{
-										dict_new_wu[project_name+";"+user_friendly_name]=1;
-									}
-									else
-									{
-										dict_new_wu[project_name+";"+user_friendly_name]=dict_new_wu[project_name+";"+user_friendly_name]+1;
-									}
+									dict_new_wu[project_name+";"+user_friendly_name]++;
 								}
 								dict_delai[name]=str_received_time+";"+str_report_deadline;
 								out.printf("%d;delai;%s;%s;;%s;%s\n", start, project_name.c_str(),dict_app[app_name].c_str(),str_received_time.c_str(),str_report_deadline.c_str());
@@ -1315,6 +1713,10 @@ int main(int argc, char** argv)
 							break;
 						}
 					}
+					else if (dict_project.find(project_url)!=dict_project.end())
+					{
+						project_name=dict_project[project_url];
+					}
 					else
 					{
 						if (chargement_client_state()==true)
@@ -1336,6 +1738,7 @@ int main(int argc, char** argv)
 							break;
 						}
 					}
+					dict_hash[name]=hash;
 					wu_state=results.results[i]->state;
 					if (wu_state==2)
 					{
@@ -1441,18 +1844,14 @@ int main(int argc, char** argv)
 				}				
 				liste.clear();
 				chargement_state=false;
+				set<string> noms_actifs;
+				for (int i=0;i<results.results.size();i++)
+				{
+					noms_actifs.insert(results.results[i]->name);
+				}
 				for (it=dict_result.begin(); it!=dict_result.end(); it++)
 				{
-					bool termine;				
-					for (int i=0;i<results.results.size();i++)
-					{
-						termine=true;						
-						if (strcmp(results.results[i]->name,(*it).first.c_str())==0)
-						{
-							termine=false;
-							break;
-						}
-					}			
+					bool termine=(noms_actifs.find((*it).first)==noms_actifs.end());
 					if (termine)
 					{
 						retval=wu_terminee((*it).first);
@@ -1510,6 +1909,8 @@ int main(int argc, char** argv)
 								dict_size_file_result.erase(name+"_"+num);
 							}
 							dict_nb_file_result.erase(name);
+							dict_hash.erase(name);
+							dict_vu.erase(name);
 							liste.push_back(name);															
 						}
 						else if (retval==-2)
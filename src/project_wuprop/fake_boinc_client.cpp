@@ -0,0 +1,306 @@
+// Test harness for the BOINC runtime in lib/ (boinc_api.cpp, api_channel.h),
+// without a BOINC client: the parent process plays the client,
+// the child process is an app using the runtime.
+// They talk through the mmap'ed shared memory file, as a real client would.
+//
+// Usage: fake_boinc_client [-t seconds] [-e]
+//   -t  run time of the app (10 by default, at least 4)
+//   -e  checkpoint on BOINC_EVENT_CHECKPOINT directly,
+//       without boinc_time_to_checkpoint()
+//
+// The app:
+//   - reports progress with boinc_fraction_done() in a tight loop,
+//   - handles BOINC_EVENT_* from boinc_get_event(),
+//     checkpointing (0.1 s, 1 MB) on BOINC_EVENT_CHECKPOINT
+//     through boinc_time_to_checkpoint() (or directly with -e);
+//     checkpoints are timed either way, and with an allowed
+//     overhead of 5% they end up 2 s apart,
+//   - registers a timer callback that calls boinc_get_fraction_done()
+//     and boinc_get_checkpoint_stats() from the timer thread.
+// The client:
+//   - sends heartbeats, then suspend, resume and quit,
+//   - checks the fraction done and checkpoint stats of the status messages.
+// Event latencies and any inconsistency are printed;
+// the exit status is 0 only if every check passed.
+//
+// Run it in an empty directory: it writes init_data.xml, boinc_mmap_file,
+// the checkpoint file and stderr.txt (the app's stderr) there.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include <sys/select.h>
+#include <signal.h>
+
+#include "boinc_api.h"
+#include "app_ipc.h"
+#include "shmem.h"
+#include "diagnostics.h"
+#include "parse.h"
+
+#define TICK 0.05
+    // seconds between client polls
+
+static double now() {
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec*1e-6;
+}
+
+// messages from the app to the client (through a pipe)
+//
+struct APP_REPORT {
+    int event;
+        // BOINC_EVENT_*, or 0 for the final report
+    double time;
+    long callbacks;
+        // final report: timer callbacks run
+    long callback_errors;
+        // final report: callbacks that saw fraction done go backwards
+        // or outside [0,1], or checkpoint stats go backwards
+};
+
+static int report_fd;
+static long callbacks = 0;
+static long callback_errors = 0;
+static double callback_fraction_done = 0;
+static int callback_checkpoint_count = 0;
+
+static void send_report(int event) {
+    APP_REPORT r;
+    r.event = event;
+    r.time = now();
+    r.callbacks = callbacks;
+    r.callback_errors = callback_errors;
+    if (write(report_fd, &r, sizeof(r)) != sizeof(r)) _exit(1);
+}
+
+// runs in the timer thread
+//
+static void timer_callback() {
+    BOINC_CHECKPOINT_STATS cs;
+    double fd = boinc_get_fraction_done();
+    boinc_get_checkpoint_stats(&cs);
+    callbacks++;
+    if (fd < callback_fraction_done || fd > 1) callback_errors++;
+    if (cs.count < callback_checkpoint_count) callback_errors++;
+    callback_fraction_done = fd;
+    callback_checkpoint_count = cs.count;
+}
+
+static void write_checkpoint() {
+    double end = now() + 0.1;
+    while (now() < end) usleep(10000);
+    FILE* f = fopen("checkpoint", "w");
+    if (f) {
+        fprintf(f, "%f\n", boinc_get_fraction_done());
+        fclose(f);
+    }
+    boinc_checkpoint_size(1e6);
+    boinc_checkpoint_completed();
+}
+
+static void app(double run_time, bool direct_checkpoint) {
+    BOINC_OPTIONS options;
+    int event;
+    double x = 0, step;
+
+    boinc_options_defaults(options);
+    options.direct_process_action = 0;
+    options.backwards_compatible_graphics = 0;
+    boinc_init_diagnostics(BOINC_DIAG_DEFAULTS);
+    if (boinc_init_options(&options)) _exit(1);
+    boinc_register_timer_callback(timer_callback);
+    boinc_set_checkpoint_overhead(0.05);
+    boinc_get_event(&event);
+        // start queueing events
+
+    // reach fraction done 1 in about run_time seconds of work
+    //
+    double start = now();
+    for (int i=0; i<1000000; i++) boinc_fraction_done(0);
+    step = (now()-start)/1000000/run_time;
+
+    bool quit = false;
+    while (!quit) {
+        for (int i=0; i<1000000; i++) {
+            x += step;
+            boinc_fraction_done(x>1 ? 1 : x);
+        }
+        while (boinc_get_event(&event)) {
+            send_report(event);
+            switch (event) {
+            case BOINC_EVENT_CHECKPOINT:
+                if (direct_checkpoint || boinc_time_to_checkpoint()) {
+                    write_checkpoint();
+                }
+                break;
+            case BOINC_EVENT_QUIT:
+            case BOINC_EVENT_ABORT:
+                quit = true;
+                break;
+            }
+        }
+    }
+    send_report(0);
+    _exit(0);
+}
+
+int main(int argc, char** argv) {
+    double run_time = 10;
+    bool direct_checkpoint = false;
+    for (int i=1; i<argc; i++) {
+        if (!strcmp(argv[i], "-t") && i<argc-1) run_time = atof(argv[++i]);
+        if (!strcmp(argv[i], "-e")) direct_checkpoint = true;
+    }
+    if (run_time < 4) run_time = 4;
+
+    FILE* f = fopen("init_data.xml", "w");
+    if (!f) {
+        perror("init_data.xml");
+        return 1;
+    }
+    fprintf(f,
+        "<app_init_data>\n"
+        "<shm_key>-1</shm_key>\n"
+        "<checkpoint_period>1</checkpoint_period>\n"
+        "<fraction_done_start>0</fraction_done_start>\n"
+        "<fraction_done_end>1</fraction_done_end>\n"
+        "</app_init_data>\n"
+    );
+    fclose(f);
+    unlink("boinc_lockfile");
+
+    SHARED_MEM* shm;
+    if (create_shmem_mmap(MMAPPED_FILE_NAME, sizeof(SHARED_MEM), (void**)&shm)) {
+        fprintf(stderr, "can't create %s\n", MMAPPED_FILE_NAME);
+        return 1;
+    }
+    memset(shm, 0, sizeof(SHARED_MEM));
+
+    int pfd[2];
+    if (pipe(pfd)) {
+        perror("pipe");
+        return 1;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return 1;
+    }
+    if (!pid) {
+        close(pfd[0]);
+        report_fd = pfd[1];
+        app(run_time, direct_checkpoint);
+    }
+    close(pfd[1]);
+
+    // suspend for a second at 40% of the run, quit at the end
+    //
+    int ticks = (int)(run_time/TICK);
+    int suspend_tick = ticks*2/5;
+    int resume_tick = suspend_tick + (int)(1/TICK);
+    double sent[BOINC_EVENT_QUIT+1] = {0};
+    char buf[MSG_CHANNEL_SIZE];
+    double last_fd = -1, fd, d;
+    int last_count = 0, count, period = 0;
+    int msgs = 0, errors = 0, checkpoints = 0;
+    long app_callbacks = -1, app_callback_errors = 0;
+    bool done = false;
+    double start = now();
+
+    for (int tick=0; !done; tick++) {
+        usleep((int)(TICK*1e6));
+        shm->heartbeat.send_msg((char*)"<heartbeat/>");
+        if (tick == suspend_tick) {
+            shm->process_control_request.send_msg((char*)"<suspend/>");
+            sent[BOINC_EVENT_SUSPEND] = now();
+        }
+        if (tick == resume_tick) {
+            shm->process_control_request.send_msg((char*)"<resume/>");
+            sent[BOINC_EVENT_RESUME] = now();
+        }
+        if (tick == ticks) {
+            shm->process_control_request.send_msg((char*)"<quit/>");
+            sent[BOINC_EVENT_QUIT] = now();
+        }
+        if (tick > ticks + (int)(10/TICK)) {
+            fprintf(stderr, "app didn't quit\n");
+            kill(pid, SIGKILL);
+            errors++;
+            break;
+        }
+
+        if (shm->app_status.get_msg(buf)) {
+            msgs++;
+            if (parse_double(buf, "<fraction_done>", fd)) {
+                if (fd < last_fd || fd > 1) {
+                    printf("status: fraction done %f after %f\n", fd, last_fd);
+                    errors++;
+                }
+                last_fd = fd;
+            }
+            if (parse_int(buf, "<checkpoint_count>", count)) {
+                if (count < last_count) {
+                    printf("status: checkpoint count %d after %d\n", count, last_count);
+                    errors++;
+                }
+                last_count = count;
+                parse_double(buf, "<checkpoint_seconds>", d);
+                if (d < 0.1*count) {
+                    printf("status: %d checkpoints took only %f s\n", count, d);
+                    errors++;
+                }
+                parse_int(buf, "<checkpoint_period>", period);
+            }
+        }
+
+        APP_REPORT r;
+        fd_set s;
+        struct timeval tv = {0, 0};
+        FD_ZERO(&s);
+        FD_SET(pfd[0], &s);
+        while (select(pfd[0]+1, &s, 0, 0, &tv) > 0) {
+            if (read(pfd[0], &r, sizeof(r)) != sizeof(r)) {
+                done = true;
+                break;
+            }
+            if (r.event == 0) {
+                app_callbacks = r.callbacks;
+                app_callback_errors = r.callback_errors;
+            } else if (r.event == BOINC_EVENT_CHECKPOINT) {
+                checkpoints++;
+            } else if (r.event <= BOINC_EVENT_QUIT) {
+                printf("event %d: latency %.1f ms\n", r.event, (r.time - sent[r.event])*1e3);
+            } else {
+                printf("event %d at %.2f s\n", r.event, r.time - start);
+            }
+            FD_ZERO(&s);
+            FD_SET(pfd[0], &s);
+        }
+    }
+
+    int status;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+        printf("app exited abnormally (status %d)\n", status);
+        errors++;
+    }
+    if (app_callbacks <= 0) {
+        printf("no timer callbacks reported\n");
+        errors++;
+    }
+    errors += app_callback_errors;
+    printf("%d status messages, last fraction done %.4f\n", msgs, last_fd);
+    printf("%d checkpoint events, %d checkpoints reported, period %d s\n",
+        checkpoints, last_count, period
+    );
+    printf("%ld timer callbacks, %ld saw inconsistent values\n",
+        app_callbacks, app_callback_errors
+    );
+    printf("%s\n", errors ? "FAILED" : "OK");
+    return errors ? 1 : 0;
+}
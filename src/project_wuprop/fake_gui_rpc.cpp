@@ -0,0 +1,297 @@
+// Faux client BOINC pour tester le collecteur sans BOINC:
+// repond aux requetes GUI RPC utilisees par data_collect
+// (get_cc_status, get_host_info, get_results, get_state)
+// avec un projet dont les resultats avancent a chaque cycle.
+//
+// Usage: fake_gui_rpc [-p port] [-n resultats] [-f cycles] [-d requetes]
+//   -p  port d'ecoute (31416 par defaut)
+//   -n  nombre de resultats en file (20 par defaut), dont 4 en calcul
+//   -f  un resultat se termine tous les f cycles (1 par defaut)
+//   -d  ferme la connexion toutes les d requetes, pour tester la reconnexion (0: jamais)
+//
+// Un cycle est une requete get_results des resultats actifs.
+// Les resultats termines passent en ready_to_report (etat 5) et ne sont plus actifs;
+// ils disparaissent de la liste complete deux cycles plus tard (reportes).
+// A chaque fermeture de connexion, le nombre de requetes par type est affiche,
+// ce qui permet de verifier que data_collect garde une seule connexion ouverte.
+//
+// Exemple: ./fake_gui_rpc -p 31500 -n 1000 &
+//          mkdir test && ./data_collect -p 31500 -t test -c 2 -n 5
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+using namespace std;
+
+#define PROJECT_URL "http://fake.wuprop.test/"
+#define NB_CPU 4
+
+struct FAKE_RESULT
+{
+	string name;
+	string wu_name;
+	int received_time;
+	int state;
+	bool ready_to_report;
+	bool active_task;
+	double cpu_time;
+	int termine;	// cycle de fin de calcul
+};
+
+vector<FAKE_RESULT> fake_results;
+int nb_resultats=20;
+int frequence_fin=1;
+int cycle=0;
+int numero=0;
+
+void nouveau_resultat()
+{
+	char nom[64];
+	FAKE_RESULT r;
+	sprintf(nom, "fake_wu_%d", numero);
+	r.wu_name=nom;
+	sprintf(nom, "fake_wu_%d_0", numero);
+	r.name=nom;
+	r.received_time=time(NULL);
+	r.state=2;
+	r.ready_to_report=false;
+	r.active_task=false;
+	r.cpu_time=0;
+	r.termine=0;
+	numero++;
+	fake_results.push_back(r);
+}
+
+// avance d'un cycle: les calculs progressent, un resultat se termine
+// tous les frequence_fin cycles et est remplace par un nouveau
+void avance_cycle()
+{
+	cycle++;
+	vector<FAKE_RESULT> restants;
+	for (size_t i=0; i<fake_results.size(); i++)
+	{
+		if (fake_results[i].ready_to_report && cycle-fake_results[i].termine>2) continue;
+		restants.push_back(fake_results[i]);
+	}
+	fake_results.swap(restants);
+	bool fin=(cycle%frequence_fin==0);
+	int en_calcul=0;
+	for (size_t i=0; i<fake_results.size(); i++)
+	{
+		FAKE_RESULT& r=fake_results[i];
+		if (r.ready_to_report) continue;
+		if (r.active_task && fin)
+		{
+			r.active_task=false;
+			r.state=5;
+			r.ready_to_report=true;
+			r.termine=cycle;
+			fin=false;
+			nouveau_resultat();
+			continue;
+		}
+		if (!r.active_task && en_calcul<NB_CPU) r.active_task=true;
+		if (r.active_task)
+		{
+			r.cpu_time+=60;
+			en_calcul++;
+		}
+	}
+}
+
+void ajoute_resultat(string& reponse, FAKE_RESULT& r, int slot)
+{
+	char tampon[1024];
+	sprintf(tampon,
+		"<result>\n"
+		"<name>%s</name>\n"
+		"<wu_name>%s</wu_name>\n"
+		"<version_num>100</version_num>\n"
+		"<plan_class></plan_class>\n"
+		"<project_url>%s</project_url>\n"
+		"<report_deadline>%d</report_deadline>\n"
+		"<received_time>%d</received_time>\n"
+		"<state>%d</state>\n"
+		"<final_cpu_time>%f</final_cpu_time>\n"
+		"<final_elapsed_time>%f</final_elapsed_time>\n",
+		r.name.c_str(), r.wu_name.c_str(), PROJECT_URL,
+		r.received_time+7*86400, r.received_time, r.state,
+		r.ready_to_report ? r.cpu_time : 0, r.ready_to_report ? r.cpu_time : 0
+	);
+	reponse+=tampon;
+	if (r.ready_to_report) reponse+="<ready_to_report/>\n";
+	if (r.active_task)
+	{
+		sprintf(tampon,
+			"<active_task>\n"
+			"<active_task_state>1</active_task_state>\n"
+			"<slot>%d</slot>\n"
+			"<checkpoint_cpu_time>%f</checkpoint_cpu_time>\n"
+			"<current_cpu_time>%f</current_cpu_time>\n"
+			"<elapsed_time>%f</elapsed_time>\n"
+			"<working_set_size_smoothed>%f</working_set_size_smoothed>\n"
+			"<estimated_cpu_time_remaining>%f</estimated_cpu_time_remaining>\n"
+			"</active_task>\n",
+			slot, r.cpu_time, r.cpu_time, r.cpu_time, 1e8, 3600.0
+		);
+		reponse+=tampon;
+	}
+	reponse+="</result>\n";
+}
+
+void reponse_results(string& reponse, bool actifs)
+{
+	if (actifs) avance_cycle();
+	reponse+="<results>\n";
+	int slot=0;
+	for (size_t i=0; i<fake_results.size(); i++)
+	{
+		if (actifs && fake_results[i].ready_to_report) continue;
+		ajoute_resultat(reponse, fake_results[i], fake_results[i].active_task ? slot++ : -1);
+	}
+	reponse+="</results>\n";
+}
+
+void reponse_state(string& reponse)
+{
+	reponse+=
+		"<client_state>\n"
+		"<project>\n"
+		"<master_url>" PROJECT_URL "</master_url>\n"
+		"<project_name>Fake project</project_name>\n"
+		"<hostid>42</hostid>\n"
+		"</project>\n"
+		"<app>\n"
+		"<name>fake_app</name>\n"
+		"<user_friendly_name>Fake application</user_friendly_name>\n"
+		"</app>\n"
+		"<app_version>\n"
+		"<app_name>fake_app</app_name>\n"
+		"<version_num>100</version_num>\n"
+		"<platform>x86_64-pc-linux-gnu</platform>\n"
+		"</app_version>\n";
+	for (size_t i=0; i<fake_results.size(); i++)
+	{
+		reponse+="<workunit>\n<name>"+fake_results[i].wu_name+"</name>\n<app_name>fake_app</app_name>\n</workunit>\n";
+	}
+	reponse+="</client_state>\n";
+}
+
+// requetes par type, pour la connexion courante
+#define NB_TYPES 5
+const char* noms_types[NB_TYPES]={"get_cc_status", "get_host_info", "get_results", "get_state", "autre"};
+
+int traite_requete(const string& requete, string& reponse)
+{
+	reponse="<boinc_gui_rpc_reply>\n";
+	int type;
+	if (requete.find("<get_cc_status")!=string::npos)
+	{
+		type=0;
+		reponse+="<cc_status>\n<network_suspend_reason>0</network_suspend_reason>\n</cc_status>\n";
+	}
+	else if (requete.find("<get_host_info")!=string::npos)
+	{
+		type=1;
+		reponse+="<host_info>\n<p_ncpus>4</p_ncpus>\n<p_model>cpu</p_model>\n</host_info>\n";
+	}
+	else if (requete.find("<get_results")!=string::npos)
+	{
+		type=2;
+		reponse_results(reponse, requete.find("<active_only>1</active_only>")!=string::npos);
+	}
+	else if (requete.find("<get_state")!=string::npos)
+	{
+		type=3;
+		reponse_state(reponse);
+	}
+	else
+	{
+		type=4;
+		reponse+="<error>unknown request</error>\n";
+	}
+	reponse+="</boinc_gui_rpc_reply>\n\003";
+	return type;
+}
+
+int main(int argc, char** argv)
+{
+	int port=31416;
+	int frequence_deconnexion=0;
+	for (int i=1; i<argc-1; i++)
+	{
+		if (!strcmp(argv[i], "-p")) port=atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-n")) nb_resultats=atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-f")) frequence_fin=atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-d")) frequence_deconnexion=atoi(argv[++i]);
+	}
+	if (frequence_fin<1) frequence_fin=1;
+	signal(SIGPIPE, SIG_IGN);
+	for (int i=0; i<nb_resultats; i++) nouveau_resultat();
+
+	int sock=socket(AF_INET, SOCK_STREAM, 0);
+	int un=1;
+	setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, (char*)&un, sizeof(un));
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family=AF_INET;
+	addr.sin_port=htons(port);
+	addr.sin_addr.s_addr=htonl(INADDR_LOOPBACK);
+	if (bind(sock, (struct sockaddr*)&addr, sizeof(addr)) || listen(sock, 5))
+	{
+		perror("fake_gui_rpc");
+		return 1;
+	}
+	fprintf(stderr, "fake_gui_rpc: port %d, %d resultats\n", port, nb_resultats);
+
+	int connexion=0;
+	while (true)
+	{
+		int client=accept(sock, NULL, NULL);
+		if (client<0) continue;
+		connexion++;
+		int requetes[NB_TYPES]={0};
+		int total=0;
+		string requete;
+		char tampon[8192];
+		bool ouverte=true;
+		while (ouverte)
+		{
+			int n=recv(client, tampon, sizeof(tampon), 0);
+			if (n<=0) break;
+			requete.append(tampon, n);
+			size_t fin;
+			while ((fin=requete.find('\003'))!=string::npos)
+			{
+				string reponse;
+				requetes[traite_requete(requete.substr(0, fin), reponse)]++;
+				requete.erase(0, fin+1);
+				if (send(client, reponse.data(), reponse.size(), 0)!=(int)reponse.size())
+				{
+					ouverte=false;
+					break;
+				}
+				total++;
+				if (frequence_deconnexion>0 && total%frequence_deconnexion==0)
+				{
+					ouverte=false;
+					break;
+				}
+			}
+		}
+		close(client);
+		fprintf(stderr, "fake_gui_rpc: connexion %d fermee apres %d requetes (cycle %d):", connexion, total, cycle);
+		for (int i=0; i<NB_TYPES; i++) fprintf(stderr, " %s %d", noms_types[i], requetes[i]);
+		fprintf(stderr, "\n");
+	}
+	return 0;
+}
@@ -0,0 +1,161 @@
+// This file is part of BOINC.
+// http://boinc.berkeley.edu
+// Copyright (C) 2008 University of California
+//
+// BOINC is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// BOINC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with BOINC.  If not, see <http://www.gnu.org/licenses/>.
+
+// Lock-free channels between the worker thread and the timer thread
+// of the BOINC runtime (see boinc_api.cpp).
+//
+// Neither side ever blocks or makes a system call,
+// so the worker can use them as often as it likes
+// (e.g. report progress every inner-loop iteration)
+// and the timer thread can use them while the worker is suspended.
+//
+// API_STATUS_SLOT: worker -> timer.
+//   The latest fraction done and checkpoint statistics, as a triple buffer:
+//   the writer fills its own buffer and swaps it with the middle one,
+//   the reader swaps its buffer with the middle one if that has newer values.
+//   Each side does one atomic exchange and never retries,
+//   so neither can be starved by the other
+//   (e.g. a worker reporting progress in a tight loop,
+//   or a worker suspended in the middle of an update).
+//   One writer thread (the worker) and one reader thread (the timer).
+//
+// API_EVENT_RING: timer -> worker.
+//   A fixed-size queue of BOINC_EVENT_* codes
+//   (suspend, resume, quit, abort, checkpoint).
+//   Exactly one producer thread and one consumer thread;
+//   head is written only by the producer, tail only by the consumer.
+//   If the consumer falls behind by API_EVENT_RING_SIZE events,
+//   new events are dropped; the flags from boinc_get_status()
+//   always have the current state.
+//
+// Only plain loads and stores of aligned words, full memory barriers
+// and an atomic exchange are used, since this must build with pre-C++11 compilers.
+
+#ifndef _API_CHANNEL_
+#define _API_CHANNEL_
+
+#if defined(_MSC_VER)
+#define API_CHANNEL_BARRIER() MemoryBarrier()
+#define API_CHANNEL_XCHG(p, v) InterlockedExchange((volatile LONG*)(p), (v))
+#elif defined(__i386__) || defined(__x86_64__)
+#define API_CHANNEL_BARRIER() __sync_synchronize()
+#define API_CHANNEL_XCHG(p, v) __sync_lock_test_and_set((p), (v))
+    // xchg is a full barrier on x86
+#else
+#define API_CHANNEL_BARRIER() __sync_synchronize()
+#define API_CHANNEL_XCHG(p, v) (API_CHANNEL_BARRIER(), __sync_lock_test_and_set((p), (v)))
+    // elsewhere __sync_lock_test_and_set() is only an acquire barrier
+#endif
+
+#define API_STATUS_NEW 4
+    // set in API_STATUS_SLOT::middle when it holds values the reader hasn't seen
+
+struct API_STATUS_SLOT {
+    struct VALUES {
+        double fraction_done;
+        double checkpoint_cpu_time;
+        int checkpoint_count;
+        double checkpoint_seconds;
+            // total time spent in timed checkpoints
+        double checkpoint_bytes;
+            // total bytes written, as reported by boinc_checkpoint_size()
+        int checkpoint_period;
+            // current interval between checkpoints
+    };
+    VALUES buf[3];
+    volatile long middle;
+        // index of the middle buffer, plus API_STATUS_NEW
+    int back;
+        // writer's buffer
+    int front;
+        // reader's buffer
+    VALUES last;
+        // the values last written (writer only)
+
+    void clear() {
+        last.fraction_done = -1;
+        last.checkpoint_cpu_time = 0;
+        last.checkpoint_count = 0;
+        last.checkpoint_seconds = 0;
+        last.checkpoint_bytes = 0;
+        last.checkpoint_period = 0;
+        for (int i=0; i<3; i++) buf[i] = last;
+        back = 0;
+        middle = 1;
+        front = 2;
+    }
+
+    // writer only: change "last", then publish it
+    //
+    void publish() {
+        buf[back] = last;
+        back = (int)API_CHANNEL_XCHG(&middle, (long)(back|API_STATUS_NEW)) & 3;
+    }
+    void write_fraction_done(double fd) {
+        last.fraction_done = fd;
+        publish();
+    }
+
+    // reader only; the latest values published
+    //
+    void read(VALUES& v) {
+        if (middle & API_STATUS_NEW) {
+            front = (int)API_CHANNEL_XCHG(&middle, (long)front) & 3;
+        }
+        v = buf[front];
+    }
+};
+
+#define API_EVENT_RING_SIZE 16
+    // must be a power of 2
+
+struct API_EVENT_RING {
+    volatile unsigned int head;
+        // number of events pushed
+    volatile unsigned int tail;
+        // number of events popped
+    volatile int events[API_EVENT_RING_SIZE];
+
+    void clear() {
+        head = tail = 0;
+    }
+
+    // producer only; returns false if the ring is full
+    //
+    bool push(int event) {
+        unsigned int h = head;
+        if (h - tail == API_EVENT_RING_SIZE) return false;
+        events[h & (API_EVENT_RING_SIZE-1)] = event;
+        API_CHANNEL_BARRIER();
+        head = h + 1;
+        return true;
+    }
+
+    // consumer only; returns false if the ring is empty
+    //
+    bool pop(int& event) {
+        unsigned int t = tail;
+        if (t == head) return false;
+        API_CHANNEL_BARRIER();
+        event = events[t & (API_EVENT_RING_SIZE-1)];
+        API_CHANNEL_BARRIER();
+        tail = t + 1;
+        return true;
+    }
+};
+
+#endif
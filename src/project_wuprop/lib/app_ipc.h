@@ -212,6 +212,7 @@ typedef struct GRAPHICS_INFO GRAPHICS_INFO;
 
 int write_init_data_file(FILE* f, APP_INIT_DATA&);
 int parse_init_data_file(FILE* f, APP_INIT_DATA&);
+int parse_init_data_file(MIOFILE&, APP_INIT_DATA&);
 int write_graphics_file(FILE* f, GRAPHICS_INFO* gi);
 int parse_graphics_file(FILE* f, GRAPHICS_INFO* gi);
 
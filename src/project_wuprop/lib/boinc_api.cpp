@@ -45,6 +45,9 @@
 //
 // 2) All variables that are accessed by two threads (i.e. worker and timer)
 //  MUST be declared volatile.
+//  Values that don't fit in one word (fraction done, checkpoint CPU time)
+//  and events for the worker go through the lock-free channels
+//  in api_channel.h instead.
 //
 // 3) For compatibility with C, we use int instead of bool various places
 //
@@ -93,6 +96,7 @@
 #include "app_ipc.h"
 
 #include "boinc_api.h"
+#include "api_channel.h"
 
 //#define DEBUG_BOINC_API
 
@@ -113,8 +117,21 @@ APP_CLIENT_SHM* app_client_shm = 0;
 static volatile int time_until_checkpoint;
     // time until enable checkpoint
     // time until report fraction done to core client
-static volatile double fraction_done;
-static volatile double last_checkpoint_cpu_time;
+static API_STATUS_SLOT worker_status;
+    // fraction done and checkpoint CPU time and stats;
+    // written by the worker thread, read by the timer thread
+static API_STATUS_SLOT::VALUES timer_status;
+    // the timer thread's copy of worker_status, refreshed every tick
+static API_EVENT_RING worker_events;
+    // events for the worker; pushed by the timer thread
+static volatile bool worker_wants_events = false;
+    // set on the first boinc_get_event() call;
+    // until then events aren't queued, so old ones don't pile up
+static bool sent_suspended = false;
+static bool sent_quit = false;
+static bool sent_abort = false;
+static bool sent_checkpoint = false;
+    // the state last passed to the worker as events (timer thread only)
 static volatile bool ready_to_checkpoint = false;
 static volatile int in_critical_section = 0;
 static volatile double last_wu_cpu_time;
@@ -158,22 +175,45 @@ static FUNC_PTR timer_callback = 0;
     // quit if no heartbeat from core in this #interrupts
 #define LOCKFILE_TIMEOUT_PERIOD 35
     // quit if we cannot aquire slot lock file in this #secs after startup
+#define DEFAULT_CHECKPOINT_OVERHEAD 0.01
+    // by default let checkpoints take up to 1% of the time
+#define MAX_CHECKPOINT_PERIOD_FACTOR 10
+    // never stretch the checkpoint period beyond this multiple
+    // of the user's, however slow checkpoints are
+
+static double checkpoint_overhead = DEFAULT_CHECKPOINT_OVERHEAD;
+static double checkpoint_start = 0;
+    // when boinc_time_to_checkpoint() returned 1 or boinc_get_event()
+    // returned BOINC_EVENT_CHECKPOINT (worker thread only)
+static bool checkpoint_critical_section = false;
+    // boinc_time_to_checkpoint() began a critical section
+    // that boinc_checkpoint_completed() must end (worker thread only)
+static double checkpoint_nbytes = 0;
+    // from boinc_checkpoint_size() (worker thread only)
+static double checkpoint_avg_seconds = 0;
+    // moving average of checkpoint durations (worker thread only)
 
 #ifdef _WIN32
 static HANDLE hSharedMem;
 HANDLE worker_thread_handle;
     // used to suspend worker thread, and to measure its CPU time
 DWORD timer_thread_id;
+static DWORD timer_thread_self;
 #else
 static volatile bool worker_thread_exit_flag = false;
 static volatile int worker_thread_exit_status;
     // the above are used by the timer thread to tell
     // the worker thread to exit
 static pthread_t timer_thread_handle;
+static pthread_t timer_thread_self;
 #ifndef GETRUSAGE_IN_TIMER_THREAD
 static struct rusage worker_thread_ru;
 #endif
 #endif
+static volatile bool timer_thread_started = false;
+    // set by the timer thread once timer_thread_self is valid.
+    // CreateThread() and pthread_create() may store the thread's id
+    // only after it has started running, so it records its own.
 
 static BOINC_OPTIONS options;
 static volatile BOINC_STATUS boinc_status;
@@ -304,11 +344,34 @@ double boinc_worker_thread_cpu_time() {
 //
 // This is called only from the timer thread (so no need for synch)
 //
-static bool update_app_progress(double cpu_t, double cp_cpu_t) {
+// checkpoint stats for app status messages, so the client's
+// log shows what checkpointing costs each task
+//
+static void append_checkpoint_stats(
+    char* msg_buf, const API_STATUS_SLOT::VALUES& v
+) {
+    char buf[256];
+    if (!v.checkpoint_count) return;
+    sprintf(buf,
+        "<checkpoint_count>%d</checkpoint_count>\n"
+        "<checkpoint_seconds>%e</checkpoint_seconds>\n"
+        "<checkpoint_bytes>%e</checkpoint_bytes>\n"
+        "<checkpoint_period>%d</checkpoint_period>\n",
+        v.checkpoint_count, v.checkpoint_seconds, v.checkpoint_bytes,
+        v.checkpoint_period
+    );
+    strlcat(msg_buf, buf, MSG_CHANNEL_SIZE);
+}
+
+static bool update_app_progress(double cpu_t) {
     char msg_buf[MSG_CHANNEL_SIZE], buf[256];
+    API_STATUS_SLOT::VALUES& v = timer_status;
 
     if (standalone) return true;
 
+    double fraction_done = v.fraction_done;
+    double cp_cpu_t = v.checkpoint_cpu_time;
+
     sprintf(msg_buf,
         "<current_cpu_time>%e</current_cpu_time>\n"
         "<checkpoint_cpu_time>%e</checkpoint_cpu_time>\n",
@@ -339,6 +402,7 @@ static bool update_app_progress(double cpu_t, double cp_cpu_t) {
         sprintf(buf, "<intops_cumulative>%e</intops_cumulative>\n", intops_cumulative);
         strlcat(msg_buf, buf, MSG_CHANNEL_SIZE);
     }
+    append_checkpoint_stats(msg_buf, v);
     return app_client_shm->shm->app_status.send_msg(msg_buf);
 }
 
@@ -432,9 +496,12 @@ int boinc_init_options_general(BOINC_OPTIONS& opt) {
     //
     initial_wu_cpu_time = aid.wu_cpu_time;
 
-    fraction_done = -1;
+    worker_status.clear();
+    worker_status.last.checkpoint_cpu_time = aid.wu_cpu_time;
+    worker_status.last.checkpoint_period = (int)aid.checkpoint_period;
+    worker_status.publish();
+    worker_events.clear();
     time_until_checkpoint = (int)aid.checkpoint_period;
-    last_checkpoint_cpu_time = aid.wu_cpu_time;
     last_wu_cpu_time = aid.wu_cpu_time;
 
     if (standalone) {
@@ -484,7 +551,7 @@ static void send_trickle_up_msg() {
 //
 int boinc_finish(int status) {
     char buf[256];
-    fraction_done = 1;
+    worker_status.write_fraction_done(1);
     fprintf(stderr,
         "%s called boinc_finish\n",
         boinc_msg_prefix(buf, sizeof(buf))
@@ -607,7 +674,7 @@ static void exit_from_timer_thread(int status) {
 // This is done at startup, and also if a "reread prefs" message is received
 //
 int boinc_parse_init_data_file() {
-    FILE* f;
+    MIOFILE mf;
     int retval;
     char buf[256];
 
@@ -625,9 +692,10 @@ int boinc_parse_init_data_file() {
         );
         return ERR_FOPEN;
     }
-    f = boinc_fopen(INIT_DATA_FILE, "r");
-    retval = parse_init_data_file(f, aid);
-    fclose(f);
+    retval = mf.init_mmap_read(INIT_DATA_FILE);
+    if (!retval) {
+        retval = parse_init_data_file(mf, aid);
+    }
     if (retval) {
         fprintf(stderr,
             "%s Can't parse init data file - running in standalone mode\n",
@@ -638,6 +706,9 @@ int boinc_parse_init_data_file() {
     return 0;
 }
 
+// call from the worker thread
+// (the checkpoint stats are the worker's own copy)
+//
 int boinc_report_app_status(
     double cpu_time,
     double checkpoint_cpu_time,
@@ -654,6 +725,7 @@ int boinc_report_app_status(
         checkpoint_cpu_time,
         _fraction_done
     );
+    append_checkpoint_stats(msg_buf, worker_status.last);
     app_client_shm->shm->app_status.send_msg(msg_buf);
     return 0;
 }
@@ -955,12 +1027,39 @@ static void graphics_cleanup() {
     if (ga_win.is_running()) ga_win.kill();
 }
 
+// pass changes in status to the worker as events.
+// Runs only in the timer thread, which is the ring's single producer
+// (handle_process_control_msg() can also run in the worker on Android,
+// so it only sets the flags that are compared here).
+//
+static void send_worker_events() {
+    if (!worker_wants_events) return;
+    if (boinc_status.suspended != sent_suspended) {
+        int event = boinc_status.suspended?BOINC_EVENT_SUSPEND:BOINC_EVENT_RESUME;
+        if (worker_events.push(event)) sent_suspended = boinc_status.suspended;
+    }
+    if (boinc_status.quit_request && !sent_quit) {
+        if (worker_events.push(BOINC_EVENT_QUIT)) sent_quit = true;
+    }
+    if (boinc_status.abort_request && !sent_abort) {
+        if (worker_events.push(BOINC_EVENT_ABORT)) sent_abort = true;
+    }
+    if (ready_to_checkpoint != sent_checkpoint) {
+        if (!ready_to_checkpoint) {
+            sent_checkpoint = false;
+        } else if (worker_events.push(BOINC_EVENT_CHECKPOINT)) {
+            sent_checkpoint = true;
+        }
+    }
+}
+
 // timer handler; runs in the timer thread
 //
 static void timer_handler() {
     char buf[256];
     if (g_sleep) return;
     interrupt_count++;
+    worker_status.read(timer_status);
     if (!boinc_status.suspended) {
         running_interrupt_count++;
     }
@@ -991,6 +1090,8 @@ static void timer_handler() {
         }
     }
 
+    send_worker_events();
+
     if (interrupt_count % TIMERS_PER_SEC) return;
 
 #ifdef DEBUG_BOINC_API
@@ -1029,7 +1130,7 @@ static void timer_handler() {
     if (options.send_status_msgs && !boinc_status.suspended) {
         double cur_cpu = boinc_worker_thread_cpu_time();
         last_wu_cpu_time = cur_cpu + initial_wu_cpu_time;
-        update_app_progress(last_wu_cpu_time, last_checkpoint_cpu_time);
+        update_app_progress(last_wu_cpu_time);
     }
     
     // If running under V5 client, notify the client if the graphics app exits
@@ -1054,7 +1155,10 @@ static void timer_handler() {
 #ifdef _WIN32
 
 DWORD WINAPI timer_thread(void *) {
-     
+    timer_thread_self = GetCurrentThreadId();
+    API_CHANNEL_BARRIER();
+    timer_thread_started = true;
+
     while (1) {
         Sleep((int)(TIMER_PERIOD*1000));
         timer_handler();
@@ -1071,6 +1175,9 @@ DWORD WINAPI timer_thread(void *) {
 #else
 
 static void* timer_thread(void*) {
+    timer_thread_self = pthread_self();
+    API_CHANNEL_BARRIER();
+    timer_thread_started = true;
     block_sigalrm();
     while(1) {
         boinc_sleep(TIMER_PERIOD);
@@ -1204,19 +1311,68 @@ int boinc_send_trickle_up(char* variety, char* p) {
 
 int boinc_time_to_checkpoint() {
     if (ready_to_checkpoint) {
-        boinc_begin_critical_section();
+        if (!checkpoint_critical_section) {
+            boinc_begin_critical_section();
+            checkpoint_critical_section = true;
+        }
+        if (!checkpoint_start) checkpoint_start = dtime();
         return 1;
     }
     return 0;
 }
 
+void boinc_checkpoint_size(double nbytes) {
+    checkpoint_nbytes = nbytes;
+}
+
+void boinc_set_checkpoint_overhead(double x) {
+    checkpoint_overhead = x;
+}
+
+// Seconds until the next checkpoint:
+// the user's period, or longer if at that period
+// checkpoints would take more than checkpoint_overhead of the time.
+//
+static int next_checkpoint_period() {
+    double period = aid.checkpoint_period;
+    if (checkpoint_overhead > 0 && checkpoint_avg_seconds > 0) {
+        double p = checkpoint_avg_seconds/checkpoint_overhead;
+        double max_period = aid.checkpoint_period*MAX_CHECKPOINT_PERIOD_FACTOR;
+        if (p > max_period) p = max_period;
+        if (p > period) period = p;
+    }
+    return (int)period;
+}
+
 int boinc_checkpoint_completed() {
     double cur_cpu;
+    API_STATUS_SLOT::VALUES& v = worker_status.last;
     cur_cpu = boinc_worker_thread_cpu_time();
     last_wu_cpu_time = cur_cpu + aid.wu_cpu_time;
-    last_checkpoint_cpu_time = last_wu_cpu_time;
-    time_until_checkpoint = (int)aid.checkpoint_period;
-    boinc_end_critical_section();
+
+    // checkpoints not started by boinc_time_to_checkpoint()
+    // or BOINC_EVENT_CHECKPOINT are counted but not timed
+    //
+    if (checkpoint_start) {
+        double t = dtime() - checkpoint_start;
+        if (t < 0) t = 0;
+        checkpoint_avg_seconds = checkpoint_avg_seconds?
+            0.7*checkpoint_avg_seconds + 0.3*t : t;
+        v.checkpoint_seconds += t;
+        checkpoint_start = 0;
+    }
+    v.checkpoint_count++;
+    v.checkpoint_bytes += checkpoint_nbytes;
+    checkpoint_nbytes = 0;
+    v.checkpoint_period = next_checkpoint_period();
+    v.checkpoint_cpu_time = last_wu_cpu_time;
+    worker_status.publish();
+
+    time_until_checkpoint = v.checkpoint_period;
+    if (checkpoint_critical_section) {
+        boinc_end_critical_section();
+        checkpoint_critical_section = false;
+    }
     ready_to_checkpoint = false;
 
     return 0;
@@ -1234,10 +1390,48 @@ void boinc_end_critical_section() {
 }
 
 int boinc_fraction_done(double x) {
-    fraction_done = x;
+    worker_status.write_fraction_done(x);
+    return 0;
+}
+
+static bool in_timer_thread() {
+    if (!timer_thread_started) return false;
+#ifdef _WIN32
+    return GetCurrentThreadId() == timer_thread_self;
+#else
+    return pthread_equal(pthread_self(), timer_thread_self) != 0;
+#endif
+}
+
+// The status values the calling thread may read:
+// the worker's own, or on the timer thread (i.e. in a timer callback)
+// the copy taken from the channel at the start of this tick.
+// Reading worker_status.last from the timer thread would race with
+// the worker changing it.
+//
+static API_STATUS_SLOT::VALUES& thread_status() {
+    if (in_timer_thread()) return timer_status;
+    return worker_status.last;
+}
+
+int boinc_get_checkpoint_stats(BOINC_CHECKPOINT_STATS* s) {
+    API_STATUS_SLOT::VALUES& v = thread_status();
+    s->count = v.checkpoint_count;
+    s->seconds = v.checkpoint_seconds;
+    s->bytes = v.checkpoint_bytes;
+    s->period = v.checkpoint_period;
     return 0;
 }
 
+int boinc_get_event(int* event) {
+    worker_wants_events = true;
+    if (!worker_events.pop(*event)) return 0;
+    if (*event == BOINC_EVENT_CHECKPOINT && !checkpoint_start) {
+        checkpoint_start = dtime();
+    }
+    return 1;
+}
+
 int boinc_receive_trickle_down(char* buf, int len) {
     std::string filename;
     char path[256];
@@ -1326,8 +1520,11 @@ void boinc_register_timer_callback(FUNC_PTR p) {
     timer_callback = p;
 }
 
+// the value last passed to boinc_fraction_done();
+// from a timer callback, the value as of the current tick
+//
 double boinc_get_fraction_done() {
-    return fraction_done;
+    return thread_status().fraction_done;
 }
 
 double boinc_elapsed_time() {
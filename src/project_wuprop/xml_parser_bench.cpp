@@ -0,0 +1,203 @@
+// Test harness for XML_PARSER in lib/ (parse.cpp, miofile.cpp):
+// checks that the buffered path (MIOFILE::init_mmap_read()) gives exactly
+// what the stdio path gives, and times both.
+//
+// Usage: xml_parser_bench [-n results] [-f file]
+//   -n  results in the generated client_state (50000 by default, about 24 MB)
+//   -f  parse this file instead of generating one
+//
+// The generated file looks like a client_state.xml with many results,
+// plus comments, attributes and blank text to exercise the scanner.
+// Each path reads the whole file with get(); the tags below are parsed
+// with parse_int(), parse_double() and parse_str(), as the BOINC client
+// and data_collect do.  Every token and parsed value is logged, and the
+// two logs must be identical.
+// Then get() over the whole file is timed for both paths, and
+// get_slice() for the buffered one.
+// The exit status is 0 only if the logs matched.
+//
+// Run it in an empty directory: it writes bench_state.xml there.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/time.h>
+
+#include "parse.h"
+#include "miofile.h"
+
+using std::string;
+
+static double now() {
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec*1e-6;
+}
+
+static int generate(const char* path, int n) {
+    FILE* f = fopen(path, "w");
+    if (!f) return -1;
+    fprintf(f, "<client_state>\n<!-- generated by xml_parser_bench -->\n");
+    fprintf(f, "<project>\n    <master_url>http://bench.test/</master_url>\n");
+    fprintf(f, "    <project_name>Bench &amp; test</project_name>\n</project>\n");
+    for (int i=0; i<n; i++) {
+        fprintf(f,
+            "<result>\n"
+            "    <name>bench_wu_%d_%d</name>\n"
+            "    <wu_name>bench_wu_%d</wu_name>\n"
+            "    <final_cpu_time>%f</final_cpu_time>\n"
+            "    <final_elapsed_time>%e</final_elapsed_time>\n"
+            "    <exit_status>%d</exit_status>\n"
+            "    <state>%d</state>\n"
+            "    <report_deadline>%f</report_deadline>\n"
+            "    <plan_class>%s</plan_class>\n"
+            "%s"
+            "    <file_ref type=\"output\">\n"
+            "        <file_name>bench_wu_%d_%d_0</file_name>\n"
+            "        <open_name>result.sah</open_name>\n"
+            "    </file_ref>\n"
+            "</result>\n",
+            i, i%3, i, i*1.25, i*3.5e-3, -(i%7), i%6, 1.3e9+i*60.5,
+            (i%4) ? "sse2" : "",
+            (i%10) ? "" : "    <!-- a -- comment --- with dashes -->\n",
+            i, i%3
+        );
+    }
+    fprintf(f, "</client_state>\n");
+    fclose(f);
+    return 0;
+}
+
+// read the whole document, logging every token and parsed value
+//
+static void parse_all(XML_PARSER& xp, string& log) {
+    char tag[4096], attr[256], s[256], line[512];
+    bool is_tag;
+    int i;
+    double d;
+
+    while (1) {
+        attr[0] = 0;
+        if (xp.get(tag, sizeof(tag), is_tag, attr, sizeof(attr))) break;
+        if (!is_tag) {
+            log += "D:";
+            log += tag;
+            log += "\n";
+            continue;
+        }
+        if (xp.parse_int(tag, "state", i) || xp.parse_int(tag, "exit_status", i)) {
+            sprintf(line, "I:%s=%d\n", tag, i);
+        } else if (xp.parse_double(tag, "final_cpu_time", d)
+            || xp.parse_double(tag, "final_elapsed_time", d)
+            || xp.parse_double(tag, "report_deadline", d)
+        ) {
+            sprintf(line, "F:%s=%.17g\n", tag, d);
+        } else if (xp.parse_str(tag, "name", s, sizeof(s))
+            || xp.parse_str(tag, "plan_class", s, sizeof(s))
+            || xp.parse_str(tag, "project_name", s, sizeof(s))
+        ) {
+            sprintf(line, "S:%s=%s\n", tag, s);
+        } else {
+            snprintf(line, sizeof(line), "T:%s|%s\n", tag, attr);
+        }
+        log += line;
+    }
+}
+
+static double time_get(const char* path, bool mmapped, long& tokens) {
+    char tag[4096];
+    bool is_tag;
+    MIOFILE mf;
+    FILE* f = 0;
+    double t = now();
+
+    if (mmapped) {
+        if (mf.init_mmap_read(path)) return -1;
+    } else {
+        if (!(f = fopen(path, "r"))) return -1;
+        mf.init_file(f);
+    }
+    XML_PARSER xp(&mf);
+    tokens = 0;
+    while (!xp.get(tag, sizeof(tag), is_tag)) tokens++;
+    t = now() - t;
+    if (f) fclose(f);
+    return t;
+}
+
+int main(int argc, char** argv) {
+    int n = 50000;
+    const char* path = "bench_state.xml";
+    bool generated = true;
+    for (int i=1; i<argc-1; i++) {
+        if (!strcmp(argv[i], "-n")) n = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-f")) {
+            path = argv[++i];
+            generated = false;
+        }
+    }
+    if (generated && generate(path, n)) {
+        perror(path);
+        return 1;
+    }
+
+    string stdio_log, mmap_log;
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+    MIOFILE mf_stdio;
+    mf_stdio.init_file(f);
+    XML_PARSER xp_stdio(&mf_stdio);
+    parse_all(xp_stdio, stdio_log);
+    fclose(f);
+
+    MIOFILE mf_mmap;
+    if (mf_mmap.init_mmap_read(path)) {
+        fprintf(stderr, "can't map %s\n", path);
+        return 1;
+    }
+    XML_PARSER xp_mmap(&mf_mmap);
+    parse_all(xp_mmap, mmap_log);
+
+    int errors = 0;
+    if (stdio_log != mmap_log) {
+        size_t i = 0;
+        while (i < stdio_log.size() && i < mmap_log.size() && stdio_log[i] == mmap_log[i]) i++;
+        size_t line_start = stdio_log.rfind('\n', i);
+        line_start = (line_start == string::npos) ? 0 : line_start+1;
+        printf("logs differ at byte %lu:\n  stdio: %.80s\n  mmap:  %.80s\n",
+            (unsigned long)i, stdio_log.c_str()+line_start, mmap_log.c_str()+line_start
+        );
+        errors++;
+    }
+    printf("%lu bytes of tokens and values logged by each path\n",
+        (unsigned long)stdio_log.size()
+    );
+
+    long tokens_stdio, tokens_mmap, slices = 0;
+    double t_stdio = time_get(path, false, tokens_stdio);
+    double t_mmap = time_get(path, true, tokens_mmap);
+
+    MIOFILE mf_slice;
+    double t_slice = now();
+    if (!mf_slice.init_mmap_read(path)) {
+        XML_PARSER xp(&mf_slice);
+        XML_SLICE slice;
+        bool is_tag;
+        while (!xp.get_slice(slice, is_tag)) slices++;
+    }
+    t_slice = now() - t_slice;
+
+    if (tokens_stdio != tokens_mmap) {
+        printf("get(): %ld tokens through stdio, %ld mapped\n", tokens_stdio, tokens_mmap);
+        errors++;
+    }
+    printf("get() stdio      %ld tokens %.3f s\n", tokens_stdio, t_stdio);
+    printf("get() mapped     %ld tokens %.3f s\n", tokens_mmap, t_mmap);
+    printf("get_slice()      %ld slices %.3f s\n", slices, t_slice);
+    printf("%s\n", errors ? "FAILED" : "OK");
+    return errors ? 1 : 0;
+}